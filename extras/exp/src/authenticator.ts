@@ -21,6 +21,9 @@ export class Authenticator extends Emittery<Events> {
       "-n", opts.deviceName,
       "-N", opts.networkCredential,
       "-p", opts.pakePassword,
+      ...(opts.compressShares ? ["-c"] : []),
+      ...(opts.compactNames ? ["-r"] : []),
+      ...(opts.embedLimit ? ["-e", opts.embedLimit.toString()] : []),
     ], {
       buffer: false,
       encoding: null,
@@ -73,6 +76,13 @@ export namespace Authenticator {
     deviceName: string;
     networkCredential: string;
     pakePassword: string;
+
+    /** Encode SPAKE2 public shares in compressed format. */
+    compressShares?: boolean;
+    /** Reference names compactly in PAKE messages. */
+    compactNames?: boolean;
+    /** Maximum Message 3 and Message 5 parameters size with embedded packets; 0 disables. */
+    embedLimit?: number;
   }
 
   export interface Result {
@@ -14,10 +14,31 @@ const args = yargs(hideBin(process.argv))
     desc: "repeat experiment N times",
     type: "number",
   })
+  .option("compress-shares", {
+    default: false,
+    desc: "encode SPAKE2 public shares in compressed format",
+    type: "boolean",
+  })
+  .option("compact-names", {
+    default: false,
+    desc: "reference names compactly in PAKE messages",
+    type: "boolean",
+  })
+  .option("embed-limit", {
+    default: 0,
+    desc: "embed CA profile and certificates in Message 3 and Message 5 up to this size",
+    type: "number",
+  })
   .parseSync();
 
 for (let i = 0; i < args.count; ++i) {
   const run = new Run();
-  const result = await run.run();
+  const result = await run.run({
+    authenticatorFlags: {
+      compressShares: args.compressShares,
+      compactNames: args.compactNames,
+      embedLimit: args.embedLimit,
+    },
+  });
   output.write(result);
 }
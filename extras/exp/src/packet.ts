@@ -23,10 +23,8 @@ export namespace ProtocolSequence {
     [">", "pake-request"],
     ["<", "pake-response"],
     [">", "confirm-request"],
-    ["<", "ca-profile-interest"],
-    [">", "ca-profile-data"],
-    ["<", "authenticator-cert-interest"],
-    [">", "authenticator-cert-data"],
+    ["<", "ca-profile-and-authenticator-cert-interest"],
+    [">", "ca-profile-and-authenticator-cert-data"],
     ["<", "confirm-response"],
     [">", "credential-request"],
     ["<", "temp-cert-interest"],
@@ -34,6 +32,10 @@ export namespace ProtocolSequence {
     ["<", "credential-response"],
   ];
 
+  /** Direct connection where CA profile, authenticator and issued certificates are embedded. */
+  export const directEmbedded: ProtocolSequence = direct.filter(([, step]) =>
+    !step.startsWith("ca-profile-and-authenticator-cert-") && !step.startsWith("temp-cert-"));
+
   export const infra: ProtocolSequence = [
     ["<", "NEW-request"],
     [">", "NEW-response"],
@@ -44,11 +44,14 @@ export class Run {
   private authenticatorConn?: Pick<Authenticator.Options, "deviceIp" | "devicePort" | "mtu">;
   private authenticator?: Authenticator;
   private infraDump?: Dumpcap;
+  private authenticatorFlags!: Run.AuthenticatorFlags;
 
   public run({
     logger = process.stderr,
+    authenticatorFlags = {},
   }: Run.Options = {}): Promise<Run.Result> {
     this.l = new console.Console(logger);
+    this.authenticatorFlags = authenticatorFlags;
     this.defer = pDefer<Run.Result>();
     this.timeout = setTimeout(() => {
       void this.fail("timeout");
@@ -129,6 +132,7 @@ export class Run {
   private startAuthenticator(): void {
     this.authenticator = new Authenticator({
       ...this.authenticatorConn!,
+      ...this.authenticatorFlags,
       keychain: env.keychain,
       caProfile: env.caProfile,
       deviceName: `${env.networkPrefix}/d${Date.now()}`,
@@ -160,6 +164,7 @@ export class Run {
     await this.cleanup();
     this.defer.resolve({
       program: this.device?.program,
+      authenticatorFlags: this.authenticatorFlags,
       device: this.device?.result,
       authenticator: this.authenticator?.result,
       error: `${err}`,
@@ -171,11 +176,13 @@ export class Run {
     await this.cleanup();
 
     const direct = await analyzeDump(this.device!.directPackets,
-      this.directDump, this.directDumpExtractArg, ProtocolSequence.direct);
+      this.directDump, this.directDumpExtractArg,
+      this.authenticatorFlags.embedLimit ? ProtocolSequence.directEmbedded : ProtocolSequence.direct);
     const infra = await analyzeDump(this.device!.infraPackets,
       this.infraDump, `--sta=${INFRA_WIFI_NETIF_MACADDR}`, ProtocolSequence.infra);
     this.defer.resolve({
       program: this.device!.program,
+      authenticatorFlags: this.authenticatorFlags,
       device: this.device!.result,
       authenticator: this.authenticator?.result,
       direct,
@@ -185,12 +192,17 @@ export class Run {
 }
 
 export namespace Run {
+  export type AuthenticatorFlags = Pick<Authenticator.Options,
+  "compressShares" | "compactNames" | "embedLimit">;
+
   export interface Options {
     logger?: NodeJS.WritableStream;
+    authenticatorFlags?: AuthenticatorFlags;
   }
 
   export interface Result {
     program?: string[];
+    authenticatorFlags?: AuthenticatorFlags;
     device?: Device.Result;
     authenticator?: Authenticator.Result;
     direct?: DumpResult;
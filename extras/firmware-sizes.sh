@@ -12,6 +12,11 @@ SKETCH_BASELINE=$(pwd)/examples/baseline
 SKETCH_DEVICE=$(pwd)/examples/device
 BUILD=$(pwd)/build.device-firmware-size
 
+# --build-property replaces a platform property instead of appending to it, so extra flags are
+# appended to the platform default here.
+PLATFORM_CPP_FLAGS=$($ARDUINO compile --fqbn esp32:esp32:esp32 --show-properties $SKETCH_DEVICE |
+  sed -n 's/^compiler\.cpp\.extra_flags=//p' | tr -d '\r')
+
 edit_config_macros() {
   local SKETCH=$1
   shift 1
@@ -33,11 +38,17 @@ build_and_measure() {
   local SKETCH=$1
   local OUTPUT=$2
   local PROGRAM="$3"
+  local EXTRA_FLAGS="${4:-}"
   shift 3
+  local EXTRA_PROPS=()
+  if [[ -n $EXTRA_FLAGS ]]; then
+    EXTRA_PROPS=(--build-property "compiler.cpp.extra_flags=${PLATFORM_CPP_FLAGS} ${EXTRA_FLAGS}")
+  fi
   if ! find $OUTPUT/*.ino.elf &>/dev/null; then
     $ARDUINO compile --fqbn esp32:esp32:esp32 --warnings more \
       --build-property 'build.partitions=noota_ffat' \
       --build-property 'upload.maximum_size=2097152' \
+      "${EXTRA_PROPS[@]}" \
       --build-path $(cygpath -w $OUTPUT) \
       ${SKETCH} >/dev/null
   fi
@@ -50,6 +61,7 @@ build_and_measure() {
   '{
     program: $program,
     size: ($ENV.SIZE_B | capture("\\n\\s*(?<text>\\d+)\\t\\s*(?<data>\\d+)\\t\\s*(?<bss>\\d+)\\t")),
+    dram0Bss: ([$ENV.SIZE_A | capture("\\n\\.dram0\\.bss\\s+(?<n>\\d+)") | .n | tonumber] | first),
     sizeB: $ENV.SIZE_B,
     sizeA: $ENV.SIZE_A,
     nm: $ENV.NM_C
@@ -103,3 +115,23 @@ for DIRECT in wifi ble; do
     done
   done
 done
+
+# SPAKE2-P256 with the mbedtls backend instead of the native backend, with fixed-base tables in
+# flash or built in heap RAM, for comparison with ble-udp-pake.
+# Heap usage during the PAKE stage is reported at runtime in 'pion.H.free-prev-state' log lines.
+edit_config_macros $SKETCH_DEVICE -PION_DIRECT_WIFI +PION_DIRECT_BLE
+edit_config_macros $SKETCH_DEVICE +PION_INFRA_UDP -PION_INFRA_ETHER
+edit_config_macros $SKETCH_DEVICE -PION_SKIP_PAKE +PION_SKIP_NDNCERT
+build_and_measure $SKETCH_DEVICE ${BUILD}/ble-udp-pake-mbedtls \
+  '["direct-ble", "infra-udp", "include-steps-pake", "spake2-mbedtls"]' \
+  '-DPION_SPAKE2_P256_NATIVE=0'
+build_and_measure $SKETCH_DEVICE ${BUILD}/ble-udp-pake-ramtables \
+  '["direct-ble", "infra-udp", "include-steps-pake", "spake2-mbedtls", "spake2-ram-tables"]' \
+  '-DPION_SPAKE2_P256_NATIVE=0 -DPION_SPAKE2_ROM_TABLES=0'
+build_and_measure $SKETCH_DEVICE ${BUILD}/ble-udp-pake-ed25519 \
+  '["direct-ble", "infra-udp", "include-steps-pake", "spake2-ed25519"]' \
+  '-DPION_PAKE_SPAKE2_GROUP=spake2::Edwards25519'
+# ChaCha20-Poly1305 instead of AES-GCM, for comparison with ble-udp-pake.
+build_and_measure $SKETCH_DEVICE ${BUILD}/ble-udp-pake-chachapoly \
+  '["direct-ble", "infra-udp", "include-steps-pake", "aead-chachapoly"]' \
+  '-DPION_PAKE_AEAD=ChaChaPoly'
@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""Generate fixed-base comb tables of the SPAKE2 native backends.
+
+Usage: spake2-native-tables.py p256|ed25519
+
+For base B, T[d] = sum(2^(64j) * B for each bit j set in d), d in [0, 16), as built by the combs
+in p256-native.cpp and ed25519.cpp. The tables are constant-initialized, so that they stay in
+flash. P-256 points are stored in projective coordinates with Z = 1, and field elements in
+Montgomery form with R = 2^256. edwards25519 points are stored in extended coordinates with
+Z = 1 and T = x * y, and field elements in plain form.
+"""
+
+import sys
+
+
+class P256:
+    name = 'p256'
+    header = 'p256-native.hpp'
+    namespace = 'p256_native'
+    guard = 'PION_SPAKE2_P256_NATIVE'
+
+    P = 2**256 - 2**224 + 2**192 + 2**96 - 1
+    A = P - 3
+    B = 0x5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B
+    R = 2**256
+    ZERO = None
+
+    BASES = {
+        'G': '046b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296'
+             '4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5',
+        'M': '04886e2f97ace46e55ba9dd7242579f2993b64e16ef3dcab95afd497333d8fa12f'
+             '5ff355163e43ce224e0b0e65ff02ac8e5c7be09419c785e0ca547d55a12e2d20',
+        'N': '04d8bbd6c639c62937b04d997f38c3770719c629d7014d49a24b4f98baa1292b49'
+             '07d60aa6bfade45008a636337f5168c64d9bd36034808cd564490b1e656edbe7',
+    }
+
+    @classmethod
+    def on_curve(cls, pt):
+        x, y = pt
+        return (y * y - (x * x * x + cls.A * x + cls.B)) % cls.P == 0
+
+    @classmethod
+    def add(cls, p1, p2):
+        P = cls.P
+        if p1 is None:
+            return p2
+        if p2 is None:
+            return p1
+        x1, y1 = p1
+        x2, y2 = p2
+        if x1 == x2:
+            if (y1 + y2) % P == 0:
+                return None
+            lam = (3 * x1 * x1 + cls.A) * pow(2 * y1, -1, P) % P
+        else:
+            lam = (y2 - y1) * pow(x2 - x1, -1, P) % P
+        x3 = (lam * lam - x1 - x2) % P
+        return (x3, (lam * (x1 - x3) - y1) % P)
+
+    @classmethod
+    def decode(cls, h):
+        b = bytes.fromhex(h)
+        assert len(b) == 65 and b[0] == 0x04
+        return (int.from_bytes(b[1:33], 'big'), int.from_bytes(b[33:], 'big'))
+
+    @classmethod
+    def coords(cls, pt):
+        P, R = cls.P, cls.R
+        if pt is None:
+            return (0, R % P, 0)
+        return (pt[0] * R % P, pt[1] * R % P, R % P)
+
+
+class Ed25519:
+    name = 'ed25519'
+    header = 'ed25519.hpp'
+    namespace = 'ed25519'
+    guard = None
+
+    P = 2**255 - 19
+    D = -121665 * pow(121666, -1, P) % P
+    ZERO = (0, 1)
+
+    BASES = {
+        'G': '5866666666666666666666666666666666666666666666666666666666666666',
+        'M': 'd048032c6ea0b6d697ddc2e86bda85a33adac920f1bf18e1b0c6d166a5cecdaf',
+        'N': 'd3bfb518f44f3430f29d0c92af503865a1ed3281dc69b35dd868ba85f886c4ab',
+    }
+
+    @classmethod
+    def on_curve(cls, pt):
+        x, y = pt
+        return (-x * x + y * y - 1 - cls.D * x * x * y * y) % cls.P == 0
+
+    @classmethod
+    def add(cls, p1, p2):
+        P = cls.P
+        x1, y1 = p1
+        x2, y2 = p2
+        t = cls.D * x1 * x2 * y1 * y2 % P
+        x3 = (x1 * y2 + y1 * x2) * pow(1 + t, -1, P) % P
+        y3 = (y1 * y2 + x1 * x2) * pow(1 - t, -1, P) % P
+        return (x3, y3)
+
+    @classmethod
+    def decode(cls, h):
+        P = cls.P
+        b = bytes.fromhex(h)
+        assert len(b) == 32
+        v = int.from_bytes(b, 'little')
+        y, sign = v & ((1 << 255) - 1), v >> 255
+        assert y < P
+        u = (y * y - 1) * pow(cls.D * y * y + 1, -1, P) % P
+        x = pow(u, (P + 3) // 8, P)
+        if x * x % P != u:
+            x = x * pow(2, (P - 1) // 4, P) % P
+        assert x * x % P == u and (x != 0 or sign == 0)
+        if x & 1 != sign:
+            x = P - x
+        return (x, y)
+
+    @classmethod
+    def coords(cls, pt):
+        return (pt[0], pt[1], 1, pt[0] * pt[1] % cls.P)
+
+
+CURVES = {c.name: c for c in (P256, Ed25519)}
+
+
+def mul(curve, k, pt):
+    r = curve.ZERO
+    while k > 0:
+        if k & 1:
+            r = curve.add(r, pt)
+        pt = curve.add(pt, pt)
+        k >>= 1
+    return r
+
+
+def comb_table(curve, base):
+    return [mul(curve, sum(1 << (64 * j) for j in range(4) if d & (1 << j)), base)
+            for d in range(16)]
+
+
+def limbs(v, indent):
+    words = [(v >> (32 * i)) & 0xFFFFFFFF for i in range(8)]
+    pairs = ['PION_LIMB(0x%08X, 0x%08X)' % (words[i], words[i + 1]) for i in range(0, 8, 2)]
+    return '{ { %s,\n%s%s } }' % (', '.join(pairs[:2]), ' ' * (indent + 4), ', '.join(pairs[2:]))
+
+
+def point(curve, pt):
+    assert pt == curve.ZERO or curve.on_curve(pt)
+    coords = [limbs(c, 6) for c in curve.coords(pt)]
+    return '    { %s },\n' % ',\n      '.join(coords)
+
+
+HEADER = """// SPDX-License-Identifier: NIST-PD
+// Generated by mk/spake2-native-tables.py %(name)s, do not edit.
+
+#include "%(header)s"
+%(guard_begin)s
+#if defined(__SIZEOF_INT128__)
+#define PION_LIMB(lo, hi) ((static_cast<limbs::Limb>(hi) << 32) | (lo))
+#else
+#define PION_LIMB(lo, hi) (lo), (hi)
+#endif
+
+namespace spake2 {
+namespace %(namespace)s {
+
+// clang-format off
+const Point combTables[3][16] = {
+"""
+
+FOOTER = """};
+// clang-format on
+
+#undef PION_LIMB
+
+} // namespace %(namespace)s
+} // namespace spake2
+%(guard_end)s"""
+
+
+def main():
+    if len(sys.argv) != 2 or sys.argv[1] not in CURVES:
+        sys.exit('Usage: %s %s' % (sys.argv[0], '|'.join(CURVES)))
+    curve = CURVES[sys.argv[1]]
+    subst = {
+        'name': curve.name,
+        'header': curve.header,
+        'namespace': curve.namespace,
+        'guard_begin': '\n#if %s\n' % curve.guard if curve.guard else '',
+        'guard_end': '\n#endif // %s\n' % curve.guard if curve.guard else '',
+    }
+
+    out = sys.stdout
+    out.write(HEADER % subst)
+    for name in 'GMN':
+        out.write('  // %s\n  {\n' % name)
+        for pt in comb_table(curve, curve.decode(curve.BASES[name])):
+            out.write(point(curve, pt))
+        out.write('  },\n')
+    out.write(FOOTER % subst)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""Generate fixed-base comb tables for SPAKE2-P256 constants G, M, N.
+
+The output mirrors the table that mbedtls ecp_precompute_comb() would build for a base point P
+with window w=5 on a 256-bit curve: T[i] = P + sum(2^((j+1)*d) * P for each bit j set in i),
+where d = ceil(256/w). Each point is stored in affine coordinates as little-endian limbs.
+"""
+
+import sys
+
+P = 2**256 - 2**224 + 2**192 + 2**96 - 1
+A = P - 3
+B = 0x5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B
+NBITS = 256
+W = 5
+D = (NBITS + W - 1) // W
+T_SIZE = 1 << (W - 1)
+
+BASES = {
+    'G': (0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+          0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5),
+    'M': bytes.fromhex('04886e2f97ace46e55ba9dd7242579f2993b64e16ef3dcab95afd497333d8fa12f'
+                       '5ff355163e43ce224e0b0e65ff02ac8e5c7be09419c785e0ca547d55a12e2d20'),
+    'N': bytes.fromhex('04d8bbd6c639c62937b04d997f38c3770719c629d7014d49a24b4f98baa1292b49'
+                       '07d60aa6bfade45008a636337f5168c64d9bd36034808cd564490b1e656edbe7'),
+}
+
+
+def on_curve(pt):
+    x, y = pt
+    return (y * y - (x * x * x + A * x + B)) % P == 0
+
+
+def add(p1, p2):
+    if p1 is None:
+        return p2
+    if p2 is None:
+        return p1
+    x1, y1 = p1
+    x2, y2 = p2
+    if x1 == x2:
+        if (y1 + y2) % P == 0:
+            return None
+        lam = (3 * x1 * x1 + A) * pow(2 * y1, -1, P) % P
+    else:
+        lam = (y2 - y1) * pow(x2 - x1, -1, P) % P
+    x3 = (lam * lam - x1 - x2) % P
+    return (x3, (lam * (x1 - x3) - y1) % P)
+
+
+def mul(k, pt):
+    r = None
+    while k > 0:
+        if k & 1:
+            r = add(r, pt)
+        pt = add(pt, pt)
+        k >>= 1
+    return r
+
+
+def decode(b):
+    assert len(b) == 65 and b[0] == 0x04
+    return (int.from_bytes(b[1:33], 'big'), int.from_bytes(b[33:], 'big'))
+
+
+def comb_table(base):
+    table = []
+    for i in range(T_SIZE):
+        k = 1 + sum(1 << ((j + 1) * D) for j in range(W - 1) if i & (1 << j))
+        pt = mul(k, base)
+        assert on_curve(pt)
+        table.append(pt)
+    return table
+
+
+def limbs(v):
+    words = [(v >> (32 * i)) & 0xFFFFFFFF for i in range(8)]
+    pairs = ['PION_LIMB(0x%08X, 0x%08X)' % (words[i], words[i + 1]) for i in range(0, 8, 2)]
+    return ', '.join(pairs[:2]) + ',\n        ' + ', '.join(pairs[2:])
+
+
+HEADER = """// SPDX-License-Identifier: NIST-PD
+// Generated by mk/spake2-tables.py, do not edit.
+
+#include "spake2.hpp"
+
+#include <cstddef>
+
+#if PION_SPAKE2_ROM_TABLES
+
+#if defined(MBEDTLS_HAVE_INT64)
+#define PION_LIMB(lo, hi) ((static_cast<mbedtls_mpi_uint>(hi) << 32) | (lo))
+#else
+#define PION_LIMB(lo, hi) (lo), (hi)
+#endif
+
+#define PION_MPI(l)                                                                                \\
+  {                                                                                                \\
+    1, sizeof(l) / sizeof(mbedtls_mpi_uint), const_cast<mbedtls_mpi_uint*>(l)                      \\
+  }
+#define PION_POINT(b, i)                                                                           \\
+  {                                                                                                \\
+    PION_MPI(limbs[b][i][0]), PION_MPI(limbs[b][i][1]), PION_MPI(one)                              \\
+  }
+
+namespace spake2 {
+namespace detail {
+
+// PION_MPI() initializes the fields of mbedtls_mpi in the order of mbedtls 2.x: s, n, p
+static_assert(offsetof(mbedtls_mpi, MBEDTLS_PRIVATE(s)) == 0 &&
+                offsetof(mbedtls_mpi, MBEDTLS_PRIVATE(n)) <
+                  offsetof(mbedtls_mpi, MBEDTLS_PRIVATE(p)),
+              "mbedtls_mpi layout is not supported, define PION_SPAKE2_ROM_TABLES=0");
+static_assert(CombTables<P256>::Size == %d, "");
+
+static const mbedtls_mpi_uint one[] = { 1 };
+
+// clang-format off
+"""
+
+FOOTER = """// clang-format on
+
+const mbedtls_ecp_point*
+CombTables<P256>::get(int base)
+{
+  static const mbedtls_ecp_point* const tables[] = { tableG, tableM, tableN };
+  return tables[base];
+}
+
+} // namespace detail
+} // namespace spake2
+
+#endif // PION_SPAKE2_ROM_TABLES
+"""
+
+
+def main():
+    out = sys.stdout
+    out.write(HEADER % T_SIZE)
+    out.write('static const mbedtls_mpi_uint limbs[3][%d][2][32 / sizeof(mbedtls_mpi_uint)] = {\n'
+              % T_SIZE)
+    for name in 'GMN':
+        base = BASES[name]
+        if isinstance(base, bytes):
+            base = decode(base)
+        assert on_curve(base)
+        out.write('  // %s\n  {\n' % name)
+        for (x, y) in comb_table(base):
+            out.write('    { { %s },\n      { %s } },\n' % (limbs(x), limbs(y)))
+        out.write('  },\n')
+    out.write('};\n\n')
+    for b, name in enumerate('GMN'):
+        out.write('static const mbedtls_ecp_point table%s[] = {\n' % name)
+        for i in range(T_SIZE):
+            out.write('  PION_POINT(%d, %d),\n' % (b, i))
+        out.write('};\n\n')
+    out.write(FOOTER)
+
+
+if __name__ == '__main__':
+    main()
@@ -1,4 +1,6 @@
 #include "pion.h"
+#include <cinttypes>
+#include <memory>
 
 static ndnph::Face& face = ndnph::cli::openUplink();
 static ndnph::StaticRegion<65536> region;
@@ -7,12 +9,16 @@ static std::string authenticatorKeySlot;
 static ndnph::Name deviceName;
 static ndnph::tlv::Value pakePassword;
 static ndnph::tlv::Value networkCredential;
+static bool compressShares = false;
+static bool compactNames = false;
+static size_t embedLimit = 0;
+static size_t sharePoolDepth = 0;
 
 static bool
 parseArgs(int argc, char** argv)
 {
   int c;
-  while ((c = getopt(argc, argv, "P:i:n:p:N:")) != -1) {
+  while ((c = getopt(argc, argv, "P:i:n:p:N:cre:s:")) != -1) {
     switch (c) {
       case 'P': {
         profileFilename = optarg;
@@ -34,6 +40,22 @@ parseArgs(int argc, char** argv)
         networkCredential = ndnph::tlv::Value::fromString(optarg);
         break;
       }
+      case 'c': {
+        compressShares = true;
+        break;
+      }
+      case 'r': {
+        compactNames = true;
+        break;
+      }
+      case 'e': {
+        embedLimit = std::strtoul(optarg, nullptr, 0);
+        break;
+      }
+      case 's': {
+        sharePoolDepth = std::strtoul(optarg, nullptr, 0);
+        break;
+      }
     }
   }
 
@@ -46,7 +68,8 @@ main(int argc, char** argv)
 {
   if (!parseArgs(argc, argv)) {
     fprintf(stderr,
-            "%s -P CA-PROFILE-FILE -i AK-SLOT -n DEVICE-NAME -p PASSWORD -N NETWORK-CREDENTIAL\n",
+            "%s -P CA-PROFILE-FILE -i AK-SLOT -n DEVICE-NAME -p PASSWORD -N NETWORK-CREDENTIAL"
+            " [-c] [-r] [-e EMBED-LIMIT] [-s SHARE-POOL-DEPTH]\n",
             argv[0]);
     return 1;
   }
@@ -68,6 +91,11 @@ main(int argc, char** argv)
     }
   }
 
+  std::unique_ptr<pion::pake::Spake2SharePool> sharePool;
+  if (sharePoolDepth > 0) {
+    sharePool.reset(new pion::pake::Spake2SharePool(sharePoolDepth));
+  }
+
   pion::pake::Authenticator authenticator(pion::pake::Authenticator::Options{
     face : face,
     caProfile : caProfile,
@@ -75,6 +103,11 @@ main(int argc, char** argv)
     signer : signer,
     nc : networkCredential,
     deviceName : deviceName,
+    sharePool : sharePool.get(),
+    compressShares : compressShares,
+    compactNames : compactNames,
+    embedLimit : embedLimit,
+    material : nullptr,
   });
   if (!authenticator.begin(pakePassword)) {
     fprintf(stderr, "authenticator.begin error\n");
@@ -89,9 +122,12 @@ main(int argc, char** argv)
     PION_LOG_STATE("pake-authenticator", st);
     switch (st) {
       case pion::pake::Authenticator::State::Success:
-        return 0;
       case pion::pake::Authenticator::State::Failure:
-        return 1;
+        if (sharePool != nullptr) {
+          fprintf(stderr, "share pool: %" PRIu64 " hits, %" PRIu64 " misses\n",
+                  sharePool->getHits(), sharePool->getMisses());
+        }
+        return st == pion::pake::Authenticator::State::Success ? 0 : 1;
       default:
         break;
     }
@@ -0,0 +1,733 @@
+#include "pion.h"
+#include "pion/spake2/p256-multi.hpp"
+
+#include <chrono>
+#include <cinttypes>
+#include <malloc.h>
+#include <new>
+
+#ifdef MBEDTLS_PLATFORM_MEMORY
+#include <mbedtls/platform.h>
+#endif
+
+using namespace pion::pake;
+
+static int nIterations = 100;
+static uint64_t seed = 0;
+static size_t payloadSize = 256;
+
+namespace {
+
+/**
+ * @brief Heap usage counters.
+ *
+ * They count C++ allocations, and also mbedtls allocations if mbedtls is built with
+ * MBEDTLS_PLATFORM_MEMORY. The benchmark is single-threaded, so they are not atomic.
+ */
+struct HeapStats
+{
+  uint64_t nAllocs = 0;
+  size_t current = 0;
+  size_t peak = 0;
+};
+
+HeapStats heap;
+
+void*
+countAlloc(void* ptr)
+{
+  if (ptr != nullptr) {
+    ++heap.nAllocs;
+    heap.current += malloc_usable_size(ptr);
+    heap.peak = std::max(heap.peak, heap.current);
+  }
+  return ptr;
+}
+
+void
+countFree(void* ptr)
+{
+  if (ptr != nullptr) {
+    heap.current -= malloc_usable_size(ptr);
+  }
+  std::free(ptr);
+}
+
+#ifdef MBEDTLS_PLATFORM_MEMORY
+void*
+countCalloc(size_t n, size_t size)
+{
+  return countAlloc(std::calloc(n, size));
+}
+#endif
+
+/**
+ * @brief Deterministic entropy function: SplitMix64 stream starting from the seed.
+ * @param ctx pointer to uint64_t state.
+ */
+int
+deterministicEntropy(void* ctx, unsigned char* output, size_t len)
+{
+  uint64_t& state = *static_cast<uint64_t*>(ctx);
+  uint64_t z = 0;
+  for (size_t i = 0; i < len; ++i) {
+    if (i % 8 == 0) {
+      state += 0x9E3779B97F4A7C15;
+      z = state;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+      z ^= z >> 31;
+    }
+    output[i] = static_cast<uint8_t>(z >> (8 * (i % 8)));
+  }
+  return 0;
+}
+
+/** @brief Accumulated measurements of one operation. */
+class Metric
+{
+public:
+  explicit Metric(std::string name)
+    : m_name(std::move(name))
+  {}
+
+  /**
+   * @brief Invoke and measure an operation.
+   * @param op function that returns whether the operation succeeded.
+   * @return whether the operation succeeded.
+   */
+  template<typename Fn>
+  bool measure(const Fn& op)
+  {
+    uint64_t nAllocs = heap.nAllocs;
+    size_t baseline = heap.current;
+    heap.peak = baseline;
+
+    auto t0 = std::chrono::steady_clock::now();
+    bool ok = op();
+    auto t1 = std::chrono::steady_clock::now();
+
+    m_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    m_nAllocs += heap.nAllocs - nAllocs;
+    m_peak = std::max(m_peak, heap.peak - baseline);
+    ++m_nOps;
+    return ok;
+  }
+
+  void print(bool first) const
+  {
+    double nOps = std::max<uint64_t>(m_nOps, 1);
+    printf("%s\n    {\"name\": \"%s\", \"ops\": %" PRIu64
+           ", \"ns_per_op\": %.0f, \"allocs_per_op\": %.2f, \"peak_heap_bytes\": %zu}",
+           first ? "" : ",", m_name.data(), m_nOps, m_ns / nOps, m_nAllocs / nOps, m_peak);
+  }
+
+private:
+  std::string m_name;
+  uint64_t m_nOps = 0;
+  double m_ns = 0;
+  uint64_t m_nAllocs = 0;
+  size_t m_peak = 0;
+};
+
+std::vector<Metric> metrics;
+
+/** @brief Phases of one SPAKE2 party. */
+template<spake2::Role role, typename Group, typename Hash>
+class Party
+{
+public:
+  using Context = spake2::Context<role, Group, Hash>;
+
+  explicit Party(const std::string& prefix)
+    : m_prefix(prefix)
+  {
+    for (const char* phase : { "constructor", "start", "generateFirstMessage",
+                               "processFirstMessage", "generateSecondMessage",
+                               "processSecondMessage" }) {
+      m_index.push_back(metrics.size());
+      metrics.emplace_back(prefix + "/" + phase);
+    }
+  }
+
+  Metric& metric(int phase)
+  {
+    return metrics[m_index[phase]];
+  }
+
+  Context* construct(spake2::Drbg& drbg)
+  {
+    Context* ctx = nullptr;
+    metric(0).measure([&] {
+      ctx = new (&m_storage) Context(drbg);
+      return true;
+    });
+    return ctx;
+  }
+
+  void destruct(Context* ctx)
+  {
+    if (ctx != nullptr) {
+      ctx->~Context();
+    }
+  }
+
+private:
+  std::string m_prefix;
+  std::vector<size_t> m_index;
+  typename std::aligned_storage<sizeof(Context), alignof(Context)>::type m_storage;
+};
+
+template<typename Group, typename Hash>
+bool
+benchSpake2(spake2::Drbg& drbg, const char* suite)
+{
+  static const uint8_t pw[] = { 'p', 'a', 's', 's', 'w', 'o', 'r', 'd' };
+  static const uint8_t idA[] = { 'a', 'u', 't', 'h', 'e', 'n', 't', 'i', 'c', 'a', 't', 'o', 'r' };
+  static const uint8_t idB[] = { 'd', 'e', 'v', 'i', 'c', 'e' };
+
+  Party<spake2::Role::Alice, Group, Hash> alice(std::string(suite) + "/Alice");
+  Party<spake2::Role::Bob, Group, Hash> bob(std::string(suite) + "/Bob");
+  using ContextA = typename decltype(alice)::Context;
+  using ContextB = typename decltype(bob)::Context;
+
+  bool ok = true;
+  for (int i = 0; ok && i < nIterations; ++i) {
+    ContextA* a = alice.construct(drbg);
+    ContextB* b = bob.construct(drbg);
+
+    uint8_t pA[ContextA::FirstMessageSize];
+    uint8_t pB[ContextB::FirstMessageSize];
+    uint8_t cA[ContextA::SecondMessageSize];
+    uint8_t cB[ContextB::SecondMessageSize];
+    ok = alice.metric(1).measure(
+           [&] { return a->start(pw, sizeof(pw), idA, sizeof(idA), idB, sizeof(idB)); }) &&
+         bob.metric(1).measure(
+           [&] { return b->start(pw, sizeof(pw), idB, sizeof(idB), idA, sizeof(idA)); }) &&
+         alice.metric(2).measure([&] { return a->generateFirstMessage(pA, sizeof(pA)); }) &&
+         bob.metric(2).measure([&] { return b->generateFirstMessage(pB, sizeof(pB)); }) &&
+         alice.metric(3).measure([&] { return a->processFirstMessage(pB, sizeof(pB)); }) &&
+         bob.metric(3).measure([&] { return b->processFirstMessage(pA, sizeof(pA)); }) &&
+         alice.metric(4).measure([&] { return a->generateSecondMessage(cA, sizeof(cA)); }) &&
+         bob.metric(4).measure([&] { return b->generateSecondMessage(cB, sizeof(cB)); }) &&
+         alice.metric(5).measure([&] { return a->processSecondMessage(cB, sizeof(cB)); }) &&
+         bob.metric(5).measure([&] { return b->processSecondMessage(cA, sizeof(cA)); }) &&
+         a->getSharedKey() == b->getSharedKey();
+
+    alice.destruct(a);
+    bob.destruct(b);
+  }
+
+  if (!ok) {
+    fprintf(stderr, "%s failed\n", suite);
+  }
+  return ok;
+}
+
+/**
+ * @brief Compare the fixed-base multiplications of one handshake with and without GroupCache.
+ *
+ * "uncached" repeats what each Context did before the groups were shared: load the curve, read M
+ * and N, and multiply without precomputed tables for them. "cached" performs the same three
+ * multiplications on the shared groups.
+ */
+template<typename Group>
+bool
+benchFixedBase(spake2::Drbg& drbg, const char* suite)
+{
+  using Cache = spake2::detail::GroupCache<Group>;
+  size_t index = metrics.size();
+  metrics.emplace_back(std::string(suite) + "/fixed-base/uncached");
+  metrics.emplace_back(std::string(suite) + "/fixed-base/cached");
+  Metric& mUncached = metrics[index];
+  Metric& mCached = metrics[index + 1];
+
+  uint8_t scalar[Group::ScalarSize];
+  ndnph::mbedtls::Mpi k;
+  if (mbedtls_hmac_drbg_random(drbg, scalar, sizeof(scalar)) != 0 ||
+      mbedtls_mpi_read_binary(k, scalar, sizeof(scalar)) != 0 ||
+      mbedtls_mpi_mod_mpi(k, k, &Cache::get().group()->N) != 0) {
+    return false;
+  }
+
+  bool ok = true;
+  for (int i = 0; ok && i < nIterations; ++i) {
+    ok = mUncached.measure([&] {
+           mbed::Object<mbedtls_ecp_group, mbedtls_ecp_group_init, mbedtls_ecp_group_free> grp;
+           ndnph::mbedtls::EcPoint M, N, R;
+           return mbedtls_ecp_group_load(grp, Group::Id) == 0 &&
+                  mbedtls_ecp_point_read_binary(grp, M, Group::M, sizeof(Group::M)) == 0 &&
+                  mbedtls_ecp_point_read_binary(grp, N, Group::N, sizeof(Group::N)) == 0 &&
+                  mbedtls_ecp_mul(grp, R, k, &grp->G, mbedtls_hmac_drbg_random, drbg) == 0 &&
+                  mbedtls_ecp_mul(grp, R, k, M, mbedtls_hmac_drbg_random, drbg) == 0 &&
+                  mbedtls_ecp_mul(grp, R, k, N, mbedtls_hmac_drbg_random, drbg) == 0;
+         }) &&
+         mCached.measure([&] {
+           Cache& cache = Cache::get();
+           ndnph::mbedtls::EcPoint R;
+           return cache.mul(spake2::detail::BaseG, R, k, mbedtls_hmac_drbg_random, drbg) == 0 &&
+                  cache.mul(spake2::detail::BaseM, R, k, mbedtls_hmac_drbg_random, drbg) == 0 &&
+                  cache.mul(spake2::detail::BaseN, R, k, mbedtls_hmac_drbg_random, drbg) == 0;
+         });
+  }
+
+  if (!ok) {
+    fprintf(stderr, "%s/fixed-base failed\n", suite);
+  }
+  return ok;
+}
+
+/**
+ * @brief Compare P-256 variable-base multiplications in the AVX2 multi-buffer backend with the
+ *        scalar native backend, on a batch of random scalars and points.
+ *
+ * Each operation computes and encodes a batch of results, as Batch does. "multi-buffer" is
+ * skipped if the CPU does not support AVX2.
+ */
+bool
+benchMultiBuffer(spake2::Drbg& drbg)
+{
+  namespace native = spake2::p256_native;
+  constexpr size_t n = spake2::p256_multi::ChunkGroups * spake2::p256_multi::Lanes;
+  size_t index = metrics.size();
+  metrics.emplace_back("P256/batch-mul/scalar");
+  metrics.emplace_back("P256/batch-mul/multi-buffer");
+  Metric& mScalar = metrics[index];
+  Metric& mMulti = metrics[index + 1];
+
+  uint8_t kBytes[n][32];
+  uint8_t PBytes[n][65];
+  uint8_t RBytes[n][65];
+  const uint8_t* k[n];
+  const uint8_t* P[n];
+  uint8_t* R[n];
+  native::Scalar kNative[n];
+  native::Point PNative[n];
+  native::Point RNative[n];
+  size_t len[n];
+  for (size_t i = 0; i < n; ++i) {
+    uint8_t input[40];
+    if (mbedtls_hmac_drbg_random(drbg, input, sizeof(input)) != 0) {
+      return false;
+    }
+    native::scalarReduce(kNative[i], input, sizeof(input));
+    if (native::scalarIsZero(kNative[i])) {
+      return false;
+    }
+    native::scalarWrite(kBytes[i], kNative[i]);
+    native::pointMulBase(PNative[i], native::BaseG, kNative[i]);
+    native::pointWrite(PBytes[i], &len[i], PNative[i]);
+    k[i] = kBytes[i];
+    P[i] = PBytes[i];
+    R[i] = RBytes[i];
+  }
+
+  bool ok = true;
+  for (int i = 0; ok && i < nIterations; ++i) {
+    ok = mScalar.measure([&] {
+      for (size_t j = 0; j < n; ++j) {
+        native::pointMul(RNative[j], kNative[j], PNative[j]);
+      }
+      native::pointWriteBatch(R, len, RNative, n);
+      return true;
+    });
+    if (ok && spake2::p256_multi::isAvailable()) {
+      ok = mMulti.measure([&] { return spake2::p256_multi::mul(n, k, P, R); });
+    }
+  }
+
+  if (!ok) {
+    fprintf(stderr, "P256/batch-mul failed\n");
+  }
+  return ok;
+}
+
+bool
+benchEncryptSession(spake2::Drbg& drbg)
+{
+  size_t index = metrics.size();
+  metrics.emplace_back("EncryptSession/encrypt");
+  metrics.emplace_back("EncryptSession/decrypt");
+  Metric& mEncrypt = metrics[index];
+  Metric& mDecrypt = metrics[index + 1];
+
+  Aead::Key key;
+  std::vector<uint8_t> payload(payloadSize);
+  if (mbedtls_hmac_drbg_random(drbg, key.data(), key.size()) != 0 ||
+      mbedtls_hmac_drbg_random(drbg, payload.data(), payload.size()) != 0) {
+    return false;
+  }
+
+  static const uint8_t ss[] = { 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7 };
+  ndnph::StaticRegion<64> ssRegion;
+  EncryptSession sender;
+  EncryptSession receiver;
+  sender.ss = receiver.ss = ndnph::Component(ssRegion, sizeof(ss), ss);
+  if (!sender.importKey(key) || !receiver.importKey(key)) {
+    return false;
+  }
+
+  ndnph::DynamicRegion region(payloadSize * 4 + 1024);
+  ndnph::tlv::Value nc(payload.data(), payload.size());
+  bool ok = true;
+  for (int i = 0; ok && i < nIterations; ++i) {
+    region.reset();
+    ndnph::tlv::Value encrypted;
+    ok = mEncrypt.measure([&] {
+      encrypted = sender.encrypt(
+        region, [&](ndnph::Encoder& encoder) { encoder.prependTlv(TT::Nc, nc); });
+      return !!encrypted;
+    });
+
+    Encrypted message;
+    ok = ok &&
+         ndnph::EvDecoder::decodeValue(encrypted.makeDecoder(),
+                                       ndnph::EvDecoder::def<TT::InitializationVector>(&message),
+                                       ndnph::EvDecoder::def<TT::AuthenticationTag>(&message),
+                                       ndnph::EvDecoder::def<TT::EncryptedPayload>(&message)) &&
+         mDecrypt.measure([&] {
+           auto inner = receiver.decrypt(region, message);
+           return !!inner;
+         });
+  }
+
+  if (!ok) {
+    fprintf(stderr, "EncryptSession failed\n");
+  }
+  return ok;
+}
+
+/** @brief Compare AEAD ciphers regardless of PION_PAKE_AEAD, on a buffer of payload size. */
+template<typename Cipher>
+bool
+benchAead(spake2::Drbg& drbg, const char* name)
+{
+  size_t index = metrics.size();
+  metrics.emplace_back(std::string(name) + "/encrypt");
+  metrics.emplace_back(std::string(name) + "/decrypt");
+  Metric& mEncrypt = metrics[index];
+  Metric& mDecrypt = metrics[index + 1];
+
+  typename Cipher::Key key;
+  std::vector<uint8_t> buf(payloadSize);
+  static const uint8_t aad[] = { 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7 };
+  Cipher sender;
+  Cipher receiver;
+  if (mbedtls_hmac_drbg_random(drbg, key.data(), key.size()) != 0 ||
+      mbedtls_hmac_drbg_random(drbg, buf.data(), buf.size()) != 0 || !sender.import(key) ||
+      !receiver.import(key)) {
+    return false;
+  }
+
+  bool ok = true;
+  for (int i = 0; ok && i < nIterations; ++i) {
+    uint8_t iv[Cipher::IvLen::value];
+    uint8_t tag[Cipher::TagLen::value];
+    ok = mEncrypt.measure([&] {
+           return sender.encrypt(iv, tag, buf.data(), buf.size(), aad, sizeof(aad));
+         }) &&
+         mDecrypt.measure([&] {
+           return receiver.decrypt(iv, tag, buf.data(), buf.size(), aad, sizeof(aad));
+         });
+  }
+
+  if (!ok) {
+    fprintf(stderr, "%s failed\n", name);
+  }
+  return ok;
+}
+
+/** @brief Link-layer fragment size of BLE with 247-octet ATT MTU. */
+constexpr size_t BleFragmentSize = 244;
+
+/** @brief Encoded sizes of one PAKE message. */
+struct MessageSize
+{
+  const char* name;
+  size_t full;    // uncompressed shares, full names
+  size_t compact; // compressed shares, compact names
+};
+
+std::vector<MessageSize> messageSizes;
+
+template<typename Packet>
+size_t
+encodedSize(ndnph::Region& region, const Packet& packet)
+{
+  ndnph::Encoder encoder(region);
+  encoder.prepend(packet);
+  size_t size = !encoder ? 0 : encoder.size();
+  encoder.discard();
+  return size;
+}
+
+/** @brief Construct an Interest of a PAKE request with placeholder parameters. */
+ndnph::Interest::Parameterized
+makeRequest(ndnph::Region& region, EncryptSession& session, const ndnph::Component& verb,
+            size_t paramsLen)
+{
+  ndnph::Interest interest = region.create<ndnph::Interest>();
+  uint8_t* params = region.alloc(paramsLen);
+  if (!interest || params == nullptr) {
+    return ndnph::Interest::Parameterized();
+  }
+  std::fill_n(params, paramsLen, 0);
+  interest.setName(session.makeName(region, verb));
+  interest.setLifetime(InterestLifetime::value);
+  return interest.parameterize(ndnph::tlv::Value(params, paramsLen));
+}
+
+/** @brief Return encoded size of a PAKE response with placeholder content. */
+size_t
+responseSize(ndnph::Region& region, const ndnph::Interest::Parameterized& request,
+             size_t contentLen)
+{
+  ndnph::Encoder encoder(region);
+  encoder.prepend(request);
+  if (!encoder) {
+    encoder.discard();
+    return 0;
+  }
+  encoder.trim();
+
+  ndnph::Interest interest = region.create<ndnph::Interest>();
+  ndnph::Data data = region.create<ndnph::Data>();
+  uint8_t* content = region.alloc(contentLen);
+  if (!interest || !data || content == nullptr ||
+      !ndnph::tlv::Value(encoder).makeDecoder().decode(interest)) {
+    return 0;
+  }
+  std::fill_n(content, contentLen, 0);
+  data.setName(interest.getName());
+  data.setContent(ndnph::tlv::Value(content, contentLen));
+  return encodedSize(region, data.sign(ndnph::NullKey::get()));
+}
+
+/**
+ * @brief Compare encoded sizes of Message 1-5 in the full and the compact encodings.
+ *
+ * Names and certificates follow a typical deployment: the CA, the authenticator, and the device
+ * share a two-component prefix. It fails if a compact message other than ConfirmResponse exceeds
+ * BleFragmentSize.
+ */
+bool
+compareMessageSizes()
+{
+  ndnph::DynamicRegion region(16384);
+  EncryptSession session;
+  auto deviceName = ndnph::Name::parse(region, "/example/pion/home/thermostat");
+  auto authenticatorName = ndnph::Name::parse(region, "/example/pion")
+                             .append(region, getAuthenticatorComponent(),
+                                     ndnph::Name::parse(region, "/phone")[0]);
+  auto caProfileName = ndnph::Name::parse(region, "/example/pion/CA/INFO")
+                         .append(region, ndnph::convention::Version::create(region, 1700000000000),
+                                 ndnph::convention::Segment::create(region, 0));
+  if (!session.begin(region) || !deviceName || !authenticatorName || !caProfileName) {
+    return false;
+  }
+
+  // authenticator certificate, temporary certificate request, and temporary certificate
+  time_t now = time(nullptr);
+  ndnph::ValidityPeriod validity(now, now + TempCertValidity::value);
+  ndnph::EcPrivateKey hPvt, tPvt;
+  ndnph::EcPublicKey hPub, tPub;
+  EncodedData hCert, tReq, tCert;
+  bool ok = ndnph::ec::generate(region, authenticatorName, hPvt, hPub) &&
+            hCert.build(region, hPub.selfSign(region, validity, hPvt));
+  hPvt.setName(hCert.data.getName());
+  auto tSubject = computeTempSubjectName(region, hCert.data.getName(), deviceName);
+  ok = ok && !!tSubject && ndnph::ec::generate(region, tSubject, tPvt, tPub) &&
+       tReq.build(region, tPub.selfSign(region, ndnph::ValidityPeriod::getMax(), tPvt)) &&
+       tCert.build(region, tPub.buildCertificate(region, tSubject, validity, hPvt));
+  if (!ok) {
+    return false;
+  }
+
+  uint8_t digest[NDNPH_SHA256_LEN] = {};
+  caProfileName = caProfileName.append(
+    region, ndnph::Component(region, ndnph::TT::ImplicitSha256DigestComponent, sizeof(digest),
+                             digest));
+  auto nc = ndnph::tlv::Value::fromString("ssid=pion-home psk=0123456789abcdef");
+  auto timestamp = ndnph::convention::Timestamp::create(region, ndnph::convention::TimeValue());
+
+  using M1 = packet_schema::PakeRequest;
+  using M2 = packet_schema::PakeResponse;
+  using M3 = packet_schema::ConfirmRequest;
+  using M4 = packet_schema::ConfirmResponse;
+  using M5 = packet_schema::CredentialRequest;
+  for (bool compact : { false, true }) {
+    size_t shareLen = compact ? Spake2Device::CompressedFirstMessageSize
+                              : Spake2Device::FirstMessageSize;
+    auto m1 = makeRequest(region, session, getPakeComponent(),
+                          compact ? M1::compactSize(shareLen)
+                                  : M1::size(shareLen, hCert.fullName.length()));
+
+    NameRef caProfileRef(deviceName, caProfileName);
+    NameRef certRef(deviceName, hCert.data.getName());
+    auto m3 = makeRequest(
+      region, session, getConfirmComponent(),
+      M3::size(compact
+                 ? M3::compactPlaintextSize(nc, caProfileRef, deviceName, certRef, timestamp)
+                 : M3::plaintextSize(nc, caProfileName, deviceName, timestamp)));
+
+    NameRef tCertRef(tReq.data.getName(), tCert.fullName);
+    auto m5 = makeRequest(region, session, getCredentialComponent(),
+                          M5::size(compact ? M5::compactPlaintextSize(tCertRef)
+                                           : M5::plaintextSize(tCert.fullName.length())));
+
+    size_t sizes[] = {
+      encodedSize(region, m1),
+      responseSize(region, m1, M2::size(shareLen)),
+      encodedSize(region, m3),
+      responseSize(region, m3, M4::size(schema::tlvSize(TT::TReq, tReq.wire.size()))),
+      encodedSize(region, m5),
+    };
+    static const char* names[] = { "PakeRequest", "PakeResponse", "ConfirmRequest",
+                                   "ConfirmResponse", "CredentialRequest" };
+    // ConfirmResponse carries the whole Treq certificate, which name references cannot shorten
+    static const bool fitsFragment[] = { true, true, true, false, true };
+    messageSizes.resize(sizeof(sizes) / sizeof(sizes[0]));
+    for (size_t i = 0; i < messageSizes.size(); ++i) {
+      messageSizes[i].name = names[i];
+      (compact ? messageSizes[i].compact : messageSizes[i].full) = sizes[i];
+      ok = ok && sizes[i] > 0;
+      if (compact && fitsFragment[i] && sizes[i] > BleFragmentSize) {
+        fprintf(stderr, "%s is %zu octets, exceeding BLE fragment size %zu\n", names[i],
+                sizes[i], BleFragmentSize);
+        ok = false;
+      }
+    }
+  }
+
+  if (!ok) {
+    fprintf(stderr, "compareMessageSizes failed\n");
+  }
+  return ok;
+}
+
+} // namespace
+
+void*
+operator new(size_t size)
+{
+  return countAlloc(std::malloc(size));
+}
+
+void*
+operator new[](size_t size)
+{
+  return countAlloc(std::malloc(size));
+}
+
+void*
+operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  return countAlloc(std::malloc(size));
+}
+
+void*
+operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+  return countAlloc(std::malloc(size));
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  countFree(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+  countFree(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+  countFree(ptr);
+}
+
+void
+operator delete[](void* ptr, size_t) noexcept
+{
+  countFree(ptr);
+}
+
+static bool
+parseArgs(int argc, char** argv)
+{
+  int c;
+  while ((c = getopt(argc, argv, "n:s:m:")) != -1) {
+    switch (c) {
+      case 'n': {
+        nIterations = std::atoi(optarg);
+        break;
+      }
+      case 's': {
+        seed = std::strtoull(optarg, nullptr, 0);
+        break;
+      }
+      case 'm': {
+        payloadSize = std::strtoul(optarg, nullptr, 0);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  return argc == optind && nIterations > 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  if (!parseArgs(argc, argv)) {
+    fprintf(stderr, "pion-benchmark [-n ITERATIONS] [-s SEED] [-m PAYLOAD-SIZE]\n");
+    return 1;
+  }
+
+#ifdef MBEDTLS_PLATFORM_MEMORY
+  mbedtls_platform_set_calloc_free(countCalloc, countFree);
+#endif
+
+  uint64_t entropyState = seed;
+  spake2::Drbg drbg(deterministicEntropy, &entropyState);
+
+  bool ok = benchSpake2<spake2::P256, spake2::SHA256>(drbg, "SPAKE2-P256-SHA256") &&
+            benchSpake2<spake2::P256, spake2::SHA512>(drbg, "SPAKE2-P256-SHA512") &&
+            benchSpake2<spake2::Edwards25519, spake2::SHA256>(drbg, "SPAKE2-Edwards25519-SHA256") &&
+            benchSpake2<spake2::Edwards25519, spake2::SHA512>(drbg, "SPAKE2-Edwards25519-SHA512") &&
+            benchSpake2<spake2::P384, spake2::SHA256>(drbg, "SPAKE2-P384-SHA256") &&
+            benchSpake2<spake2::P384, spake2::SHA512>(drbg, "SPAKE2-P384-SHA512") &&
+            benchSpake2<spake2::P521, spake2::SHA256>(drbg, "SPAKE2-P521-SHA256") &&
+            benchSpake2<spake2::P521, spake2::SHA512>(drbg, "SPAKE2-P521-SHA512") &&
+            benchFixedBase<spake2::P256>(drbg, "P256") &&
+            benchFixedBase<spake2::P384>(drbg, "P384") &&
+            benchFixedBase<spake2::P521>(drbg, "P521") && benchMultiBuffer(drbg) &&
+            benchEncryptSession(drbg) &&
+            benchAead<AesGcm>(drbg, "AEAD-AES-128-GCM");
+#ifdef MBEDTLS_CHACHAPOLY_C
+  ok = ok && benchAead<ChaChaPoly>(drbg, "AEAD-ChaCha20-Poly1305");
+#endif
+  ok = ok && compareMessageSizes();
+
+  printf("{\n  \"seed\": %" PRIu64 ",\n  \"iterations\": %d,\n  \"benchmarks\": [", seed,
+         nIterations);
+  bool first = true;
+  for (const auto& metric : metrics) {
+    metric.print(first);
+    first = false;
+  }
+  printf("\n  ],\n  \"fragment_bytes\": %zu,\n  \"message_sizes\": [", BleFragmentSize);
+  first = true;
+  for (const auto& size : messageSizes) {
+    printf("%s\n    {\"name\": \"%s\", \"full_bytes\": %zu, \"compact_bytes\": %zu}",
+           first ? "" : ",", size.name, size.full, size.compact);
+    first = false;
+  }
+  printf("\n  ]\n}\n");
+  return ok ? 0 : 1;
+}
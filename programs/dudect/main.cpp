@@ -0,0 +1,262 @@
+#include "pion.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+using namespace pion::pake;
+
+static int nMeasurements = 20000;
+static double threshold = 10.0;
+
+namespace {
+
+enum
+{
+  /** @brief Number of cropping percentiles, in addition to the uncropped set. */
+  NCrops = 20,
+  PasswordLen = 16,
+};
+
+/** @brief Secret input class: a fixed value, or a fresh random value in each measurement. */
+enum class InputClass : uint8_t
+{
+  Fixed = 0,
+  Random = 1,
+};
+
+struct Sample
+{
+  InputClass cls;
+  int64_t ns;
+};
+
+using Password = std::array<uint8_t, PasswordLen>;
+
+spake2::Drbg& drbg = spake2::Drbg::forThread();
+const Password fixedPassword{};
+bool setupFailed = false;
+
+InputClass
+pickClass()
+{
+  uint8_t b = 0;
+  mbedtls_hmac_drbg_random(drbg, &b, 1);
+  return static_cast<InputClass>(b & 0x01);
+}
+
+Password
+pickPassword(InputClass cls)
+{
+  Password pw = fixedPassword;
+  if (cls == InputClass::Random) {
+    mbedtls_hmac_drbg_random(drbg, pw.data(), pw.size());
+  }
+  return pw;
+}
+
+/** @brief Check a setup step, which is not measured. */
+void
+check(bool ok)
+{
+  setupFailed = setupFailed || !ok;
+}
+
+/** @brief Measure the duration of an operation; its result is ignored. */
+template<typename Fn>
+int64_t
+timed(const Fn& op)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  op();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+}
+
+/** @brief Compute Welch's t statistic among samples whose duration is below @p cutoff . */
+double
+welch(const std::vector<Sample>& samples, int64_t cutoff)
+{
+  // Welford's online algorithm for mean and variance of each class
+  double n[2] = { 0, 0 };
+  double mean[2] = { 0, 0 };
+  double m2[2] = { 0, 0 };
+  for (const auto& sample : samples) {
+    if (sample.ns >= cutoff) {
+      continue;
+    }
+    int c = static_cast<int>(sample.cls);
+    n[c] += 1;
+    double delta = sample.ns - mean[c];
+    mean[c] += delta / n[c];
+    m2[c] += delta * (sample.ns - mean[c]);
+  }
+
+  if (n[0] < 2 || n[1] < 2) {
+    return 0;
+  }
+  double var0 = m2[0] / (n[0] - 1);
+  double var1 = m2[1] / (n[1] - 1);
+  double se = std::sqrt(var0 / n[0] + var1 / n[1]);
+  return se == 0 ? 0 : (mean[0] - mean[1]) / se;
+}
+
+/**
+ * @brief Compute the largest |t| among the uncropped set and the cropped sets.
+ *
+ * As in dudect, cropping at increasing percentiles discards the long tail caused by interrupts
+ * and scheduling, which would otherwise hide small differences.
+ */
+double
+analyze(const std::vector<Sample>& samples)
+{
+  std::vector<int64_t> sorted;
+  sorted.reserve(samples.size());
+  for (const auto& sample : samples) {
+    sorted.push_back(sample.ns);
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  double maxT = std::fabs(welch(samples, std::numeric_limits<int64_t>::max()));
+  for (int i = 0; i < NCrops; ++i) {
+    double p = 1.0 - std::pow(0.5, 10.0 * (i + 1) / NCrops);
+    int64_t cutoff = sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+    maxT = std::max(maxT, std::fabs(welch(samples, cutoff)));
+  }
+  return maxT;
+}
+
+/**
+ * @brief Run one target and report whether its timing depends on the input class.
+ * @param measure function that prepares inputs of the given class and returns the duration of
+ *                the target operation.
+ * @return whether no leakage was detected.
+ */
+template<typename Fn>
+bool
+runTarget(const char* name, const Fn& measure)
+{
+  std::vector<Sample> samples;
+  samples.reserve(nMeasurements);
+  for (int i = 0; i < nMeasurements; ++i) {
+    InputClass cls = pickClass();
+    int64_t ns = measure(cls);
+    if (setupFailed) {
+      fprintf(stderr, "%s setup failed\n", name);
+      return false;
+    }
+    samples.push_back(Sample{ cls, ns });
+  }
+
+  double t = analyze(samples);
+  bool ok = t < threshold;
+  printf("%s n=%d max|t|=%.2f %s\n", name, nMeasurements, t, ok ? "OK" : "LEAK");
+  return ok;
+}
+
+/** @brief Secret input is the password. */
+int64_t
+measureStart(InputClass cls)
+{
+  Password pw = pickPassword(cls);
+  Spake2Authenticator alice(drbg);
+  return timed([&] { alice.start(pw.data(), pw.size()); });
+}
+
+/** @brief Secret input is the password, which determines w in X = x*G + w*M. */
+int64_t
+measureGenerateFirstMessage(InputClass cls)
+{
+  Password pw = pickPassword(cls);
+  Spake2Authenticator alice(drbg);
+  check(alice.start(pw.data(), pw.size()));
+
+  uint8_t pA[Spake2Authenticator::FirstMessageSize];
+  return timed([&] { alice.generateFirstMessage(pA, sizeof(pA)); });
+}
+
+/** @brief Secret input is the password, which determines w in K = x*(Y - w*N). */
+int64_t
+measureProcessFirstMessage(InputClass cls, const uint8_t* pB, size_t pBLen)
+{
+  Password pw = pickPassword(cls);
+  Spake2Authenticator alice(drbg);
+  uint8_t pA[Spake2Authenticator::FirstMessageSize];
+  check(alice.start(pw.data(), pw.size()) && alice.generateFirstMessage(pA, sizeof(pA)));
+
+  return timed([&] { alice.processFirstMessage(pB, pBLen); });
+}
+
+/** @brief Secret input is the received confirmation MAC: the correct one, or a random one. */
+int64_t
+measureProcessSecondMessage(InputClass cls)
+{
+  Password pw = pickPassword(InputClass::Random);
+  Spake2Authenticator alice(drbg);
+  Spake2Device bob(drbg);
+  uint8_t pA[Spake2Authenticator::FirstMessageSize];
+  uint8_t pB[Spake2Device::FirstMessageSize];
+  uint8_t cA[Spake2Authenticator::SecondMessageSize];
+  uint8_t cB[Spake2Device::SecondMessageSize];
+  check(alice.start(pw.data(), pw.size()) && bob.start(pw.data(), pw.size()) &&
+        alice.generateFirstMessage(pA, sizeof(pA)) && bob.generateFirstMessage(pB, sizeof(pB)) &&
+        alice.processFirstMessage(pB, sizeof(pB)) && bob.processFirstMessage(pA, sizeof(pA)) &&
+        alice.generateSecondMessage(cA, sizeof(cA)) && bob.generateSecondMessage(cB, sizeof(cB)));
+
+  if (cls == InputClass::Random) {
+    mbedtls_hmac_drbg_random(drbg, cB, sizeof(cB));
+  }
+  return timed([&] { alice.processSecondMessage(cB, sizeof(cB)); });
+}
+
+} // namespace
+
+static bool
+parseArgs(int argc, char** argv)
+{
+  int c;
+  while ((c = getopt(argc, argv, "n:t:")) != -1) {
+    switch (c) {
+      case 'n': {
+        nMeasurements = std::atoi(optarg);
+        break;
+      }
+      case 't': {
+        threshold = std::atof(optarg);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  return argc == optind && nMeasurements > 2 * NCrops && threshold > 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  if (!parseArgs(argc, argv)) {
+    fprintf(stderr, "pion-dudect [-n MEASUREMENTS] [-t THRESHOLD]\n");
+    return 1;
+  }
+
+  // fixed peer share for processFirstMessage
+  Spake2Device bob(drbg);
+  uint8_t pB[Spake2Device::FirstMessageSize];
+  if (!bob.start(fixedPassword.data(), fixedPassword.size()) ||
+      !bob.generateFirstMessage(pB, sizeof(pB))) {
+    fprintf(stderr, "peer setup failed\n");
+    return 1;
+  }
+
+  auto measureProcessFirst = [&](InputClass cls) {
+    return measureProcessFirstMessage(cls, pB, sizeof(pB));
+  };
+
+  bool ok = runTarget("start", measureStart);
+  ok = runTarget("generateFirstMessage", measureGenerateFirstMessage) && ok;
+  ok = runTarget("processFirstMessage", measureProcessFirst) && ok;
+  ok = runTarget("processSecondMessage", measureProcessSecondMessage) && ok;
+  return ok ? 0 : 1;
+}
@@ -19,6 +19,15 @@ enum
   CaProfileName = 0x8F0B,
   DeviceName = 0x8F0F,
   TReq = 0x8F11,
+  Spake2PACompressed = 0x8F13,
+  Spake2PBCompressed = 0x8F15,
+  AuthenticatorCertDigest = 0x8F17,
+  CaProfileNameRef = 0x8F19,
+  AuthenticatorCertNameRef = 0x8F1B,
+  IssuedCertNameRef = 0x8F1D,
+  EmbeddedCaProfile = 0x8F1F,
+  EmbeddedAuthenticatorCert = 0x8F21,
+  EmbeddedIssuedCert = 0x8F23,
 };
 using namespace ndnph::ndncert::TT;
 } // namespace TT
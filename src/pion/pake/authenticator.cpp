@@ -3,7 +3,12 @@
 namespace pion {
 namespace pake {
 
-static mbed::Entropy entropy;
+AuthenticatorMaterial::AuthenticatorMaterial(ndnph::Data caProfile, ndnph::Data cert)
+  : m_region(4096)
+{
+  m_ok = m_caProfile.build(m_region, caProfile) && m_cert.build(m_region, cert) &&
+         m_cert.data.computeImplicitDigest(m_certDigest.data());
+}
 
 class Authenticator::GotoState
 {
@@ -34,25 +39,20 @@ private:
 class Authenticator::PakeRequest : public packet_struct::PakeRequest
 {
 public:
-  ndnph::Interest::Parameterized toInterest(ndnph::Region& region, EncryptSession& session) const
+  ndnph::tlv::Value toParameters(ndnph::Region& region) const
   {
-    ndnph::Encoder encoder(region);
-    encoder.prepend(
-      [this](ndnph::Encoder& encoder) {
-        encoder.prependTlv(TT::Spake2PA, ndnph::tlv::Value(spake2pa, sizeof(spake2pa)));
-      },
-      [this](ndnph::Encoder& encoder) {
-        encoder.prependTlv(TT::AuthenticatorCertName, authenticatorCertName);
-      });
-    encoder.trim();
-
-    ndnph::Interest interest = region.create<ndnph::Interest>();
-    if (!encoder || !interest) {
-      return ndnph::Interest::Parameterized();
+    using Schema = packet_schema::PakeRequest;
+    ndnph::Component digest = authenticatorCertName[-1];
+    schema::Writer writer(region, compactNames
+                                    ? Schema::compactSize(spake2paLen)
+                                    : Schema::size(spake2paLen, authenticatorCertName.length()));
+    writer.write(Schema::Spake2PA::typeOf(spake2paLen), spake2pa, spake2paLen);
+    if (compactNames) {
+      writer.write(TT::AuthenticatorCertDigest, digest.value(), digest.length());
+    } else {
+      writer.write(TT::AuthenticatorCertName, authenticatorCertName);
     }
-    interest.setName(session.makeName(region, getPakeComponent()));
-    interest.setLifetime(InterestLifetime::value);
-    return interest.parameterize(ndnph::tlv::Value(encoder));
+    return writer.finish();
   }
 };
 
@@ -61,51 +61,98 @@ class Authenticator::PakeResponse : public packet_struct::PakeResponse
 public:
   bool fromData(ndnph::Region&, const ndnph::Data& data)
   {
+    spake2pbLen = 0;
     return ndnph::EvDecoder::decodeValue(
-      data.getContent().makeDecoder(),
-      ndnph::EvDecoder::def<TT::Spake2PB>([this](const ndnph::Decoder::Tlv& d) {
-        if (d.length == sizeof(spake2pb)) {
-          std::copy_n(d.value, d.length, spake2pb);
-          return true;
-        }
-        return false;
-      }),
-      ndnph::EvDecoder::def<TT::Spake2CB>([this](const ndnph::Decoder::Tlv& d) {
-        if (d.length == sizeof(spake2cb)) {
-          std::copy_n(d.value, d.length, spake2cb);
-          return true;
-        }
-        return false;
-      }));
+             data.getContent().makeDecoder(),
+             ndnph::EvDecoder::def<TT::Spake2PB>(
+               [this](const ndnph::Decoder::Tlv& d) { return decodeSpake2pb(d); }),
+             ndnph::EvDecoder::def<TT::Spake2PBCompressed>(
+               [this](const ndnph::Decoder::Tlv& d) { return decodeSpake2pb(d); }),
+             ndnph::EvDecoder::def<TT::Spake2CB>([this](const ndnph::Decoder::Tlv& d) {
+               if (Schema::Spake2CB::accepts(d.type, d.length)) {
+                 std::copy_n(d.value, d.length, spake2cb);
+                 return true;
+               }
+               return false;
+             })) &&
+           spake2pbLen != 0;
+  }
+
+private:
+  using Schema = packet_schema::PakeResponse;
+
+  // fields are copied because the response is consumed over several loop() iterations
+  bool decodeSpake2pb(const ndnph::Decoder::Tlv& d)
+  {
+    if (spake2pbLen != 0 || !Schema::Spake2PB::accepts(d.type, d.length)) {
+      return false;
+    }
+    std::copy_n(d.value, d.length, spake2pb);
+    spake2pbLen = d.length;
+    return true;
   }
 };
 
 class Authenticator::ConfirmRequest : public packet_struct::ConfirmRequest
 {
 public:
-  ndnph::Interest::Parameterized toInterest(ndnph::Region& region, EncryptSession& session) const
+  ndnph::tlv::Value toParameters(ndnph::Region& region, EncryptSession& session) const
   {
-    auto encrypted = session.encrypt(
-      region, [this](ndnph::Encoder& encoder) { encoder.prependTlv(TT::Nc, nc); },
-      [this](ndnph::Encoder& encoder) { encoder.prependTlv(TT::CaProfileName, caProfileName); },
-      [this](ndnph::Encoder& encoder) { encoder.prependTlv(TT::DeviceName, deviceName); },
-      ndnph::convention::Timestamp::create(region, ndnph::convention::TimeValue()));
-
-    ndnph::Encoder outer(region);
-    outer.prepend(
-      [this](ndnph::Encoder& encoder) {
-        encoder.prependTlv(TT::Spake2CA, ndnph::tlv::Value(spake2ca, sizeof(spake2ca)));
-      },
-      encrypted);
-    outer.trim();
-
-    ndnph::Interest interest = region.create<ndnph::Interest>();
-    if (!encrypted || !outer || !interest) {
-      return ndnph::Interest::Parameterized();
+    using Schema = packet_schema::ConfirmRequest;
+    auto timestamp = ndnph::convention::Timestamp::create(region, ndnph::convention::TimeValue());
+    NameRef caProfileRef(deviceName, caProfileName);
+    NameRef certRef(deviceName, authenticatorCertName);
+    size_t plaintextLen =
+      compactNames
+        ? Schema::compactPlaintextSize(nc, caProfileRef, deviceName, certRef, timestamp)
+        : Schema::plaintextSize(nc, caProfileName, deviceName, timestamp);
+
+    // embed each packet only if the parameters stay within embedLimit
+    ndnph::tlv::Value embeddedCaProfile = embed(plaintextLen, caProfile);
+    ndnph::tlv::Value embeddedCert = embed(plaintextLen, authenticatorCert);
+
+    schema::Writer writer(region, Schema::size(plaintextLen));
+    writer.write(TT::Spake2CA, spake2ca.begin(), spake2ca.size());
+    bool encrypted = session.encrypt(writer, plaintextLen, [&](schema::Writer& inner) {
+      bool ok = inner.write(TT::Nc, nc.begin(), nc.size());
+      if (compactNames) {
+        ok = ok && caProfileRef.writeTo(inner, TT::CaProfileNameRef) &&
+             inner.write(TT::DeviceName, deviceName) &&
+             certRef.writeTo(inner, TT::AuthenticatorCertNameRef);
+      } else {
+        ok = ok && inner.write(TT::CaProfileName, caProfileName) &&
+             inner.write(TT::DeviceName, deviceName);
+      }
+      return ok && inner.write(timestamp) &&
+             (!embeddedCaProfile || inner.write(TT::EmbeddedCaProfile, embeddedCaProfile.begin(),
+                                                embeddedCaProfile.size())) &&
+             (!embeddedCert || inner.write(TT::EmbeddedAuthenticatorCert, embeddedCert.begin(),
+                                           embeddedCert.size()));
+    });
+    if (!encrypted) {
+      return ndnph::tlv::Value();
     }
-    interest.setName(session.makeName(region, getConfirmComponent()));
-    interest.setLifetime(InterestLifetime::value);
-    return interest.parameterize(ndnph::tlv::Value(outer));
+    return writer.finish();
+  }
+
+public:
+  /** @brief Maximum encoded size of parameters with embedded packets. */
+  size_t embedLimit = 0;
+
+private:
+  /**
+   * @brief Decide whether to embed a packet.
+   * @param[inout] plaintextLen plaintext length, increased if the packet is embedded.
+   * @return the packet if it is embedded; otherwise the device would fetch it.
+   */
+  ndnph::tlv::Value embed(size_t& plaintextLen, const ndnph::tlv::Value& packet) const
+  {
+    size_t more = packet_schema::ConfirmRequest::EmbeddedCaProfile::size(packet.size());
+    if (!packet || packet_schema::ConfirmRequest::size(plaintextLen + more) > embedLimit) {
+      return ndnph::tlv::Value();
+    }
+    plaintextLen += more;
+    return packet;
   }
 };
 
@@ -140,31 +187,53 @@ public:
 class Authenticator::CredentialRequest : public packet_struct::CredentialRequest
 {
 public:
-  ndnph::Interest::Parameterized toInterest(ndnph::Region& region, EncryptSession& session) const
+  ndnph::tlv::Value toParameters(ndnph::Region& region, EncryptSession& session) const
   {
-    auto encrypted = session.encrypt(region, [this](ndnph::Encoder& encoder) {
-      encoder.prependTlv(TT::IssuedCertName, tempCertName);
-    });
+    using Schema = packet_schema::CredentialRequest;
+    NameRef ref(tempCertReqName, tempCertName);
+    size_t plaintextLen = compactNames ? Schema::compactPlaintextSize(ref)
+                                       : Schema::plaintextSize(tempCertName.length());
+
+    // embed the issued certificate only if the parameters stay within embedLimit
+    size_t more = Schema::EmbeddedIssuedCert::size(tempCert.size());
+    bool embedded = !!tempCert && Schema::size(plaintextLen + more) <= embedLimit;
+    if (embedded) {
+      plaintextLen += more;
+    }
 
-    ndnph::Interest interest = region.create<ndnph::Interest>();
-    if (!encrypted || !interest) {
-      return ndnph::Interest::Parameterized();
+    schema::Writer writer(region, Schema::size(plaintextLen));
+    bool encrypted = session.encrypt(writer, plaintextLen, [&](schema::Writer& inner) {
+      bool ok = compactNames ? ref.writeTo(inner, TT::IssuedCertNameRef)
+                             : inner.write(TT::IssuedCertName, tempCertName);
+      return ok &&
+             (!embedded || inner.write(TT::EmbeddedIssuedCert, tempCert.begin(), tempCert.size()));
+    });
+    if (!encrypted) {
+      return ndnph::tlv::Value();
     }
-    interest.setName(session.makeName(region, getCredentialComponent()));
-    interest.setLifetime(InterestLifetime::value);
-    return interest.parameterize(encrypted);
+    return writer.finish();
   }
+
+public:
+  /** @brief Maximum encoded size of parameters with embedded issued certificate. */
+  size_t embedLimit = 0;
 };
 
 Authenticator::Authenticator(const Options& opts)
   : PacketHandler(opts.face, 192)
-  , m_caProfile(opts.caProfile)
-  , m_cert(opts.cert)
+  , m_ownMaterial(opts.material == nullptr ? new AuthenticatorMaterial(opts.caProfile, opts.cert)
+                                            : nullptr)
+  , m_material(opts.material == nullptr ? m_ownMaterial.get() : opts.material)
   , m_signer(opts.signer)
   , m_nc(opts.nc)
   , m_deviceName(opts.deviceName)
+  , m_sharePool(opts.sharePool)
+  , m_compressShares(opts.compressShares)
+  , m_compactNames(opts.compactNames)
+  , m_embedLimit(std::min<size_t>(opts.embedLimit, packet_schema::MaxEmbedLimit))
   , m_pending(this)
   , m_region(4096)
+  , m_requestRegion(RequestRegionCapacity)
 {}
 
 void
@@ -172,8 +241,14 @@ Authenticator::end()
 {
   m_session.end();
   m_spake2.reset();
+  m_pakeResponse = nullptr;
+  m_issued = EncodedData();
+  m_tempCertReqName = ndnph::Name();
+  m_request = ndnph::Interest();
+  m_requestParameters = ndnph::tlv::Value();
   m_state = State::Idle;
   m_region.reset();
+  m_requestRegion.reset();
 }
 
 bool
@@ -181,20 +256,23 @@ Authenticator::begin(ndnph::tlv::Value password)
 {
   end();
 
-  if (!m_session.begin(m_region)) {
+  if (!*m_material || !m_session.begin(m_region)) {
     return false;
   }
 
-  m_spake2.reset(new Spake2Authenticator(entropy));
-  uint8_t spakeIdentity[NDNPH_SHA256_LEN];
-  bool ok = m_cert.computeImplicitDigest(spakeIdentity) &&
-            m_spake2->start(password.begin(), password.size(), spakeIdentity, sizeof(spakeIdentity),
-                            nullptr, 0, m_session.ss.value(), m_session.ss.length());
+  m_spake2.reset(m_region.make<Spake2Authenticator>(spake2::Drbg::forThread(), m_sharePool));
+  const auto& spakeIdentity = m_material->getCertDigest();
+  bool ok = m_spake2 != nullptr &&
+            m_spake2->start(password.begin(), password.size(), spakeIdentity.data(),
+                            spakeIdentity.size(), nullptr, 0, m_session.ss.value(),
+                            m_session.ss.length()) &&
+            m_spake2->startGenerateFirstMessage();
   if (!ok) {
     return false;
   }
 
-  m_state = State::SendPakeRequest;
+  m_rtt.begin();
+  m_state = State::ComputePakeShare;
   return true;
 }
 
@@ -202,6 +280,11 @@ void
 Authenticator::loop()
 {
   switch (m_state) {
+    case State::ComputePakeShare:
+    case State::ComputePakeKey: {
+      continuePake();
+      break;
+    }
     case State::SendPakeRequest: {
       sendPakeRequest();
       break;
@@ -213,7 +296,7 @@ Authenticator::loop()
     case State::WaitPakeResponse:
     case State::WaitConfirmResponse:
     case State::WaitCredentialResponse: {
-      if (m_pending.expired()) {
+      if (m_pending.expired() && !retransmitRequest()) {
         m_state = State::Failure;
       }
       break;
@@ -229,6 +312,7 @@ Authenticator::processData(ndnph::Data data)
   if (!m_pending.matchPitToken()) {
     return false;
   }
+  m_rtt.onReply();
   switch (m_state) {
     case State::WaitPakeResponse: {
       return handlePakeResponse(data);
@@ -249,12 +333,17 @@ Authenticator::processData(ndnph::Data data)
 void
 Authenticator::sendPakeRequest()
 {
-  ndnph::StaticRegion<2048> region;
+  m_requestRegion.reset();
   GotoState gotoState(this);
   PakeRequest req;
-  req.authenticatorCertName = m_cert.getFullName(region);
-  m_spake2->generateFirstMessage(req.spake2pa, sizeof(req.spake2pa)) &&
-    m_pending.send(req.toInterest(region, m_session)) && gotoState(State::WaitPakeResponse);
+  req.authenticatorCertName = m_material->getCert().fullName;
+  req.compactNames = m_compactNames;
+  if (m_compressShares) {
+    req.spake2paLen = Spake2Authenticator::CompressedFirstMessageSize;
+  }
+  m_spake2->generateFirstMessage(req.spake2pa, req.spake2paLen) &&
+    sendRequest(getPakeComponent(), req.toParameters(m_requestRegion)) &&
+    gotoState(State::WaitPakeResponse);
 }
 
 bool
@@ -267,22 +356,59 @@ Authenticator::handlePakeResponse(ndnph::Data data)
   }
 
   GotoState gotoState(this);
+  m_pakeResponse = m_region.make<PakeResponse>(res);
+  m_pakeResponse != nullptr &&
+    m_spake2->startProcessFirstMessage(res.spake2pb, res.spake2pbLen) &&
+    gotoState(State::ComputePakeKey);
+  return true;
+}
+
+void
+Authenticator::continuePake()
+{
+  GotoState gotoState(this);
+  switch (m_spake2->step(Spake2StepBudget::value)) {
+    case spake2::Progress::Done: {
+      break;
+    }
+    case spake2::Progress::Pending: {
+      gotoState(m_state);
+      return;
+    }
+    default:
+      return;
+  }
+
+  if (m_state == State::ComputePakeShare) {
+    gotoState(State::SendPakeRequest);
+    return;
+  }
+
+  m_requestRegion.reset();
   ConfirmRequest req;
-  bool ok = m_spake2->processFirstMessage(res.spake2pb, sizeof(res.spake2pb)) &&
-            m_spake2->generateSecondMessage(req.spake2ca, sizeof(req.spake2ca)) &&
-            m_spake2->processSecondMessage(res.spake2cb, sizeof(res.spake2cb)) &&
-            m_session.importKey(m_spake2->getSharedKey());
+  uint8_t spake2ca[Spake2Authenticator::SecondMessageSize];
+  req.spake2ca = ndnph::tlv::Value(spake2ca, sizeof(spake2ca));
+  bool ok =
+    m_spake2->generateSecondMessage(spake2ca, sizeof(spake2ca)) &&
+    m_spake2->processSecondMessage(m_pakeResponse->spake2cb, sizeof(m_pakeResponse->spake2cb)) &&
+    m_session.importKey(m_spake2->getSharedKey());
   m_spake2.reset();
   if (!ok) {
-    return true;
+    return;
   }
 
   req.nc = m_nc;
-  req.caProfileName = m_caProfile.getFullName(region);
+  req.caProfileName = m_material->getCaProfile().fullName;
   req.deviceName = m_deviceName;
+  req.authenticatorCertName = m_material->getCert().data.getName();
+  req.compactNames = m_compactNames;
+  req.caProfile = m_material->getCaProfile().wire;
+  req.authenticatorCert = m_material->getCert().wire;
+  req.embedLimit = m_embedLimit;
   // req.timestamp is ignored; current timestamp will be used
-  m_pending.send(req.toInterest(region, m_session)) && gotoState(State::WaitConfirmResponse);
-  return true;
+  sendRequest(getConfirmComponent(), req.toParameters(m_requestRegion, m_session),
+              ConfirmProcessingTime::value) &&
+    gotoState(State::WaitConfirmResponse);
 }
 
 bool
@@ -295,48 +421,73 @@ Authenticator::handleConfirmResponse(ndnph::Data data)
   }
 
   GotoState gotoState(this);
-  auto subjectName = computeTempSubjectName(region, m_cert.getName(), m_deviceName);
+  auto subjectName = computeTempSubjectName(region, m_material->getCert().data.getName(),
+                                            m_deviceName);
   if (ndnph::certificate::toSubjectName(region, res.tempCertReq.getName()) != subjectName) {
     return true;
   }
 
+  m_tempCertReqName = res.tempCertReq.getName().clone(m_region);
   time_t now = time(nullptr);
   ndnph::ValidityPeriod validity(now, now + TempCertValidity::value);
-  ndnph::Encoder encoder(m_region);
-  encoder.prepend(res.tPub.buildCertificate(region, subjectName, validity, m_signer));
-  if (!encoder) {
-    encoder.discard();
-    return true;
-  }
-  encoder.trim();
-
-  m_issued = m_region.create<ndnph::Data>();
-  return !!m_issued && ndnph::tlv::Value(encoder).makeDecoder().decode(m_issued) &&
+  return m_issued.build(m_region,
+                        res.tPub.buildCertificate(region, subjectName, validity, m_signer)) &&
          gotoState(State::SendCredentialRequest);
 }
 
 void
 Authenticator::sendCredentialRequest()
 {
-  ndnph::StaticRegion<2048> region;
+  m_requestRegion.reset();
   GotoState gotoState(this);
   CredentialRequest req;
-  req.tempCertName = m_issued.getFullName(region);
-  !!req.tempCertName && m_pending.send(req.toInterest(region, m_session)) &&
+  req.tempCertName = m_issued.fullName;
+  req.tempCertReqName = m_tempCertReqName;
+  req.compactNames = m_compactNames;
+  req.tempCert = m_issued.wire;
+  req.embedLimit = m_embedLimit;
+  sendRequest(getCredentialComponent(), req.toParameters(m_requestRegion, m_session)) &&
     gotoState(State::WaitCredentialResponse);
 }
 
 bool
-Authenticator::processInterest(ndnph::Interest interest)
+Authenticator::sendRequest(const ndnph::Component& verb, ndnph::tlv::Value parameters,
+                           int allowance)
 {
-  if (interest.match(m_caProfile)) {
-    return reply(m_caProfile);
+  m_request = m_requestRegion.create<ndnph::Interest>();
+  if (!parameters || !m_request) {
+    return false;
   }
-  if (interest.match(m_cert)) {
-    return reply(m_cert);
+  m_request.setName(m_session.makeName(m_requestRegion, verb));
+  m_requestParameters = parameters;
+  return transmitRequest(m_rtt.onRequest(allowance));
+}
+
+bool
+Authenticator::retransmitRequest()
+{
+  return transmitRequest(m_rtt.onTimeout());
+}
+
+bool
+Authenticator::transmitRequest(uint16_t lifetime)
+{
+  if (lifetime == 0) {
+    return false;
   }
-  if (!!m_issued && interest.match(m_issued)) {
-    return reply(m_issued);
+  // parameters are not re-encrypted, so that the device recognizes a retransmission by its name
+  m_request.setLifetime(lifetime);
+  return m_pending.send(m_request.parameterize(m_requestParameters));
+}
+
+bool
+Authenticator::processInterest(ndnph::Interest interest)
+{
+  for (const EncodedData* packet :
+       { &m_material->getCaProfile(), &m_material->getCert(), &m_issued }) {
+    if (!!*packet && packet->match(interest)) {
+      return reply(packet->wire);
+    }
   }
   return false;
 }
@@ -6,6 +6,47 @@
 namespace pion {
 namespace pake {
 
+/**
+ * @brief Immutable values derived from the CA profile and the authenticator certificate.
+ *
+ * They include the certificate digest used as SPAKE2 identity, full names carried in PAKE
+ * messages, and wire encodings for replying to fetch Interests.
+ */
+class AuthenticatorMaterial
+{
+public:
+  /** @brief Compute all values; check operator bool for success. */
+  explicit AuthenticatorMaterial(ndnph::Data caProfile, ndnph::Data cert);
+
+  explicit operator bool() const
+  {
+    return m_ok;
+  }
+
+  const EncodedData& getCaProfile() const
+  {
+    return m_caProfile;
+  }
+
+  const EncodedData& getCert() const
+  {
+    return m_cert;
+  }
+
+  /** @brief Return implicit digest of the certificate. */
+  const std::array<uint8_t, NDNPH_SHA256_LEN>& getCertDigest() const
+  {
+    return m_certDigest;
+  }
+
+private:
+  ndnph::DynamicRegion m_region;
+  EncodedData m_caProfile;
+  EncodedData m_cert;
+  std::array<uint8_t, NDNPH_SHA256_LEN> m_certDigest{};
+  bool m_ok = false;
+};
+
 /** @brief PION Onboarding Protocol - PAKE stage, authenticator side. */
 class Authenticator : public ndnph::PacketHandler
 {
@@ -29,6 +70,48 @@ public:
 
     /** @brief Assigned device name. */
     ndnph::Name deviceName;
+
+    /**
+     * @brief Pool of ephemeral SPAKE2 shares, or nullptr.
+     *
+     * It may be shared by authenticators running in any thread, and must outlive them.
+     */
+    Spake2SharePool* sharePool;
+
+    /**
+     * @brief Whether to send the SPAKE2 public share in compressed format.
+     *
+     * The device replies in the same format. This shortens Message 1 and Message 2, but requires
+     * devices that recognize the compressed TLV-TYPEs.
+     */
+    bool compressShares;
+
+    /**
+     * @brief Whether to reference names compactly in PAKE messages.
+     *
+     * Message 1 carries only the digest of the authenticator certificate. Message 3 and Message 5
+     * carry names relative to names known to the device, see NameRef. This shortens the messages
+     * so that they are less likely to need link-layer fragmentation.
+     */
+    bool compactNames;
+
+    /**
+     * @brief Maximum encoded size of Message 3 and Message 5 parameters with embedded packets.
+     *
+     * The CA profile and the authenticator certificate are embedded in Message 3, and the issued
+     * certificate is embedded in Message 5, as long as the parameters stay within this limit, so
+     * that the device does not need to fetch them. Packets that do not fit are fetched as usual.
+     * 0 disables embedding. Larger values are clamped to packet_schema::MaxEmbedLimit, which is
+     * what the device can decode.
+     */
+    size_t embedLimit;
+
+    /**
+     * @brief Material computed from caProfile and cert, or nullptr to compute it in constructor.
+     *
+     * It may be shared by authenticators with the same caProfile and cert, and must outlive them.
+     */
+    const AuthenticatorMaterial* material;
   };
 
   explicit Authenticator(const Options& opts);
@@ -40,8 +123,10 @@ public:
   enum class State
   {
     Idle,
+    ComputePakeShare,
     SendPakeRequest,
     WaitPakeResponse,
+    ComputePakeKey,
     WaitConfirmResponse,
     SendCredentialRequest,
     WaitCredentialResponse,
@@ -63,10 +148,18 @@ private:
 
   bool handlePakeResponse(ndnph::Data data);
 
+  void continuePake();
+
   bool handleConfirmResponse(ndnph::Data data);
 
   void sendCredentialRequest();
 
+  bool sendRequest(const ndnph::Component& verb, ndnph::tlv::Value parameters, int allowance = 0);
+
+  bool retransmitRequest();
+
+  bool transmitRequest(uint16_t lifetime);
+
   bool processInterest(ndnph::Interest interest) final;
 
 private:
@@ -77,19 +170,36 @@ private:
   class ConfirmResponse;
   class CredentialRequest;
 
-  ndnph::Data m_caProfile;
-  ndnph::Data m_cert;
+  enum : size_t
+  {
+    RequestNameRoom = 256,
+    RequestRegionCapacity = packet_schema::MaxEmbedLimit + RequestNameRoom,
+  };
+
+  std::unique_ptr<AuthenticatorMaterial> m_ownMaterial;
+  const AuthenticatorMaterial* m_material;
   const ndnph::PrivateKey& m_signer;
   ndnph::tlv::Value m_nc;
   ndnph::Name m_deviceName;
+  Spake2SharePool* m_sharePool;
+  bool m_compressShares;
+  bool m_compactNames;
+  size_t m_embedLimit;
 
   OutgoingPendingInterest m_pending;
+  RttEstimator m_rtt;
   State m_state = State::Idle;
 
   ndnph::DynamicRegion m_region;
   EncryptSession m_session;
-  std::unique_ptr<Spake2Authenticator> m_spake2;
-  ndnph::Data m_issued;
+  RegionPtr<Spake2Authenticator> m_spake2; // in m_region
+  PakeResponse* m_pakeResponse = nullptr;  // in m_region
+  ndnph::Name m_tempCertReqName;           // in m_region
+  EncodedData m_issued;                    // in m_region
+
+  ndnph::DynamicRegion m_requestRegion;  // for outstanding request
+  ndnph::Interest m_request;             // in m_requestRegion
+  ndnph::tlv::Value m_requestParameters; // in m_requestRegion
 };
 
 } // namespace pake
@@ -3,8 +3,6 @@
 namespace pion {
 namespace pake {
 
-static mbed::Entropy entropy;
-
 class Device::GotoState
 {
 public:
@@ -37,46 +35,68 @@ private:
 class Device::PakeRequest : public packet_struct::PakeRequest
 {
 public:
-  bool fromInterest(ndnph::Region&, const ndnph::Interest& interest)
+  bool fromInterest(ndnph::Region& region, const ndnph::Interest& interest)
   {
+    spake2paLen = 0;
     return ndnph::EvDecoder::decodeValue(
-      interest.getAppParameters().makeDecoder(),
-      ndnph::EvDecoder::def<TT::Spake2PA>([this](const ndnph::Decoder::Tlv& d) {
-        if (d.length == sizeof(spake2pa)) {
-          std::copy_n(d.value, d.length, spake2pa);
-          return true;
-        }
-        return false;
-      }),
-      ndnph::EvDecoder::def<TT::AuthenticatorCertName>([this](const ndnph::Decoder::Tlv& d) {
-        return d.vd().decode(authenticatorCertName) &&
-               authenticatorCertName[-1].is<ndnph::convention::ImplicitDigest>() &&
-               ndnph::certificate::isCertName(authenticatorCertName.getPrefix(-1));
-      }));
+             interest.getAppParameters().makeDecoder(),
+             ndnph::EvDecoder::def<TT::Spake2PA>(
+               [this](const ndnph::Decoder::Tlv& d) { return decodeSpake2pa(d); }),
+             ndnph::EvDecoder::def<TT::Spake2PACompressed>(
+               [this](const ndnph::Decoder::Tlv& d) { return decodeSpake2pa(d); }),
+             ndnph::EvDecoder::def<TT::AuthenticatorCertName>([this](const ndnph::Decoder::Tlv& d) {
+               return d.vd().decode(authenticatorCertName) &&
+                      authenticatorCertName[-1].is<ndnph::convention::ImplicitDigest>() &&
+                      ndnph::certificate::isCertName(authenticatorCertName.getPrefix(-1));
+             }),
+             ndnph::EvDecoder::def<TT::AuthenticatorCertDigest>(
+               [&](const ndnph::Decoder::Tlv& d) { return decodeDigest(region, d); })) &&
+           spake2paLen != 0 && !!authenticatorCertName;
+  }
+
+private:
+  // spake2pa is copied because it may be consumed in a later loop() iteration
+  bool decodeSpake2pa(const ndnph::Decoder::Tlv& d)
+  {
+    if (spake2paLen != 0 || !packet_schema::PakeRequest::Spake2PA::accepts(d.type, d.length)) {
+      return false;
+    }
+    std::copy_n(d.value, d.length, spake2pa);
+    spake2paLen = d.length;
+    return true;
+  }
+
+  // name is completed when Message 3 arrives
+  bool decodeDigest(ndnph::Region& region, const ndnph::Decoder::Tlv& d)
+  {
+    if (!!authenticatorCertName ||
+        !packet_schema::PakeRequest::AuthenticatorCertDigest::accepts(d.type, d.length)) {
+      return false;
+    }
+    ndnph::Component digest(region, ndnph::TT::ImplicitSha256DigestComponent, d.length, d.value);
+    authenticatorCertName = ndnph::Name().append(region, digest);
+    compactNames = true;
+    return !!authenticatorCertName;
   }
 };
 
 class Device::PakeResponse : public packet_struct::PakeResponse
 {
 public:
-  ndnph::Data::Signed toData(ndnph::Region& region, const ndnph::Interest& pakeRequest) const
+  ndnph::Data::Signed toData(ndnph::Region& region, const ndnph::Name& pakeRequestName) const
   {
-    ndnph::Encoder encoder(region);
-    encoder.prepend(
-      [this](ndnph::Encoder& encoder) {
-        encoder.prependTlv(TT::Spake2PB, ndnph::tlv::Value(spake2pb, sizeof(spake2pb)));
-      },
-      [this](ndnph::Encoder& encoder) {
-        encoder.prependTlv(TT::Spake2CB, ndnph::tlv::Value(spake2cb, sizeof(spake2cb)));
-      });
-    encoder.trim();
+    using Schema = packet_schema::PakeResponse;
+    schema::Writer writer(region, Schema::size(spake2pbLen));
+    writer.write(Schema::Spake2PB::typeOf(spake2pbLen), spake2pb, spake2pbLen);
+    writer.write(TT::Spake2CB, spake2cb, sizeof(spake2cb));
+    ndnph::tlv::Value content = writer.finish();
 
     ndnph::Data data = region.create<ndnph::Data>();
-    if (!encoder || !data || !pakeRequest) {
+    if (!content || !data) {
       return ndnph::Data::Signed();
     }
-    data.setName(pakeRequest.getName());
-    data.setContent(ndnph::tlv::Value(encoder));
+    data.setName(pakeRequestName);
+    data.setContent(content);
     return data.sign(ndnph::NullKey::get());
   }
 };
@@ -90,11 +110,8 @@ public:
     bool ok = ndnph::EvDecoder::decodeValue(
       interest.getAppParameters().makeDecoder(),
       ndnph::EvDecoder::def<TT::Spake2CA>([this](const ndnph::Decoder::Tlv& d) {
-        if (d.length == sizeof(spake2ca)) {
-          std::copy_n(d.value, d.length, spake2ca);
-          return true;
-        }
-        return false;
+        spake2ca = ndnph::tlv::Value(d.value, d.length);
+        return packet_schema::ConfirmRequest::Spake2CA::accepts(d.type, d.length);
       }),
       ndnph::EvDecoder::def<TT::InitializationVector>(&encrypted),
       ndnph::EvDecoder::def<TT::AuthenticationTag>(&encrypted),
@@ -105,16 +122,34 @@ public:
   bool decrypt(ndnph::Region& region, const Encrypted& encrypted, EncryptSession& session)
   {
     auto inner = session.decrypt(region, encrypted);
-    return !!inner &&
-           ndnph::EvDecoder::decodeValue(
-             inner.makeDecoder(), ndnph::EvDecoder::def<TT::Nc>(&nc),
-             ndnph::EvDecoder::def<TT::CaProfileName>([this](const ndnph::Decoder::Tlv& d) {
-               return d.vd().decode(caProfileName) &&
-                      caProfileName[-1].is<ndnph::convention::ImplicitDigest>();
-             }),
-             ndnph::EvDecoder::def<TT::DeviceName>(
-               [this](const ndnph::Decoder::Tlv& d) { return d.vd().decode(deviceName); }),
-             ndnph::EvDecoder::defNni<TT::TimestampNameComponent>(&timestamp));
+    ndnph::tlv::Value caProfileRef, certRef;
+    bool ok =
+      !!inner &&
+      ndnph::EvDecoder::decodeValue(
+        inner.makeDecoder(), ndnph::EvDecoder::def<TT::Nc>(&nc),
+        ndnph::EvDecoder::def<TT::CaProfileName>(
+          [this](const ndnph::Decoder::Tlv& d) { return d.vd().decode(caProfileName); }),
+        ndnph::EvDecoder::def<TT::CaProfileNameRef>(&caProfileRef),
+        ndnph::EvDecoder::def<TT::DeviceName>(
+          [this](const ndnph::Decoder::Tlv& d) { return d.vd().decode(deviceName); }),
+        ndnph::EvDecoder::def<TT::AuthenticatorCertNameRef>(&certRef),
+        ndnph::EvDecoder::defNni<TT::TimestampNameComponent>(&timestamp),
+        ndnph::EvDecoder::def<TT::EmbeddedCaProfile>(&caProfile),
+        ndnph::EvDecoder::def<TT::EmbeddedAuthenticatorCert>(&authenticatorCert));
+    if (!ok) {
+      return false;
+    }
+
+    // references are resolved after DeviceName, which is their base name
+    compactNames = certRef.size() > 0;
+    if (caProfileRef.size() > 0) {
+      caProfileName = NameRef::resolve(region, deviceName, caProfileRef);
+    }
+    if (compactNames) {
+      authenticatorCertName = NameRef::resolve(region, deviceName, certRef);
+      ok = ndnph::certificate::isCertName(authenticatorCertName);
+    }
+    return ok && !!caProfileName && caProfileName[-1].is<ndnph::convention::ImplicitDigest>();
   }
 };
 
@@ -123,22 +158,32 @@ static ndnph::Data::Signed
 makeConfirmResponseData(ndnph::Region& region, const ndnph::Name& confirmRequestName,
                         EncryptSession& session, const Cert& tReq)
 {
-  auto encrypted =
-    session.encrypt(region, [&](ndnph::Encoder& encoder) { encoder.prependTlv(TT::TReq, tReq); });
+  if (!tReq) {
+    return ndnph::Data::Signed();
+  }
+
+  ndnph::Encoder encoder(region);
+  if (!session.encrypt(encoder,
+                       [&](ndnph::Encoder& inner) { inner.prependTlv(TT::TReq, tReq); })) {
+    encoder.discard();
+    return ndnph::Data::Signed();
+  }
+  encoder.trim();
 
   ndnph::Data data = region.create<ndnph::Data>();
-  if (!tReq || !encrypted || !data) {
+  if (!data) {
     return ndnph::Data::Signed();
   }
   data.setName(confirmRequestName);
-  data.setContent(encrypted);
+  data.setContent(ndnph::tlv::Value(encoder));
   return data.sign(ndnph::NullKey::get());
 }
 
 class Device::CredentialRequest : public packet_struct::CredentialRequest
 {
 public:
-  bool fromInterest(ndnph::Region& region, const ndnph::Interest& interest, EncryptSession& session)
+  bool fromInterest(ndnph::Region& region, const ndnph::Interest& interest,
+                    EncryptSession& session)
   {
     Encrypted encrypted;
     bool ok =
@@ -151,17 +196,26 @@ public:
     }
 
     auto inner = session.decrypt(region, encrypted);
-    return !!inner && ndnph::EvDecoder::decodeValue(inner.makeDecoder(),
-                                                    ndnph::EvDecoder::def<TT::IssuedCertName>(
-                                                      [this](const ndnph::Decoder::Tlv& d) {
-                                                        return d.vd().decode(tempCertName);
-                                                      }));
+    ndnph::tlv::Value ref;
+    ok = !!inner &&
+         ndnph::EvDecoder::decodeValue(
+           inner.makeDecoder(),
+           ndnph::EvDecoder::def<TT::IssuedCertName>(
+             [this](const ndnph::Decoder::Tlv& d) { return d.vd().decode(tempCertName); }),
+           ndnph::EvDecoder::def<TT::IssuedCertNameRef>(&ref),
+           ndnph::EvDecoder::def<TT::EmbeddedIssuedCert>(&tempCert));
+    if (ok && ref.size() > 0) {
+      compactNames = true;
+      tempCertName = NameRef::resolve(region, tempCertReqName, ref);
+    }
+    return ok && !!tempCertName;
   }
 };
 
 Device::Device(const Options& opts)
   : PacketHandler(opts.face, 192)
   , m_pending(this)
+  , m_pendingCert(this)
 {}
 
 void
@@ -170,6 +224,9 @@ Device::end()
   finishSession();
   m_state = State::Idle;
   m_oRegion.reset();
+  m_lastReplyName = ndnph::Name();
+  m_lastReply = ndnph::tlv::Value();
+  m_replyRegion.reset();
 }
 
 bool
@@ -178,17 +235,18 @@ Device::begin(ndnph::tlv::Value password)
   end();
   m_iRegion.reset(new decltype(m_iRegion)::element_type);
   m_oRegion.reset(new decltype(m_oRegion)::element_type);
+  m_replyRegion.reset(new decltype(m_replyRegion)::element_type);
 
-  uint8_t* passwordCopy = m_iRegion->alloc(password.size());
-  if (passwordCopy == nullptr) {
+  m_spake2.reset(m_iRegion->make<Spake2Device>(spake2::Drbg::forThread()));
+  m_pakeResponse = m_iRegion->make<PakeResponse>();
+  bool ok = m_spake2 != nullptr && m_pakeResponse != nullptr &&
+            m_spake2->precompute(password.begin(), password.size()) &&
+            m_spake2->startGenerateFirstMessage();
+  if (!ok) {
     end();
     return false;
   }
-  std::copy(password.begin(), password.end(), passwordCopy);
-  m_password = ndnph::tlv::Value(passwordCopy, password.size());
-
-  m_spake2.reset(new Spake2Device(entropy));
-  m_state = State::WaitPakeRequest;
+  m_state = State::PrecomputePake;
   return true;
 }
 
@@ -196,22 +254,47 @@ void
 Device::loop()
 {
   switch (m_state) {
-    case State::FetchCaProfile: {
-      sendFetchInterest(m_caProfileName, State::WaitCaProfile);
+    case State::PrecomputePake:
+    case State::ComputePakeShare:
+    case State::ComputePakeKey: {
+      continuePake();
       break;
     }
-    case State::FetchAuthenticatorCert: {
-      sendFetchInterest(m_authenticatorCertName, State::WaitAuthenticatorCert);
+    case State::FetchCaProfileAndCert: {
+      // both names are known, so that both are fetched in the same round trip
+      // packets embedded in Message 3 are not fetched
+      GotoState gotoState(this);
+      uint16_t lifetime = m_rtt.onRequest();
+      (m_hasCaProfile || sendFetchInterest(m_pending, m_caProfileName, lifetime)) &&
+        (!!m_authenticatorCert ||
+         sendFetchInterest(m_pendingCert, m_authenticatorCertName, lifetime)) &&
+        gotoState(State::WaitCaProfileAndCert);
       break;
     }
     case State::FetchTempCert: {
-      sendFetchInterest(m_tempCertName, State::WaitTempCert);
+      GotoState gotoState(this);
+      sendFetchInterest(m_pending, m_tempCertName, m_rtt.onRequest()) &&
+        gotoState(State::WaitTempCert);
+      break;
+    }
+    case State::WaitCaProfileAndCert: {
+      // RTO is backed off once, even if both Interests have expired
+      bool retxCaProfile = !m_hasCaProfile && m_pending.expired();
+      bool retxCert = !m_authenticatorCert && m_pendingCert.expired();
+      if (!retxCaProfile && !retxCert) {
+        break;
+      }
+      uint16_t lifetime = m_rtt.onTimeout();
+      bool ok = (!retxCaProfile || sendFetchInterest(m_pending, m_caProfileName, lifetime)) &&
+                (!retxCert || sendFetchInterest(m_pendingCert, m_authenticatorCertName, lifetime));
+      if (!ok) {
+        m_state = State::Failure;
+      }
       break;
     }
-    case State::WaitCaProfile:
-    case State::WaitAuthenticatorCert:
     case State::WaitTempCert: {
-      if (m_pending.expired()) {
+      if (m_pending.expired() &&
+          !sendFetchInterest(m_pending, m_tempCertName, m_rtt.onTimeout())) {
         m_state = State::Failure;
       }
       break;
@@ -224,7 +307,20 @@ Device::loop()
 bool
 Device::processInterest(ndnph::Interest interest)
 {
+  // a retransmitted Interest is recognized by its name, which covers the parameters digest
+  const ndnph::Name& name = interest.getName();
+  if (m_state != State::Failure && !!m_lastReply && name == m_lastReplyName) {
+    // the reply was lost: send it again
+    return send(m_lastReply, *getCurrentPacketInfo());
+  }
+  if (m_state != State::Failure && !!m_lastInterestName && name == m_lastInterestName) {
+    // the reply is still being prepared: send it toward the latest PIT token
+    m_lastInterestPacketInfo = *getCurrentPacketInfo();
+    return true;
+  }
+
   switch (m_state) {
+    case State::PrecomputePake:
     case State::WaitPakeRequest: {
       return handlePakeRequest(interest);
     }
@@ -256,6 +352,25 @@ Device::saveCurrentInterest(ndnph::Interest interest)
   m_lastInterestPacketInfo = *getCurrentPacketInfo();
 }
 
+template<typename Packet>
+bool
+Device::sendReply(const Packet& packet)
+{
+  // keep the encoded reply, in case the Interest is retransmitted
+  m_replyRegion->reset();
+  m_lastReply = ndnph::tlv::Value();
+  m_lastReplyName = m_lastInterestName.clone(*m_replyRegion);
+  ndnph::Encoder encoder(*m_replyRegion);
+  encoder.prepend(packet);
+  if (!m_lastReplyName || !encoder) {
+    encoder.discard();
+    return false;
+  }
+  encoder.trim();
+  m_lastReply = ndnph::tlv::Value(encoder);
+  return send(m_lastReply, m_lastInterestPacketInfo);
+}
+
 bool
 Device::handlePakeRequest(ndnph::Interest interest)
 {
@@ -263,26 +378,77 @@ Device::handlePakeRequest(ndnph::Interest interest)
     return false;
   }
 
-  ndnph::StaticRegion<2048> region;
   GotoState gotoState(this);
-  PakeRequest req;
-  PakeResponse res;
-  bool ok =
-    req.fromInterest(region, interest) &&
-    m_spake2->start(m_password.begin(), m_password.size(), nullptr, 0,
-                    req.authenticatorCertName[-1].value(), req.authenticatorCertName[-1].length(),
-                    m_session.ss.value(), m_session.ss.length()) &&
-    m_spake2->generateFirstMessage(res.spake2pb, sizeof(res.spake2pb)) &&
-    m_spake2->processFirstMessage(req.spake2pa, sizeof(req.spake2pa)) &&
-    m_spake2->generateSecondMessage(res.spake2cb, sizeof(res.spake2cb)) &&
-    reply(res.toData(region, interest)) && gotoState(State::WaitConfirmRequest);
-
-  if (ok) {
-    m_authenticatorCertName = req.authenticatorCertName.clone(*m_iRegion);
+  m_pakeRequest = m_iRegion->make<PakeRequest>();
+  if (m_pakeRequest == nullptr || !m_pakeRequest->fromInterest(*m_iRegion, interest)) {
+    return true;
+  }
+
+  m_authenticatorCertName = m_pakeRequest->authenticatorCertName.clone(*m_iRegion);
+  bool ok = !!m_authenticatorCertName &&
+            m_spake2->bind(nullptr, 0, m_authenticatorCertName[-1].value(),
+                           m_authenticatorCertName[-1].length(), m_session.ss.value(),
+                           m_session.ss.length());
+  if (!ok) {
+    return true;
+  }
+
+  saveCurrentInterest(interest);
+  m_rtt.begin();
+  // reply with a public share in the same format as the authenticator's
+  m_pakeResponse->spake2pbLen = m_pakeRequest->spake2paLen;
+  if (m_state == State::PrecomputePake) {
+    // public share is still being computed
+    return gotoState(State::ComputePakeShare);
   }
+  processPakeShares() && gotoState(State::ComputePakeKey);
   return true;
 }
 
+bool
+Device::processPakeShares()
+{
+  return m_spake2->generateFirstMessage(m_pakeResponse->spake2pb, m_pakeResponse->spake2pbLen) &&
+         m_spake2->startProcessFirstMessage(m_pakeRequest->spake2pa, m_pakeRequest->spake2paLen);
+}
+
+void
+Device::continuePake()
+{
+  GotoState gotoState(this);
+  switch (m_spake2->step(Spake2StepBudget::value)) {
+    case spake2::Progress::Done: {
+      break;
+    }
+    case spake2::Progress::Pending: {
+      gotoState(m_state);
+      return;
+    }
+    default:
+      return;
+  }
+
+  switch (m_state) {
+    case State::PrecomputePake: {
+      // public share is retrieved when the PAKE request indicates its format
+      gotoState(State::WaitPakeRequest);
+      break;
+    }
+    case State::ComputePakeShare: {
+      processPakeShares() && gotoState(State::ComputePakeKey);
+      break;
+    }
+    default: {
+      ndnph::StaticRegion<2048> region;
+      m_spake2->generateSecondMessage(m_pakeResponse->spake2cb,
+                                      sizeof(m_pakeResponse->spake2cb)) &&
+        sendReply(m_pakeResponse->toData(region, m_lastInterestName)) &&
+        gotoState(State::WaitConfirmRequest);
+      break;
+    }
+  }
+}
+
 bool
 Device::handleConfirmRequest(ndnph::Interest interest)
 {
@@ -290,22 +456,37 @@ Device::handleConfirmRequest(ndnph::Interest interest)
     return false;
   }
 
-  ndnph::StaticRegion<2048> region;
   GotoState gotoState(this);
   ConfirmRequest req;
   bool ok = false;
   Encrypted encrypted;
   std::tie(ok, encrypted) = req.fromInterest(interest);
-  ok = ok && m_spake2->processSecondMessage(req.spake2ca, sizeof(req.spake2ca));
+  ok = ok && m_spake2->processSecondMessage(req.spake2ca.begin(), req.spake2ca.size());
   if (!ok) {
     return true;
   }
 
+  // plaintext and embedded packets may approach MaxEmbedLimit, too large for the stack
+  m_embedRegion.reset(new EmbedRegion);
+  ndnph::Region& region = *m_embedRegion;
   ok = m_session.importKey(m_spake2->getSharedKey()) && req.decrypt(region, encrypted, m_session);
   if (!ok) {
     return true;
   }
 
+  // a compact Message 1 carries only the digest of the authenticator certificate name
+  bool hasCertName = m_authenticatorCertName.size() > 1;
+  if (req.compactNames == hasCertName) {
+    return true;
+  }
+  if (req.compactNames) {
+    m_authenticatorCertName =
+      req.authenticatorCertName.append(*m_iRegion, m_authenticatorCertName[-1]);
+    if (!m_authenticatorCertName) {
+      return true;
+    }
+  }
+
   ndnph::port::UnixTime::set(req.timestamp);
 
   saveCurrentInterest(interest);
@@ -313,7 +494,29 @@ Device::handleConfirmRequest(ndnph::Interest interest)
   m_caProfileName = req.caProfileName.clone(*m_iRegion);
   m_deviceName = req.deviceName.clone(*m_oRegion);
 
-  return gotoState(State::FetchCaProfile);
+  // embedded packets are verified against the same digests as fetched packets
+  ndnph::Data caProfile = decodeEmbedded(region, req.caProfile, m_caProfileName);
+  ndnph::Data cert = decodeEmbedded(region, req.authenticatorCert, m_authenticatorCertName);
+  if ((!!req.caProfile && !caProfile) || (!!req.authenticatorCert && !cert)) {
+    return true;
+  }
+  if (!!caProfile && !(m_caProfile.fromData(*m_oRegion, caProfile) && checkCaProfile())) {
+    return true;
+  }
+
+  if (!!caProfile && !!cert) {
+    sendConfirmResponse(cert) && gotoState(State::WaitCredentialRequest);
+    m_embedRegion.reset();
+    return true;
+  }
+  if (!!cert) {
+    m_certRegion.reset(new decltype(m_certRegion)::element_type);
+    if (!m_authenticatorCert.build(*m_certRegion, cert)) {
+      return true;
+    }
+  }
+  m_embedRegion.reset();
+  return gotoState(State::FetchCaProfileAndCert);
 }
 
 bool
@@ -323,47 +526,63 @@ Device::handleCredentialRequest(ndnph::Interest interest)
     return false;
   }
 
-  ndnph::StaticRegion<2048> region;
   GotoState gotoState(this);
+  // plaintext and embedded packet may approach MaxEmbedLimit, too large for the stack
+  m_embedRegion.reset(new EmbedRegion);
+  ndnph::Region& region = *m_embedRegion;
   CredentialRequest req;
+  req.tempCertReqName = m_tempCertReqName;
   if (!req.fromInterest(region, interest, m_session)) {
     return true;
   }
 
   saveCurrentInterest(interest);
+  if (!!req.tempCert) {
+    ndnph::Data tempCert = decodeEmbedded(region, req.tempCert, req.tempCertName);
+    !!tempCert && sendCredentialResponse(tempCert) && gotoState(State::Success);
+    m_embedRegion.reset();
+    return true;
+  }
+
   m_tempCertName = req.tempCertName.clone(*m_iRegion);
+  m_embedRegion.reset();
   return gotoState(State::FetchTempCert);
 }
 
-void
-Device::sendFetchInterest(const ndnph::Name& name, State nextState)
+bool
+Device::sendFetchInterest(OutgoingPendingInterest& pending, const ndnph::Name& name,
+                          uint16_t lifetime)
 {
   ndnph::StaticRegion<2048> region;
-  GotoState gotoState(this);
   auto interest = region.create<ndnph::Interest>();
-  if (!interest) {
-    return;
+  if (!interest || lifetime == 0) {
+    return false;
   }
   interest.setName(name);
-  interest.setLifetime(InterestLifetime::value);
-  m_pending.send(interest, WithEndpointId(m_lastInterestPacketInfo.endpointId)) &&
-    gotoState(nextState);
+  interest.setLifetime(lifetime);
+  return pending.send(interest, WithEndpointId(m_lastInterestPacketInfo.endpointId));
 }
 
 bool
 Device::processData(ndnph::Data data)
 {
-  if (!m_pending.matchPitToken()) {
-    return false;
-  }
   switch (m_state) {
-    case State::WaitCaProfile: {
-      return handleCaProfile(data);
-    }
-    case State::WaitAuthenticatorCert: {
-      return handleAuthenticatorCert(data);
+    case State::WaitCaProfileAndCert: {
+      if (m_pending.matchPitToken()) {
+        m_rtt.onReply();
+        return handleCaProfile(data);
+      }
+      if (m_pendingCert.matchPitToken()) {
+        m_rtt.onReply();
+        return handleAuthenticatorCert(data);
+      }
+      break;
     }
     case State::WaitTempCert: {
+      if (!m_pending.matchPitToken()) {
+        return false;
+      }
+      m_rtt.onReply();
       return handleTempCert(data);
     }
     default:
@@ -375,43 +594,74 @@ Device::processData(ndnph::Data data)
 bool
 Device::handleCaProfile(ndnph::Data data)
 {
-  if (!m_pending.match(data, m_caProfileName) || !m_caProfile.fromData(*m_oRegion, data)) {
+  if (m_hasCaProfile || !m_pending.match(data, m_caProfileName) ||
+      !m_caProfile.fromData(*m_oRegion, data)) {
     return false;
   }
 
   GotoState gotoState(this);
-  if (!ndnph::certificate::getValidity(m_caProfile.cert).includes(time(nullptr))) {
-    // CA certificate expired
+  if (!checkCaProfile()) {
     return true;
   }
 
-  gotoState(State::FetchAuthenticatorCert);
+  if (!m_authenticatorCert) {
+    // authenticator certificate is verified when it arrives
+    gotoState(m_state);
+    return true;
+  }
+  sendConfirmResponse(m_authenticatorCert.data) && gotoState(State::WaitCredentialRequest);
+  return true;
+}
+
+bool
+Device::checkCaProfile()
+{
+  if (!ndnph::certificate::getValidity(m_caProfile.cert).includes(time(nullptr))) {
+    // CA certificate expired
+    return false;
+  }
+  m_hasCaProfile = true;
   return true;
 }
 
 bool
 Device::handleAuthenticatorCert(ndnph::Data data)
 {
-  if (!m_pending.match(data, m_authenticatorCertName)) {
+  if (!!m_authenticatorCert || !m_pendingCert.match(data, m_authenticatorCertName)) {
     return false;
   }
 
-  ndnph::StaticRegion<2048> region;
   GotoState gotoState(this);
-  if (!data.verify(m_caProfile.pub) || !ndnph::certificate::getValidity(data).includesUnix()) {
+  if (!m_hasCaProfile) {
+    // keep a copy until CA profile arrives, because the packet buffer is reused
+    m_certRegion.reset(new decltype(m_certRegion)::element_type);
+    m_authenticatorCert.build(*m_certRegion, data) && gotoState(m_state);
+    return true;
+  }
+  sendConfirmResponse(data) && gotoState(State::WaitCredentialRequest);
+  return true;
+}
+
+bool
+Device::sendConfirmResponse(const ndnph::Data& authenticatorCert)
+{
+  ndnph::StaticRegion<2048> region;
+  if (!authenticatorCert.verify(m_caProfile.pub) ||
+      !ndnph::certificate::getValidity(authenticatorCert).includesUnix()) {
     return false;
   }
 
-  ndnph::Name tSubject = computeTempSubjectName(region, data.getName(), m_deviceName);
+  ndnph::Name tSubject = computeTempSubjectName(region, authenticatorCert.getName(), m_deviceName);
   if (!tSubject || !ndnph::ec::generate(*m_oRegion, tSubject, m_tPvt, m_tPub)) {
-    return true;
+    return false;
   }
 
   auto tCert = m_tPub.selfSign(region, ndnph::ValidityPeriod::getMax(), m_tPvt);
-  send(makeConfirmResponseData(region, m_lastInterestName, m_session, tCert),
-       m_lastInterestPacketInfo) &&
-    gotoState(State::WaitCredentialRequest);
-  return true;
+  m_tempCertReqName = tCert.getName().clone(*m_iRegion);
+  if (!m_authenticatorPub.import(*m_iRegion, authenticatorCert)) {
+    return false;
+  }
+  return sendReply(makeConfirmResponseData(region, m_lastInterestName, m_session, tCert));
 }
 
 bool
@@ -422,18 +672,28 @@ Device::handleTempCert(ndnph::Data data)
   }
 
   GotoState gotoState(this);
+  sendCredentialResponse(data) && gotoState(State::Success);
+  return true;
+}
+
+bool
+Device::sendCredentialResponse(const ndnph::Data& tempCert)
+{
+  if (!tempCert.verify(m_authenticatorPub) ||
+      !ndnph::certificate::getValidity(tempCert).includesUnix()) {
+    return false;
+  }
+
   ndnph::StaticRegion<2048> region;
   auto res = region.create<ndnph::Data>();
-
   m_tempCert = m_oRegion->create<ndnph::Data>();
-  if (!res || !m_tempCert || !m_tempCert.decodeFrom(data)) {
-    return true;
+  if (!res || !m_tempCert || !m_tempCert.decodeFrom(tempCert)) {
+    return false;
   }
   m_tPvt.setName(m_tempCert.getName());
 
   res.setName(m_lastInterestName);
-  send(res.sign(m_tPvt), m_lastInterestPacketInfo) && gotoState(State::Success);
-  return true;
+  return sendReply(res.sign(m_tPvt));
 }
 
 void
@@ -441,6 +701,13 @@ Device::finishSession()
 {
   m_session.end();
   m_spake2.reset();
+  m_pakeRequest = nullptr;
+  m_pakeResponse = nullptr;
+  m_hasCaProfile = false;
+  m_authenticatorCert = EncodedData();
+  m_certRegion.reset();
+  m_embedRegion.reset();
+  m_lastInterestName = ndnph::Name();
   m_iRegion.reset();
 }
 
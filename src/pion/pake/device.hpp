@@ -20,17 +20,24 @@ public:
 
   void end();
 
+  /**
+   * @brief Start waiting for the authenticator with a new password.
+   *
+   * Password-dependent SPAKE2 computation begins immediately and progresses in loop() while
+   * waiting for the PAKE request. Call begin() again whenever the password is regenerated.
+   */
   bool begin(ndnph::tlv::Value password);
 
   enum class State
   {
     Idle,
+    PrecomputePake,
     WaitPakeRequest,
+    ComputePakeShare,
+    ComputePakeKey,
     WaitConfirmRequest,
-    FetchCaProfile,
-    WaitCaProfile,
-    FetchAuthenticatorCert,
-    WaitAuthenticatorCert,
+    FetchCaProfileAndCert,
+    WaitCaProfileAndCert,
     WaitCredentialRequest,
     FetchTempCert,
     WaitTempCert,
@@ -84,20 +91,34 @@ private:
 
   bool handlePakeRequest(ndnph::Interest interest);
 
+  void continuePake();
+
+  bool processPakeShares();
+
   bool handleConfirmRequest(ndnph::Interest interest);
 
   bool handleCredentialRequest(ndnph::Interest interest);
 
-  void sendFetchInterest(const ndnph::Name& name, State nextState);
+  template<typename Packet>
+  bool sendReply(const Packet& packet);
+
+  bool sendFetchInterest(OutgoingPendingInterest& pending, const ndnph::Name& name,
+                         uint16_t lifetime);
 
   bool processData(ndnph::Data data) final;
 
   bool handleCaProfile(ndnph::Data data);
 
+  bool checkCaProfile();
+
   bool handleAuthenticatorCert(ndnph::Data data);
 
+  bool sendConfirmResponse(const ndnph::Data& authenticatorCert);
+
   bool handleTempCert(ndnph::Data data);
 
+  bool sendCredentialResponse(const ndnph::Data& tempCert);
+
   void finishSession();
 
 private:
@@ -107,23 +128,35 @@ private:
   class ConfirmRequest;
   class CredentialRequest;
 
-  OutgoingPendingInterest m_pending;
+  OutgoingPendingInterest m_pending;     // Message 3 CA profile, Message 5 temp cert
+  OutgoingPendingInterest m_pendingCert; // Message 3 authenticator cert
+  RttEstimator m_rtt;
   State m_state = State::Idle;
-  std::unique_ptr<ndnph::StaticRegion<2048>> m_iRegion; // for intermediate values
-  std::unique_ptr<ndnph::StaticRegion<2048>> m_oRegion; // for output values
+  std::unique_ptr<ndnph::StaticRegion<2048>> m_iRegion;     // for intermediate values
+  std::unique_ptr<ndnph::StaticRegion<2048>> m_oRegion;     // for output values
+  std::unique_ptr<ndnph::StaticRegion<1024>> m_certRegion;  // for early authenticator cert
+  std::unique_ptr<EmbedRegion> m_embedRegion;               // for Message 3 or 5 being handled
+  std::unique_ptr<ndnph::StaticRegion<1024>> m_replyRegion; // for last reply
 
-  ndnph::tlv::Value m_password;
   EncryptSession m_session;
-  std::unique_ptr<Spake2Device> m_spake2;
+  RegionPtr<Spake2Device> m_spake2; // in m_iRegion
+  PakeRequest* m_pakeRequest = nullptr;   // in m_iRegion
+  PakeResponse* m_pakeResponse = nullptr; // in m_iRegion
 
   ndnph::Name m_lastInterestName;
   PacketInfo m_lastInterestPacketInfo;
+  ndnph::Name m_lastReplyName;   // in m_replyRegion, kept after the session ends
+  ndnph::tlv::Value m_lastReply; // in m_replyRegion
   ndnph::Name m_authenticatorCertName;
   ndnph::Name m_caProfileName;
+  bool m_hasCaProfile = false;
+  EncodedData m_authenticatorCert; // in m_certRegion, if it arrives before CA profile
+  ndnph::Name m_tempCertReqName;
   ndnph::Name m_tempCertName;
 
   ndnph::EcPrivateKey m_tPvt;
   ndnph::EcPublicKey m_tPub;
+  ndnph::EcPublicKey m_authenticatorPub; // name in m_iRegion
   ndnph::tlv::Value m_networkCredential;
   ndnph::ndncert::client::CaProfile m_caProfile;
   ndnph::Name m_deviceName;
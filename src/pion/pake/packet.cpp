@@ -1,13 +1,143 @@
 #include "packet.hpp"
 
+#include <cstdlib>
+#include <limits>
+
 namespace pion {
 namespace pake {
 
+namespace detail {
+
+/** @brief Return the number of 16-octet blocks in a message, which advances the IV counter. */
+static uint64_t
+countBlocks(size_t len)
+{
+  return (static_cast<uint64_t>(len) + 15) / 16;
+}
+
+bool
+AeadIv::reset()
+{
+  m_counter = 0;
+  m_hasPeer = false;
+  return ndnph::port::RandomSource::generate(m_prefix.data(), m_prefix.size());
+}
+
+bool
+AeadIv::next(uint8_t iv[IvLen::value], size_t len)
+{
+  uint64_t next = m_counter + countBlocks(len);
+  if (next > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+  std::copy(m_prefix.begin(), m_prefix.end(), iv);
+  for (int i = 0; i < 4; ++i) {
+    iv[PrefixLen + i] = static_cast<uint8_t>(m_counter >> (24 - 8 * i));
+  }
+  m_counter = next;
+  return true;
+}
+
+static uint64_t
+readCounter(const uint8_t* input)
+{
+  uint64_t counter = 0;
+  for (int i = 0; i < 4; ++i) {
+    counter = (counter << 8) | input[i];
+  }
+  return counter;
+}
+
+bool
+AeadIv::check(const uint8_t iv[IvLen::value]) const
+{
+  if (std::equal(m_prefix.begin(), m_prefix.end(), iv)) {
+    return false;
+  }
+  return !m_hasPeer || (std::equal(m_peerPrefix.begin(), m_peerPrefix.end(), iv) &&
+                        readCounter(&iv[PrefixLen]) >= m_peerCounter);
+}
+
+void
+AeadIv::accept(const uint8_t iv[IvLen::value], size_t len)
+{
+  std::copy_n(iv, PrefixLen, m_peerPrefix.begin());
+  m_peerCounter = readCounter(&iv[PrefixLen]) + countBlocks(len);
+  m_hasPeer = true;
+}
+
+} // namespace detail
+
+bool
+AesGcm::import(const Key& key)
+{
+  return m_iv.reset() &&
+         mbedtls_gcm_setkey(m_gcm, MBEDTLS_CIPHER_ID_AES, key.data(), key.size() * 8) == 0;
+}
+
+bool
+AesGcm::encrypt(uint8_t iv[IvLen::value], uint8_t tag[TagLen::value], uint8_t* buf, size_t len,
+                const uint8_t* aad, size_t aadLen)
+{
+  return m_iv.next(iv, len) &&
+         mbedtls_gcm_crypt_and_tag(m_gcm, MBEDTLS_GCM_ENCRYPT, len, iv, IvLen::value, aad, aadLen,
+                                   buf, buf, TagLen::value, tag) == 0;
+}
+
+bool
+AesGcm::decrypt(const uint8_t iv[IvLen::value], const uint8_t tag[TagLen::value], uint8_t* buf,
+                size_t len, const uint8_t* aad, size_t aadLen)
+{
+  if (!m_iv.check(iv) || mbedtls_gcm_auth_decrypt(m_gcm, len, iv, IvLen::value, aad, aadLen, tag,
+                                                  TagLen::value, buf, buf) != 0) {
+    return false;
+  }
+  m_iv.accept(iv, len);
+  return true;
+}
+
+#ifdef MBEDTLS_CHACHAPOLY_C
+bool
+ChaChaPoly::import(const Key& key)
+{
+  static const uint8_t info[] = { 'P', 'I', 'O', 'N', ' ', 'C', 'h', 'a', 'C', 'h', 'a', '2',
+                                  '0', '-', 'P', 'o', 'l', 'y', '1', '3', '0', '5' };
+  uint8_t expanded[32];
+  bool ok = m_iv.reset() &&
+            mbedtls_hkdf(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), nullptr, 0, key.data(),
+                         key.size(), info, sizeof(info), expanded, sizeof(expanded)) == 0 &&
+            mbedtls_chachapoly_setkey(m_ctx, expanded) == 0;
+  mbedtls_platform_zeroize(expanded, sizeof(expanded));
+  return ok;
+}
+
+bool
+ChaChaPoly::encrypt(uint8_t iv[IvLen::value], uint8_t tag[TagLen::value], uint8_t* buf,
+                    size_t len, const uint8_t* aad, size_t aadLen)
+{
+  return m_iv.next(iv, len) &&
+         mbedtls_chachapoly_encrypt_and_tag(m_ctx, len, iv, aad, aadLen, buf, buf, tag) == 0;
+}
+
+bool
+ChaChaPoly::decrypt(const uint8_t iv[IvLen::value], const uint8_t tag[TagLen::value],
+                    uint8_t* buf, size_t len, const uint8_t* aad, size_t aadLen)
+{
+  if (!m_iv.check(iv) ||
+      mbedtls_chachapoly_auth_decrypt(m_ctx, len, iv, aad, aadLen, tag, buf, buf) != 0) {
+    return false;
+  }
+  m_iv.accept(iv, len);
+  return true;
+}
+#endif // MBEDTLS_CHACHAPOLY_C
+
 void
 EncryptSession::end()
 {
   ss = ndnph::Component();
-  aes.reset();
+  clearKey();
+  m_names.fill(ndnph::Name());
 }
 
 bool
@@ -18,7 +148,13 @@ EncryptSession::begin(ndnph::Region& region)
     return false;
   }
   ss = ndnph::Component(region, sizeof(value), value);
-  return true;
+  m_names = {
+    getPionPrefix().append(region, ss, getPakeComponent()),
+    getPionPrefix().append(region, ss, getConfirmComponent()),
+    getPionPrefix().append(region, ss, getCredentialComponent()),
+  };
+  return !!ss && std::all_of(m_names.begin(), m_names.end(),
+                             [](const ndnph::Name& name) { return !!name; });
 }
 
 bool
@@ -33,13 +169,115 @@ EncryptSession::assign(ndnph::Region& region, ndnph::Name name)
 ndnph::Name
 EncryptSession::makeName(ndnph::Region& region, const ndnph::Component& verb)
 {
+  for (const auto& name : m_names) {
+    if (!!name && name[-1] == verb) {
+      return name;
+    }
+  }
   return getPionPrefix().append(region, ss, verb);
 }
 
 ndnph::tlv::Value
 EncryptSession::decrypt(ndnph::Region& region, const Encrypted& encrypted)
 {
-  return aes->decrypt(region, encrypted, ss.value(), ss.length());
+  size_t len = encrypted.ciphertext.size();
+  uint8_t* buf = region.alloc(len);
+  if (aead == nullptr || buf == nullptr) {
+    return ndnph::tlv::Value();
+  }
+
+  // decrypt a copy, so that the received packet stays intact if authentication fails
+  std::copy(encrypted.ciphertext.begin(), encrypted.ciphertext.end(), buf);
+  if (!aead->decrypt(encrypted.iv.data(), encrypted.tag.data(), buf, len, ss.value(),
+                     ss.length())) {
+    mbedtls_platform_zeroize(buf, len);
+    return ndnph::tlv::Value();
+  }
+  return ndnph::tlv::Value(buf, len);
+}
+
+bool
+EncodedData::decode(ndnph::Region& region, ndnph::tlv::Value input)
+{
+  wire = input;
+  data = region.create<ndnph::Data>();
+  if (!data || !wire.makeDecoder().decode(data)) {
+    return false;
+  }
+  fullName = data.getFullName(region);
+  return !!fullName;
+}
+
+bool
+EncodedData::match(const ndnph::Interest& interest) const
+{
+  const ndnph::Name& name = interest.getName();
+  if (name.size() > 0 && name[-1].type() == ndnph::TT::ImplicitSha256DigestComponent) {
+    return name == fullName && (!interest.getMustBeFresh() || data.getFreshnessPeriod() > 0);
+  }
+  return interest.match(data);
+}
+
+ndnph::Data
+decodeEmbedded(ndnph::Region& region, ndnph::tlv::Value wire, const ndnph::Name& fullName)
+{
+  if (!wire) {
+    return ndnph::Data();
+  }
+  ndnph::Data data = region.create<ndnph::Data>();
+  if (!data || !wire.makeDecoder().decode(data) || data.getFullName(region) != fullName) {
+    return ndnph::Data();
+  }
+  return data;
+}
+
+NameRef::NameRef(const ndnph::Name& base, const ndnph::Name& name)
+{
+  size_t maxPrefixLen = std::min<size_t>(std::min(base.size(), name.size()), 0xFF);
+  size_t prefixLen = 0;
+  while (prefixLen < maxPrefixLen && base[prefixLen] == name[prefixLen]) {
+    ++prefixLen;
+  }
+  m_prefixLen = static_cast<uint8_t>(prefixLen);
+  m_suffix = name.slice(prefixLen);
+}
+
+bool
+NameRef::writeTo(schema::Writer& writer, uint32_t type) const
+{
+  uint8_t* room = writer.writeTypeLength(type, length());
+  if (room == nullptr) {
+    return false;
+  }
+  room[0] = m_prefixLen;
+  std::copy_n(m_suffix.value(), m_suffix.length(), &room[1]);
+  return true;
+}
+
+ndnph::Name
+NameRef::resolve(ndnph::Region& region, const ndnph::Name& base, ndnph::tlv::Value value)
+{
+  if (value.size() < 1 || value.begin()[0] > base.size()) {
+    return ndnph::Name();
+  }
+
+  ndnph::Name prefix = base.getPrefix(value.begin()[0]);
+  ndnph::Encoder encoder(region);
+  encoder.prepend(ndnph::tlv::Value(prefix.value(), prefix.length()),
+                  ndnph::tlv::Value(value.begin() + 1, value.size() - 1));
+  encoder.prependTypeLength(ndnph::TT::Name, encoder.size());
+  if (!encoder) {
+    encoder.discard();
+    return ndnph::Name();
+  }
+  encoder.trim();
+
+  // decoding validates the suffix components
+  ndnph::Name name;
+  if (!ndnph::tlv::Value(encoder).makeDecoder().decode(name)) {
+    return ndnph::Name();
+  }
+  return name;
 }
 
 ndnph::Name
@@ -67,5 +305,61 @@ computeTempSubjectName(ndnph::Region& region, ndnph::Name authenticatorCertName,
   return ndnph::Name(encoder.begin(), encoder.size());
 }
 
+void
+RttEstimator::begin()
+{
+  m_deadline = ndnph::port::Clock::add(ndnph::port::Clock::now(), SessionTimeout::value);
+  m_srtt = -1;
+  m_rttvar = 0;
+  m_rto = InitialRto;
+  m_allowance = 0;
+  m_sampling = false;
+}
+
+uint16_t
+RttEstimator::onRequest(int allowance)
+{
+  m_sentAt = ndnph::port::Clock::now();
+  m_allowance = allowance;
+  m_sampling = allowance == 0;
+  return computeLifetime();
+}
+
+uint16_t
+RttEstimator::onTimeout()
+{
+  m_sampling = false;
+  m_rto = std::min<int>(2 * m_rto, MaxRto);
+  return computeLifetime();
+}
+
+void
+RttEstimator::onReply()
+{
+  if (!m_sampling) {
+    return;
+  }
+  m_sampling = false;
+
+  int rtt = std::max<int>(0, ndnph::port::Clock::sub(ndnph::port::Clock::now(), m_sentAt));
+  if (m_srtt < 0) {
+    m_srtt = rtt;
+    m_rttvar = rtt / 2;
+  } else {
+    m_rttvar = (3 * m_rttvar + std::abs(m_srtt - rtt)) / 4;
+    m_srtt = (7 * m_srtt + rtt) / 8;
+  }
+  m_rto = std::min<int>(std::max<int>(m_srtt + 4 * m_rttvar, MinRto), MaxRto);
+}
+
+uint16_t
+RttEstimator::computeLifetime() const
+{
+  // the last transmission in a session expires no later than SessionTimeout
+  int remaining = static_cast<int>(ndnph::port::Clock::sub(m_deadline, ndnph::port::Clock::now()));
+  int lifetime = std::min<int>(m_rto + m_allowance, InterestLifetime::value);
+  return static_cast<uint16_t>(std::max(0, std::min(lifetime, remaining)));
+}
+
 } // namespace pake
 } // namespace pion
@@ -3,12 +3,44 @@
 
 #include "../spake2/spake2.hpp"
 #include "an.hpp"
+#include "schema.hpp"
+
+#include <mbedtls/chachapoly.h>
+#include <mbedtls/gcm.h>
+
+#include <new>
+#include <type_traits>
 
 namespace pion {
 namespace pake {
 
-using Spake2Authenticator = spake2::Context<spake2::Role::Alice>;
-using Spake2Device = spake2::Context<spake2::Role::Bob>;
+/**
+ * @brief SPAKE2 group used in the PAKE stage.
+ *
+ * Define this macro to spake2::Edwards25519 to select the SPAKE2-Edwards25519-SHA256-HKDF-HMAC
+ * ciphersuite. The device and the authenticator must be built with the same group.
+ */
+#ifndef PION_PAKE_SPAKE2_GROUP
+#define PION_PAKE_SPAKE2_GROUP spake2::P256
+#endif
+
+using Spake2Authenticator = spake2::Context<spake2::Role::Alice, PION_PAKE_SPAKE2_GROUP>;
+using Spake2Device = spake2::Context<spake2::Role::Bob, PION_PAKE_SPAKE2_GROUP>;
+using Spake2SharePool = spake2::SharePool<PION_PAKE_SPAKE2_GROUP>;
+
+/** @brief Deleter for an object constructed in region memory: invoke destructor only. */
+struct RegionObjectDeleter
+{
+  template<typename T>
+  void operator()(T* obj) const
+  {
+    obj->~T();
+  }
+};
+
+/** @brief Owning pointer to an object constructed in region memory. */
+template<typename T>
+using RegionPtr = std::unique_ptr<T, RegionObjectDeleter>;
 
 namespace packet_struct {
 
@@ -30,14 +62,25 @@ namespace packet_struct {
 struct PakeRequest
 {
   uint8_t spake2pa[Spake2Device::FirstMessageSize];
+  /** @brief Length of spake2pa; Spake2Device::CompressedFirstMessageSize if compressed. */
+  size_t spake2paLen = sizeof(spake2pa);
+  /** @brief Name of authenticator certificate, with implicit digest. */
   ndnph::Name authenticatorCertName;
+  /**
+   * @brief Whether to transmit only the implicit digest of authenticatorCertName.
+   *
+   * When decoded from such a message, authenticatorCertName contains only the implicit digest.
+   */
+  bool compactNames = false;
 
 #ifdef NDNPH_PRINT_OSTREAM
   friend std::ostream& operator<<(std::ostream& os, const PakeRequest& p)
   {
     os << "PakeRequest(";
     PION_PACKET_PRINT_FIELD_HEX(spake2pa);
+    os << ",spake2paLen=" << p.spake2paLen;
     os << ",authenticatorCertName=" << p.authenticatorCertName;
+    os << ",compactNames=" << p.compactNames;
     return os << ")";
   }
 #endif // NDNPH_PRINT_OSTREAM
@@ -46,6 +89,8 @@ struct PakeRequest
 struct PakeResponse
 {
   uint8_t spake2pb[Spake2Device::FirstMessageSize];
+  /** @brief Length of spake2pb; Spake2Device::CompressedFirstMessageSize if compressed. */
+  size_t spake2pbLen = sizeof(spake2pb);
   uint8_t spake2cb[Spake2Device::SecondMessageSize];
 
 #ifdef NDNPH_PRINT_OSTREAM
@@ -53,6 +98,7 @@ struct PakeResponse
   {
     os << "PakeResponse(";
     PION_PACKET_PRINT_FIELD_HEX(spake2pb);
+    os << ",spake2pbLen=" << p.spake2pbLen;
     os << ",";
     PION_PACKET_PRINT_FIELD_HEX(spake2cb);
     return os << ")";
@@ -62,21 +108,37 @@ struct PakeResponse
 
 struct ConfirmRequest
 {
-  uint8_t spake2ca[Spake2Device::SecondMessageSize];
+  /** @brief View of the SPAKE2 confirmation MAC, which is consumed before the packet is gone. */
+  ndnph::tlv::Value spake2ca;
   ndnph::tlv::Value nc;
   ndnph::Name caProfileName;
   ndnph::Name deviceName;
   uint64_t timestamp;
+  /** @brief Name of authenticator certificate, without implicit digest; only with compactNames. */
+  ndnph::Name authenticatorCertName;
+  /**
+   * @brief Whether to transmit caProfileName and authenticatorCertName as NameRef relative to
+   *        deviceName.
+   */
+  bool compactNames = false;
+  /** @brief Encoded CA profile Data; empty if it is not embedded. */
+  ndnph::tlv::Value caProfile;
+  /** @brief Encoded authenticator certificate Data; empty if it is not embedded. */
+  ndnph::tlv::Value authenticatorCert;
 
 #ifdef NDNPH_PRINT_OSTREAM
   friend std::ostream& operator<<(std::ostream& os, const ConfirmRequest& p)
   {
     os << "ConfirmRequest(";
-    PION_PACKET_PRINT_FIELD_HEX(spake2ca);
+    os << "spake2ca.size=" << p.spake2ca.size();
     os << ",nc.size=" << p.nc.size();
     os << ",caProfileName=" << p.caProfileName;
     os << ",deviceName=" << p.deviceName;
     os << ",timestamp=" << p.timestamp;
+    os << ",authenticatorCertName=" << p.authenticatorCertName;
+    os << ",compactNames=" << p.compactNames;
+    os << ",caProfile.size=" << p.caProfile.size();
+    os << ",authenticatorCert.size=" << p.authenticatorCert.size();
     return os << ")";
   }
 #endif // NDNPH_PRINT_OSTREAM
@@ -99,12 +161,20 @@ struct ConfirmResponse
 struct CredentialRequest
 {
   ndnph::Name tempCertName;
+  /** @brief Name of the certificate request in Message 4, base of compact tempCertName. */
+  ndnph::Name tempCertReqName;
+  /** @brief Whether to transmit tempCertName as NameRef relative to tempCertReqName. */
+  bool compactNames = false;
+  /** @brief Encoded issued certificate Data; empty if it is not embedded. */
+  ndnph::tlv::Value tempCert;
 
 #ifdef NDNPH_PRINT_OSTREAM
   friend std::ostream& operator<<(std::ostream& os, const CredentialRequest& p)
   {
     os << "CredentialRequest(";
     os << "tempCertName=" << p.tempCertName;
+    os << ",compactNames=" << p.compactNames;
+    os << ",tempCert.size=" << p.tempCert.size();
     return os << ")";
   }
 #endif // NDNPH_PRINT_OSTREAM
@@ -125,16 +195,384 @@ struct CredentialResponse
 
 } // namespace packet_struct
 
-using AesGcm = ndnph::mbedtls::AesGcm<Spake2Device::SharedKeySize * 8>;
+namespace detail {
+
+/**
+ * @brief IV construction and checking shared by the AEAD ciphers.
+ *
+ * Each IV consists of an 8-octet random prefix chosen at reset() and a 4-octet counter that
+ * advances by the number of 16-octet blocks in each encrypted message, as recommended by
+ * NDNCERT. A received IV is acceptable if its prefix differs from ours, equals the prefix of
+ * earlier messages from the peer, and its counter does not go back.
+ */
+class AeadIv
+{
+public:
+  using IvLen = std::integral_constant<size_t, 12>;
+
+  /**
+   * @brief Choose a new prefix and forget the peer.
+   * @return whether success.
+   */
+  bool reset();
+
+  /**
+   * @brief Write the IV for an outgoing message of @p len octets.
+   * @return whether success; false if the counter would overflow.
+   */
+  bool next(uint8_t iv[IvLen::value], size_t len);
+
+  /** @brief Determine whether an incoming IV is acceptable. */
+  bool check(const uint8_t iv[IvLen::value]) const;
+
+  /** @brief Record an incoming IV after its message of @p len octets has been authenticated. */
+  void accept(const uint8_t iv[IvLen::value], size_t len);
+
+private:
+  enum
+  {
+    PrefixLen = 8,
+  };
+
+  std::array<uint8_t, PrefixLen> m_prefix{};
+  uint64_t m_counter = 0;
+  std::array<uint8_t, PrefixLen> m_peerPrefix{};
+  uint64_t m_peerCounter = 0; // lowest acceptable peer counter
+  bool m_hasPeer = false;
+};
+
+} // namespace detail
+
+/** @brief AES-128-GCM encryption context that encrypts and decrypts in place. */
+class AesGcm
+{
+public:
+  using Key = std::array<uint8_t, Spake2Device::SharedKeySize>;
+  using IvLen = detail::AeadIv::IvLen;
+  using TagLen = std::integral_constant<size_t, 16>;
+
+  /**
+   * @brief Import the key and choose the IV prefix.
+   * @return whether success.
+   */
+  bool import(const Key& key);
+
+  /**
+   * @brief Encrypt @p buf in place.
+   * @param[out] iv the IV.
+   * @param[out] tag the authentication tag.
+   * @return whether success.
+   */
+  bool encrypt(uint8_t iv[IvLen::value], uint8_t tag[TagLen::value], uint8_t* buf, size_t len,
+               const uint8_t* aad, size_t aadLen);
+
+  /**
+   * @brief Decrypt @p buf in place.
+   * @return whether the IV is acceptable and authentication succeeds.
+   */
+  bool decrypt(const uint8_t iv[IvLen::value], const uint8_t tag[TagLen::value], uint8_t* buf,
+               size_t len, const uint8_t* aad, size_t aadLen);
+
+private:
+  spake2::mbed::Object<mbedtls_gcm_context, mbedtls_gcm_init, mbedtls_gcm_free> m_gcm;
+  detail::AeadIv m_iv;
+};
+
+#ifdef MBEDTLS_CHACHAPOLY_C
+/**
+ * @brief ChaCha20-Poly1305 encryption context that encrypts and decrypts in place.
+ *
+ * It is faster than AES-GCM in software, on devices without AES acceleration. The 256-bit key is
+ * expanded from the 128-bit SPAKE2 shared key with HKDF-SHA256. IVs are constructed in the same
+ * way as AesGcm.
+ */
+class ChaChaPoly
+{
+public:
+  using Key = std::array<uint8_t, Spake2Device::SharedKeySize>;
+  using IvLen = detail::AeadIv::IvLen;
+  using TagLen = std::integral_constant<size_t, 16>;
+
+  /** @copydoc AesGcm::import */
+  bool import(const Key& key);
+
+  /** @copydoc AesGcm::encrypt */
+  bool encrypt(uint8_t iv[IvLen::value], uint8_t tag[TagLen::value], uint8_t* buf, size_t len,
+               const uint8_t* aad, size_t aadLen);
+
+  /** @copydoc AesGcm::decrypt */
+  bool decrypt(const uint8_t iv[IvLen::value], const uint8_t tag[TagLen::value], uint8_t* buf,
+               size_t len, const uint8_t* aad, size_t aadLen);
+
+private:
+  spake2::mbed::Object<mbedtls_chachapoly_context, mbedtls_chachapoly_init,
+                       mbedtls_chachapoly_free>
+    m_ctx;
+  detail::AeadIv m_iv;
+};
+#endif // MBEDTLS_CHACHAPOLY_C
+
+/**
+ * @brief AEAD cipher for encrypted PAKE messages.
+ *
+ * NDNCERT messages are encrypted by NDNph with AES-GCM regardless of this setting.
+ * Define this macro to ChaChaPoly to select ChaCha20-Poly1305, which requires mbedtls to be built
+ * with MBEDTLS_CHACHAPOLY_C. The device and the authenticator must be built with the same cipher.
+ */
+#ifndef PION_PAKE_AEAD
+#define PION_PAKE_AEAD AesGcm
+#endif
+
+using Aead = PION_PAKE_AEAD;
 
 using Encrypted =
-  ndnph::EncryptedMessage<TT::InitializationVector, AesGcm::IvLen::value, TT::AuthenticationTag,
-                          AesGcm::TagLen::value, TT::EncryptedPayload>;
+  ndnph::EncryptedMessage<TT::InitializationVector, Aead::IvLen::value, TT::AuthenticationTag,
+                          Aead::TagLen::value, TT::EncryptedPayload>;
+
+/**
+ * @brief Name referenced relative to a base name known to both parties.
+ *
+ * The TLV-VALUE is one octet for the number of leading components taken from the base name,
+ * followed by the remaining name components. It shortens names that share a prefix with a name
+ * exchanged earlier in the session, such as a CA profile under the device's name prefix.
+ */
+class NameRef
+{
+public:
+  /** @brief Reference @p name relative to @p base , eliding their longest common prefix. */
+  explicit NameRef(const ndnph::Name& base, const ndnph::Name& name);
+
+  /** @brief Return TLV-VALUE length. */
+  size_t length() const
+  {
+    return 1 + m_suffix.length();
+  }
+
+  /**
+   * @brief Write a TLV element.
+   * @return whether success.
+   */
+  bool writeTo(schema::Writer& writer, uint32_t type) const;
+
+  /**
+   * @brief Reconstruct a name from the TLV-VALUE of a reference.
+   * @return the name allocated from @p region ; empty name if the reference is invalid.
+   */
+  static ndnph::Name resolve(ndnph::Region& region, const ndnph::Name& base,
+                             ndnph::tlv::Value value);
+
+private:
+  uint8_t m_prefixLen = 0;
+  ndnph::Name m_suffix;
+};
+
+/** @brief TLV schema of PAKE messages, see schema namespace. */
+namespace packet_schema {
+
+using EncryptedMessage = schema::EncryptedMessage<Aead::IvLen::value, Aead::TagLen::value>;
+
+/**
+ * @brief Message 1: Spake2PA or Spake2PACompressed, AuthenticatorCertName or
+ *        AuthenticatorCertDigest.
+ */
+struct PakeRequest
+{
+  using Spake2PA =
+    schema::Octets<TT::Spake2PA, Spake2Device::FirstMessageSize, TT::Spake2PACompressed,
+                   Spake2Device::CompressedFirstMessageSize>;
+  using AuthenticatorCertName = schema::Bytes<TT::AuthenticatorCertName>;
+  using AuthenticatorCertDigest = schema::Octets<TT::AuthenticatorCertDigest, NDNPH_SHA256_LEN>;
+
+  static constexpr size_t size(size_t spake2paLen, size_t certNameLen)
+  {
+    return Spake2PA::size(spake2paLen) + AuthenticatorCertName::size(certNameLen);
+  }
+
+  static constexpr size_t compactSize(size_t spake2paLen)
+  {
+    return Spake2PA::size(spake2paLen) + AuthenticatorCertDigest::MaxSize;
+  }
+};
+
+/** @brief Message 2: Spake2PB or Spake2PBCompressed, Spake2CB. */
+struct PakeResponse
+{
+  using Spake2PB =
+    schema::Octets<TT::Spake2PB, Spake2Device::FirstMessageSize, TT::Spake2PBCompressed,
+                   Spake2Device::CompressedFirstMessageSize>;
+  using Spake2CB = schema::Octets<TT::Spake2CB, Spake2Device::SecondMessageSize>;
+
+  enum : size_t
+  {
+    MaxSize = Spake2PB::MaxSize + Spake2CB::MaxSize,
+  };
+
+  static constexpr size_t size(size_t spake2pbLen)
+  {
+    return Spake2PB::size(spake2pbLen) + Spake2CB::MaxSize;
+  }
+};
+
+/**
+ * @brief Message 3: Spake2CA, encrypted message.
+ *
+ * Plaintext: Nc, CaProfileName, DeviceName, timestamp name component.
+ * Compact plaintext: Nc, CaProfileNameRef, DeviceName, AuthenticatorCertNameRef, timestamp name
+ * component.
+ * Either may be followed by EmbeddedCaProfile and EmbeddedAuthenticatorCert.
+ */
+struct ConfirmRequest
+{
+  using Spake2CA = schema::Octets<TT::Spake2CA, Spake2Device::SecondMessageSize>;
+  using Nc = schema::Bytes<TT::Nc>;
+  using CaProfileName = schema::Bytes<TT::CaProfileName>;
+  using CaProfileNameRef = schema::Bytes<TT::CaProfileNameRef>;
+  using DeviceName = schema::Bytes<TT::DeviceName>;
+  using AuthenticatorCertNameRef = schema::Bytes<TT::AuthenticatorCertNameRef>;
+  using EmbeddedCaProfile = schema::Bytes<TT::EmbeddedCaProfile>;
+  using EmbeddedAuthenticatorCert = schema::Bytes<TT::EmbeddedAuthenticatorCert>;
+
+  static size_t plaintextSize(const ndnph::tlv::Value& nc, const ndnph::Name& caProfileName,
+                              const ndnph::Name& deviceName, const ndnph::Component& timestamp)
+  {
+    return Nc::size(nc.size()) + CaProfileName::size(caProfileName.length()) +
+           DeviceName::size(deviceName.length()) +
+           schema::tlvSize(timestamp.type(), timestamp.length());
+  }
+
+  static size_t compactPlaintextSize(const ndnph::tlv::Value& nc, const NameRef& caProfileName,
+                                     const ndnph::Name& deviceName,
+                                     const NameRef& authenticatorCertName,
+                                     const ndnph::Component& timestamp)
+  {
+    return Nc::size(nc.size()) + CaProfileNameRef::size(caProfileName.length()) +
+           DeviceName::size(deviceName.length()) +
+           AuthenticatorCertNameRef::size(authenticatorCertName.length()) +
+           schema::tlvSize(timestamp.type(), timestamp.length());
+  }
+
+  static constexpr size_t size(size_t plaintextLen)
+  {
+    return Spake2CA::MaxSize + EncryptedMessage::size(plaintextLen);
+  }
+};
+
+/** @brief Message 4: encrypted message; plaintext is TReq. */
+using ConfirmResponse = EncryptedMessage;
+
+/**
+ * @brief Message 5: encrypted message.
+ *
+ * Plaintext: IssuedCertName or IssuedCertNameRef, optionally followed by EmbeddedIssuedCert.
+ */
+struct CredentialRequest
+{
+  using IssuedCertName = schema::Bytes<TT::IssuedCertName>;
+  using IssuedCertNameRef = schema::Bytes<TT::IssuedCertNameRef>;
+  using EmbeddedIssuedCert = schema::Bytes<TT::EmbeddedIssuedCert>;
+
+  static constexpr size_t plaintextSize(size_t issuedCertNameLen)
+  {
+    return IssuedCertName::size(issuedCertNameLen);
+  }
+
+  static size_t compactPlaintextSize(const NameRef& issuedCertName)
+  {
+    return IssuedCertNameRef::size(issuedCertName.length());
+  }
+
+  static constexpr size_t size(size_t plaintextLen)
+  {
+    return EncryptedMessage::size(plaintextLen);
+  }
+};
+
+/**
+ * @brief Maximum encoded size of Message 3 and Message 5 parameters with embedded packets.
+ *
+ * The authenticator clamps its embed limit to this, and the device decodes such messages in an
+ * EmbedRegion.
+ */
+enum : size_t
+{
+  MaxEmbedLimit = 1792,
+};
+
+} // namespace packet_schema
+
+/**
+ * @brief Region for a decrypted Message 3 or Message 5 and the packets embedded in it.
+ *
+ * Besides the plaintext, it has room for decoded Data objects, their full names, and names
+ * resolved from NameRef.
+ */
+using EmbedRegion = ndnph::StaticRegion<packet_schema::MaxEmbedLimit + 1024>;
+
+/** @brief Data packet with its pre-encoded wire and full name. */
+struct EncodedData
+{
+  /**
+   * @brief Encode @p packet in @p region and compute its full name.
+   * @tparam Packet ndnph::Data or ndnph::Data::Signed.
+   * @return whether success.
+   */
+  template<typename Packet>
+  bool build(ndnph::Region& region, const Packet& packet)
+  {
+    ndnph::Encoder encoder(region);
+    encoder.prepend(packet);
+    if (!encoder) {
+      encoder.discard();
+      return false;
+    }
+    encoder.trim();
+    return decode(region, ndnph::tlv::Value(encoder));
+  }
+
+  /**
+   * @brief Decode from @p input wire encoding in @p region and compute its full name.
+   * @return whether success.
+   */
+  bool decode(ndnph::Region& region, ndnph::tlv::Value input);
+
+  /**
+   * @brief Determine whether @p interest can be satisfied by this packet.
+   *
+   * An Interest whose name ends with an implicit digest is compared with the full name, without
+   * recomputing the digest.
+   */
+  bool match(const ndnph::Interest& interest) const;
+
+  explicit operator bool() const
+  {
+    return wire.size() > 0;
+  }
+
+  ndnph::Data data;
+  ndnph::tlv::Value wire;
+  ndnph::Name fullName;
+};
+
+/**
+ * @brief Decode a packet embedded in Message 3 or Message 5.
+ * @return the packet if it is present and its full name is @p fullName .
+ */
+ndnph::Data
+decodeEmbedded(ndnph::Region& region, ndnph::tlv::Value wire, const ndnph::Name& fullName);
 
 /** @brief Session ID and encryption context. */
 class EncryptSession
 {
 public:
+  EncryptSession() = default;
+  EncryptSession(const EncryptSession&) = delete;
+  EncryptSession& operator=(const EncryptSession&) = delete;
+
+  ~EncryptSession()
+  {
+    clearKey();
+  }
+
   /** @brief Clear state. */
   void end();
 
@@ -150,39 +588,145 @@ public:
    */
   bool assign(ndnph::Region& region, ndnph::Name name);
 
-  /** @brief Construct Interest name. */
+  /**
+   * @brief Construct Interest name.
+   *
+   * Names with the pake, confirm, and credential verbs are prepared in @c begin and returned
+   * without allocating from @p region .
+   */
   ndnph::Name makeName(ndnph::Region& region, const ndnph::Component& verb);
 
   /**
-   * @brief Import AES-GCM key.
+   * @brief Import AEAD key.
+   * @return whether success.
+   *
+   * The AEAD context is constructed in storage within this object, replacing any previous one.
+   */
+  bool importKey(const Aead::Key& key)
+  {
+    clearKey();
+    aead = new (&m_aeadStorage) Aead();
+    return aead->import(key);
+  }
+
+  /**
+   * @brief Encrypt a message and prepend it to @p encoder .
+   * @param arg arguments to @c Encoder::prepend function, which form the plaintext.
    * @return whether success.
+   *
+   * The plaintext is encoded into @p encoder and encrypted where it is, then the EncryptedPayload
+   * TLV-TYPE and TLV-LENGTH, AuthenticationTag, and InitializationVector are prepended in front
+   * of it. Thus, the encrypted message needs no memory besides the final packet buffer. On
+   * failure, no plaintext is left in the buffer of @p encoder .
    */
-  bool importKey(const AesGcm::Key& key)
+  template<typename... Arg>
+  bool encrypt(ndnph::Encoder& encoder, const Arg&... arg)
   {
-    aes.reset(new AesGcm());
-    return aes->import(key);
+    if (aead == nullptr) {
+      encoder.setError();
+      return false;
+    }
+
+    size_t sizeBefore = encoder.size();
+    encoder.prepend(arg...);
+    if (!encoder) {
+      return false;
+    }
+
+    // Encoder writes into its own buffer, so that the plaintext may be overwritten
+    uint8_t* buf = const_cast<uint8_t*>(encoder.begin());
+    size_t len = encoder.size() - sizeBefore;
+    uint8_t iv[Aead::IvLen::value];
+    uint8_t tag[Aead::TagLen::value];
+    if (!aead->encrypt(iv, tag, buf, len, ss.value(), ss.length())) {
+      mbedtls_platform_zeroize(buf, len);
+      encoder.setError();
+      return false;
+    }
+
+    encoder.prependTypeLength(TT::EncryptedPayload, len);
+    encoder.prependTlv(TT::AuthenticationTag, ndnph::tlv::Value(tag, sizeof(tag)));
+    encoder.prependTlv(TT::InitializationVector, ndnph::tlv::Value(iv, sizeof(iv)));
+    return !!encoder;
   }
 
   /**
-   * @brief Encrypt a message.
+   * @brief Encrypt a message of known size into @p writer .
+   * @param plaintextLen exact plaintext length.
+   * @param writePlaintext function that writes the plaintext into a given schema::Writer and
+   *                       returns whether success.
+   * @return whether success.
+   *
+   * The InitializationVector, AuthenticationTag, and EncryptedPayload are laid out in
+   * @p writer first, then the plaintext is written into the EncryptedPayload and encrypted
+   * where it is. On failure, the EncryptedPayload is erased, so that no plaintext is left in
+   * @p writer , but @p writer may still finish; the caller must not send its content.
+   */
+  template<typename Fn>
+  bool encrypt(schema::Writer& writer, size_t plaintextLen, const Fn& writePlaintext)
+  {
+    uint8_t* iv = writer.writeTypeLength(TT::InitializationVector, Aead::IvLen::value);
+    uint8_t* tag = writer.writeTypeLength(TT::AuthenticationTag, Aead::TagLen::value);
+    uint8_t* buf = writer.writeTypeLength(TT::EncryptedPayload, plaintextLen);
+    if (buf == nullptr || aead == nullptr) {
+      return false;
+    }
+
+    schema::Writer inner(buf, plaintextLen);
+    if (writePlaintext(inner) && !!inner.finish() &&
+        aead->encrypt(iv, tag, buf, plaintextLen, ss.value(), ss.length())) {
+      return true;
+    }
+    mbedtls_platform_zeroize(buf, plaintextLen);
+    return false;
+  }
+
+  /**
+   * @brief Encrypt a message into a new buffer.
    * @param region where to allocate memory.
    * @param arg arguments to @c Encoder::prepend function.
-   * @return encrypted-message structure.
+   * @return encrypted-message TLVs.
    */
   template<typename... Arg>
   ndnph::tlv::Value encrypt(ndnph::Region& region, const Arg&... arg)
   {
-    ndnph::Encoder inner(region);
-    inner.prepend(arg...);
-    inner.trim();
-    return aes->encrypt<Encrypted>(region, ndnph::tlv::Value(inner), ss.value(), ss.length());
+    ndnph::Encoder encoder(region);
+    if (!encrypt(encoder, arg...)) {
+      encoder.discard();
+      return ndnph::tlv::Value();
+    }
+    encoder.trim();
+    return ndnph::tlv::Value(encoder);
   }
 
+  /**
+   * @brief Decrypt a message into a new buffer.
+   * @param region where to allocate memory for the plaintext.
+   * @return plaintext, or an empty value on failure.
+   *
+   * The received packet buffer is not modified, so that a message that fails authentication
+   * leaves the packet intact.
+   */
   ndnph::tlv::Value decrypt(ndnph::Region& region, const Encrypted& encrypted);
 
+private:
+  /** @brief Destroy the AEAD context, which wipes its key. */
+  void clearKey()
+  {
+    if (aead != nullptr) {
+      aead->~Aead();
+      aead = nullptr;
+    }
+  }
+
 public:
   ndnph::Component ss;
-  std::unique_ptr<AesGcm> aes;
+  /** @brief AEAD context after importKey(), or nullptr. */
+  Aead* aead = nullptr;
+
+private:
+  std::aligned_storage<sizeof(Aead), alignof(Aead)>::type m_aeadStorage;
+  std::array<ndnph::Name, 3> m_names;
 };
 
 ndnph::Name
@@ -191,8 +735,82 @@ computeTempSubjectName(ndnph::Region& region, ndnph::Name authenticatorCertName,
 
 using TempCertValidity = std::integral_constant<int, 300>;
 
+/** @brief Maximum InterestLifetime, which is also the maximum retransmission timeout. */
 using InterestLifetime = std::integral_constant<int, 10000>;
 
+/**
+ * @brief Allowance added to the InterestLifetime of Message 3.
+ *
+ * The device replies only after it has fetched the CA profile and the authenticator certificate
+ * and generated the certificate request, which is not part of the round-trip time.
+ */
+using ConfirmProcessingTime = std::integral_constant<int, 2000>;
+
+/**
+ * @brief Time limit of the direct connection part of the protocol.
+ *
+ * It starts when the authenticator begins a session, or when the device receives Message 1.
+ */
+using SessionTimeout = std::integral_constant<int, 30000>;
+
+/**
+ * @brief Per-session RTT estimator and retransmission timer.
+ *
+ * SRTT, RTTVAR, and the retransmission timeout (RTO) are computed as in RFC 6298. Each Interest
+ * carries RTO as its InterestLifetime. When it expires, RTO is doubled and the same Interest is
+ * retransmitted, until SessionTimeout is reached. Following Karn's algorithm, the reply to a
+ * retransmitted Interest is not taken as an RTT sample. Neither is the reply to an Interest with
+ * a processing allowance, because it includes the processing time of the peer.
+ */
+class RttEstimator
+{
+public:
+  enum
+  {
+    InitialRto = 1000,
+    MinRto = 200,
+    MaxRto = InterestLifetime::value,
+  };
+
+  /** @brief Start a session, discarding previous samples. */
+  void begin();
+
+  /**
+   * @brief Record transmission of a new Interest.
+   * @param allowance time for the peer to process the Interest before replying, in milliseconds,
+   *                  added to the InterestLifetime of this Interest and its retransmissions.
+   * @return InterestLifetime; 0 if the session has timed out.
+   */
+  uint16_t onRequest(int allowance = 0);
+
+  /**
+   * @brief Back off after an Interest has expired.
+   * @return InterestLifetime of the retransmission; 0 if the session has timed out.
+   */
+  uint16_t onTimeout();
+
+  /** @brief Record arrival of the reply. */
+  void onReply();
+
+private:
+  uint16_t computeLifetime() const;
+
+private:
+  ndnph::port::Clock::Time m_deadline{};
+  ndnph::port::Clock::Time m_sentAt{};
+  int m_srtt = -1; // no sample yet
+  int m_rttvar = 0;
+  int m_rto = InitialRto;
+  int m_allowance = 0;
+  bool m_sampling = false;
+};
+
+/**
+ * @brief Amount of SPAKE2 computation performed in each loop() iteration.
+ * @sa spake2::Context::step
+ */
+using Spake2StepBudget = std::integral_constant<int, 1000>;
+
 } // namespace pake
 } // namespace pion
 
@@ -0,0 +1,201 @@
+#ifndef PION_PAKE_SCHEMA_HPP
+#define PION_PAKE_SCHEMA_HPP
+
+#include "an.hpp"
+
+namespace pion {
+namespace pake {
+
+/**
+ * @brief Declarative TLV schema for PION messages.
+ *
+ * A message schema lists its fields as types. Each field knows its encoded size, so that the
+ * size of a message is known before encoding: at compile time if every field has a fixed length,
+ * otherwise from the lengths of its variable fields. Writer then encodes the message in one
+ * forward pass into a buffer of exactly that size.
+ */
+namespace schema {
+
+constexpr size_t
+max(size_t a, size_t b)
+{
+  return a < b ? b : a;
+}
+
+/** @brief Return the encoded size of a TLV-TYPE or TLV-LENGTH number. */
+constexpr size_t
+varNumSize(uint64_t n)
+{
+  return n < 0xFD ? 1 : n <= 0xFFFF ? 3 : n <= 0xFFFFFFFF ? 5 : 9;
+}
+
+/** @brief Return the encoded size of a TLV element. */
+constexpr size_t
+tlvSize(uint32_t type, size_t length)
+{
+  return varNumSize(type) + varNumSize(length) + length;
+}
+
+/**
+ * @brief Field whose TLV-VALUE has a fixed length.
+ * @tparam Type TLV-TYPE.
+ * @tparam Length TLV-VALUE length.
+ * @tparam AltType TLV-TYPE of an alternate encoding, such as a compressed point.
+ * @tparam AltLength TLV-VALUE length of the alternate encoding.
+ */
+template<uint32_t Type, size_t Length, uint32_t AltType = Type, size_t AltLength = Length>
+struct Octets
+{
+  enum : size_t
+  {
+    MaxSize = max(tlvSize(Type, Length), tlvSize(AltType, AltLength)),
+  };
+
+  /** @brief Return TLV-TYPE for a TLV-VALUE length; 0 if the length is not allowed. */
+  static constexpr uint32_t typeOf(size_t length)
+  {
+    return length == Length ? Type : length == AltLength ? AltType : 0;
+  }
+
+  /** @brief Determine whether a decoded TLV element matches this field. */
+  static constexpr bool accepts(uint32_t type, size_t length)
+  {
+    return typeOf(length) == type && type != 0;
+  }
+
+  /** @brief Return the encoded size with a TLV-VALUE length. */
+  static constexpr size_t size(size_t length)
+  {
+    return tlvSize(typeOf(length), length);
+  }
+};
+
+/** @brief Field whose TLV-VALUE has a variable length, such as a name. */
+template<uint32_t Type>
+struct Bytes
+{
+  /** @brief Return the encoded size with a TLV-VALUE length. */
+  static constexpr size_t size(size_t length)
+  {
+    return tlvSize(Type, length);
+  }
+};
+
+/**
+ * @brief Encrypted message: InitializationVector, AuthenticationTag, EncryptedPayload.
+ * @tparam IvLen IV length.
+ * @tparam TagLen authentication tag length.
+ */
+template<size_t IvLen, size_t TagLen>
+struct EncryptedMessage
+{
+  using InitializationVector = Octets<TT::InitializationVector, IvLen>;
+  using AuthenticationTag = Octets<TT::AuthenticationTag, TagLen>;
+  using EncryptedPayload = Bytes<TT::EncryptedPayload>;
+
+  /** @brief Return the encoded size with a plaintext length. */
+  static constexpr size_t size(size_t plaintextLen)
+  {
+    return InitializationVector::MaxSize + AuthenticationTag::MaxSize +
+           EncryptedPayload::size(plaintextLen);
+  }
+};
+
+/** @brief Single-pass forward TLV writer into a buffer of exact size. */
+class Writer
+{
+public:
+  /** @brief Write into a caller-provided buffer of exactly @p size octets. */
+  explicit Writer(uint8_t* buf, size_t size)
+    : m_begin(buf)
+    , m_pos(buf)
+    , m_end(buf == nullptr ? nullptr : buf + size)
+  {}
+
+  /** @brief Allocate exactly @p size octets from @p region . */
+  explicit Writer(ndnph::Region& region, size_t size)
+    : Writer(region.alloc(size), size)
+  {}
+
+  /**
+   * @brief Write TLV-TYPE and TLV-LENGTH.
+   * @return where TLV-VALUE should be written; nullptr if the buffer is too small.
+   */
+  uint8_t* writeTypeLength(uint32_t type, size_t length)
+  {
+    if (m_pos == nullptr || tlvSize(type, length) > static_cast<size_t>(m_end - m_pos)) {
+      m_pos = nullptr;
+      return nullptr;
+    }
+    writeVarNum(type);
+    writeVarNum(length);
+    uint8_t* value = m_pos;
+    m_pos += length;
+    return value;
+  }
+
+  /** @brief Write a TLV element. */
+  bool write(uint32_t type, const uint8_t* value, size_t length)
+  {
+    uint8_t* room = writeTypeLength(type, length);
+    if (room == nullptr) {
+      return false;
+    }
+    std::copy_n(value, length, room);
+    return true;
+  }
+
+  /** @brief Write a TLV element that contains a name. */
+  bool write(uint32_t type, const ndnph::Name& name)
+  {
+    return write(type, name.value(), name.length());
+  }
+
+  /** @brief Write a name component. */
+  bool write(const ndnph::Component& comp)
+  {
+    return write(comp.type(), comp.value(), comp.length());
+  }
+
+  /** @brief Return the encoded buffer; empty if it is not filled exactly. */
+  ndnph::tlv::Value finish() const
+  {
+    if (m_pos == nullptr || m_pos != m_end) {
+      return ndnph::tlv::Value();
+    }
+    return ndnph::tlv::Value(m_begin, static_cast<size_t>(m_end - m_begin));
+  }
+
+private:
+  void writeVarNum(uint64_t n)
+  {
+    switch (varNumSize(n)) {
+      case 1:
+        *m_pos++ = static_cast<uint8_t>(n);
+        return;
+      case 3:
+        *m_pos++ = 0xFD;
+        break;
+      case 5:
+        *m_pos++ = 0xFE;
+        break;
+      default:
+        *m_pos++ = 0xFF;
+        break;
+    }
+    for (int shift = 8 * (static_cast<int>(varNumSize(n)) - 2); shift >= 0; shift -= 8) {
+      *m_pos++ = static_cast<uint8_t>(n >> shift);
+    }
+  }
+
+private:
+  uint8_t* m_begin;
+  uint8_t* m_pos;
+  uint8_t* m_end;
+};
+
+} // namespace schema
+} // namespace pake
+} // namespace pion
+
+#endif // PION_PAKE_SCHEMA_HPP
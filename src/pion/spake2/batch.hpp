@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: NIST-PD
+
+#ifndef PION_SPAKE2_BATCH_HPP
+#define PION_SPAKE2_BATCH_HPP
+
+#include "p256-multi.hpp"
+#include "spake2.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace spake2 {
+
+/**
+ * @brief Batched processing of SPAKE2 messages for many concurrent executions.
+ *
+ * An authenticator serving many devices can queue the incoming public shares and process them
+ * together. Each item is processed exactly as the single-context method would, so the results
+ * are bit-identical, and a failure of one item does not affect the others.
+ *
+ * With P256 on a CPU that supports the multi-buffer backend (see p256-multi.hpp), the variable
+ * base multiplications K = x * Y of all items run in parallel lanes. Otherwise, they run one by
+ * one in the backend of the group. Either way, the conversion of K to affine coordinates for
+ * encoding shares one field inversion among a chunk of items (Montgomery's trick), where the
+ * backend works in projective coordinates.
+ */
+template<Role role, typename Group = P256, typename Hash = SHA256, size_t MaxInputLen = 64>
+class Batch
+{
+public:
+  using ContextType = Context<role, Group, Hash, MaxInputLen>;
+
+  /**
+   * @brief Invoke ContextType::processFirstMessage on @p n contexts.
+   * @param ctx array of contexts.
+   * @param inMsg array of incoming public shares, one per context.
+   * @param inMsgLen array of public share lengths.
+   * @param[out] ok array of per-context results.
+   * @return number of successfully processed contexts.
+   */
+  static size_t processFirstMessage(ContextType* const ctx[], const uint8_t* const inMsg[],
+                                    const size_t inMsgLen[], bool ok[], size_t n) noexcept
+  {
+    if (n >= 2 && p256_multi::isAvailable()) {
+      processMulti(ctx, inMsg, inMsgLen, ok, n, std::is_same<Group, P256>());
+    } else {
+      processShared(ctx, inMsg, inMsgLen, ok, n);
+    }
+
+    size_t nOk = 0;
+    for (size_t i = 0; i < n; ++i) {
+      nOk += ok[i] ? 1 : 0;
+    }
+    return nOk;
+  }
+
+private:
+  using Backend = typename ContextType::Backend;
+  using Point = typename Backend::Point;
+
+  static void processMulti(ContextType* const ctx[], const uint8_t* const inMsg[],
+                           const size_t inMsgLen[], bool ok[], size_t n, std::false_type) noexcept
+  {
+    processShared(ctx, inMsg, inMsgLen, ok, n);
+  }
+
+  /** @brief Compute K in the backend of each context, then encode all K together. */
+  static void processShared(ContextType* const ctx[], const uint8_t* const inMsg[],
+                            const size_t inMsgLen[], bool ok[], size_t n) noexcept
+  {
+    std::vector<Point> K(n);
+    std::vector<size_t> index;
+    index.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      ContextType& c = *ctx[i];
+      ok[i] = false;
+      if (c.m_state != ContextType::State::AwaitingPublicShare || !c.m_bound) {
+        continue;
+      }
+      if (inMsgLen[i] != ContextType::FirstMessageSize) {
+        // compressed share: the transcript needs its uncompressed form
+        ok[i] = c.processFirstMessage(inMsg[i], inMsgLen[i]);
+        continue;
+      }
+
+      Point Y;
+      // K = h * x * Y
+      if (c.computeY(inMsg[i], inMsgLen[i], Y) &&
+          c.m_backend.mul(K[index.size()], c.m_x, Y, mbedtls_hmac_drbg_random, c.m_drbg)) {
+        index.push_back(i);
+      }
+    }
+
+    size_t m = index.size();
+    std::vector<std::array<uint8_t, Group::UncompressedPointSize>> binK(m);
+    std::vector<uint8_t*> out(m);
+    std::vector<size_t> lenK(m);
+    for (size_t j = 0; j < m; ++j) {
+      out[j] = binK[j].data();
+    }
+    Backend backend;
+    bool writeOk = backend.writePoints(out.data(), lenK.data(), K.data(), m);
+
+    for (size_t j = 0; j < m; ++j) {
+      size_t i = index[j];
+      ok[i] = writeOk && ctx[i]->finishFirstMessage(inMsg[i], inMsgLen[i], out[j], lenK[j]);
+    }
+  }
+
+  static void processMulti(ContextType* const ctx[], const uint8_t* const inMsg[],
+                           const size_t inMsgLen[], bool ok[], size_t n, std::true_type) noexcept
+  {
+    using Item = std::array<uint8_t, Group::ScalarSize + 2 * Group::UncompressedPointSize>;
+    std::vector<Item> items;
+    std::vector<size_t> index;
+    items.reserve(n);
+    index.reserve(n);
+
+    // Compute Y of each item; items with Y at infinity are finished by the single-context path
+    for (size_t i = 0; i < n; ++i) {
+      ContextType& c = *ctx[i];
+      ok[i] = false;
+      if (c.m_state != ContextType::State::AwaitingPublicShare || !c.m_bound) {
+        continue;
+      }
+      if (inMsgLen[i] != ContextType::FirstMessageSize) {
+        // compressed share: the transcript needs its uncompressed form
+        ok[i] = c.processFirstMessage(inMsg[i], inMsgLen[i]);
+        continue;
+      }
+
+      Point Y;
+      if (!c.computeY(inMsg[i], inMsgLen[i], Y)) {
+        continue;
+      }
+      if (c.m_backend.isZero(Y) || c.m_backend.isZero(c.m_x)) {
+        ok[i] = finishSingle(c, Y, inMsg[i], inMsgLen[i]);
+        continue;
+      }
+
+      Item item{};
+      size_t lenY = 0;
+      if (!c.m_backend.writeScalar(item.data(), c.m_x) ||
+          !c.m_backend.writePoint(&item[Group::ScalarSize], &lenY, Y)) {
+        ok[i] = finishSingle(c, Y, inMsg[i], inMsgLen[i]);
+        continue;
+      }
+      items.push_back(item);
+      index.push_back(i);
+    }
+
+    // K = x * Y
+    size_t m = items.size();
+    std::vector<const uint8_t*> x(m), Y(m);
+    std::vector<uint8_t*> K(m);
+    for (size_t j = 0; j < m; ++j) {
+      x[j] = &items[j][0];
+      Y[j] = &items[j][Group::ScalarSize];
+      K[j] = &items[j][Group::ScalarSize + Group::UncompressedPointSize];
+    }
+    bool multiOk = p256_multi::mul(m, x.data(), Y.data(), K.data());
+
+    for (size_t j = 0; j < m; ++j) {
+      size_t i = index[j];
+      ContextType& c = *ctx[i];
+      if (multiOk) {
+        ok[i] = c.finishFirstMessage(inMsg[i], inMsgLen[i], K[j], Group::UncompressedPointSize);
+        continue;
+      }
+
+      // not expected for valid inputs; recompute K with the context's backend
+      Point Yj;
+      ok[i] = c.m_backend.readPoint(Yj, Y[j], Group::UncompressedPointSize) &&
+              finishSingle(c, Yj, inMsg[i], inMsgLen[i]);
+    }
+  }
+
+  static bool finishSingle(ContextType& c, const Point& Y, const uint8_t* inMsg,
+                           size_t inMsgLen) noexcept
+  {
+    std::array<uint8_t, Group::UncompressedPointSize> binK{};
+    size_t lenK = 0;
+    return c.computeK(Y, binK.data(), &lenK) &&
+           c.finishFirstMessage(inMsg, inMsgLen, binK.data(), lenK);
+  }
+};
+
+} // namespace spake2
+
+#endif // PION_SPAKE2_BATCH_HPP
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: NIST-PD
+
+#ifndef PION_SPAKE2_DRBG_HPP
+#define PION_SPAKE2_DRBG_HPP
+
+#include "mbedtls-wrappers.hpp"
+
+#include <mbedtls/hmac_drbg.h>
+
+namespace spake2 {
+
+/**
+ * @brief HMAC_DRBG that SPAKE2 contexts borrow random numbers from.
+ *
+ * It is seeded once from its entropy source, and reseeded from the same source after every
+ * @c reseedInterval requests. A Drbg is not thread-safe: each thread should use its own
+ * instance, such as the one returned by forThread().
+ */
+class Drbg
+{
+public:
+  enum
+  {
+    DefaultReseedInterval = 1024,
+  };
+
+  /**
+   * @brief Constructor.
+   * @param entropyCtx entropy source; it must outlive this object.
+   * @param reseedInterval number of requests between reseeds.
+   */
+  explicit Drbg(mbedtls_entropy_context* entropyCtx,
+                int reseedInterval = DefaultReseedInterval) noexcept
+    : Drbg(mbedtls_entropy_func, entropyCtx, reseedInterval)
+  {
+    assert(entropyCtx != nullptr);
+  }
+
+  /**
+   * @brief Constructor with a custom entropy function.
+   * @param f_entropy entropy function, in the same form as @c mbedtls_entropy_func .
+   * @param p_entropy entropy function context; it must outlive this object.
+   * @param reseedInterval number of requests between reseeds.
+   *
+   * A deterministic entropy function makes the output reproducible, which is useful in
+   * benchmarks but must not be used in production.
+   */
+  explicit Drbg(int (*f_entropy)(void*, unsigned char*, size_t), void* p_entropy,
+                int reseedInterval = DefaultReseedInterval) noexcept
+  {
+    auto mdInfo = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    assert(mdInfo != nullptr);
+
+    int ret = mbedtls_hmac_drbg_seed(m_drbg, mdInfo, f_entropy, p_entropy, nullptr, 0);
+    assert(ret == 0);
+    (void)ret;
+
+    mbedtls_hmac_drbg_set_reseed_interval(m_drbg, reseedInterval);
+  }
+
+  Drbg(const Drbg&) = delete;
+  Drbg& operator=(const Drbg&) = delete;
+
+  /**
+   * @brief Return the Drbg of the calling thread.
+   *
+   * It is created on first use with its own entropy source, and destroyed when the thread exits.
+   */
+  static Drbg& forThread() noexcept;
+
+  operator mbedtls_hmac_drbg_context*() noexcept
+  {
+    return m_drbg;
+  }
+
+private:
+  mbed::Object<mbedtls_hmac_drbg_context, mbedtls_hmac_drbg_init, mbedtls_hmac_drbg_free> m_drbg;
+};
+
+} // namespace spake2
+
+#endif // PION_SPAKE2_DRBG_HPP
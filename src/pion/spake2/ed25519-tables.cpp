@@ -0,0 +1,416 @@
+// SPDX-License-Identifier: NIST-PD
+// Generated by mk/spake2-native-tables.py ed25519, do not edit.
+
+#include "ed25519.hpp"
+
+#if defined(__SIZEOF_INT128__)
+#define PION_LIMB(lo, hi) ((static_cast<limbs::Limb>(hi) << 32) | (lo))
+#else
+#define PION_LIMB(lo, hi) (lo), (hi)
+#endif
+
+namespace spake2 {
+namespace ed25519 {
+
+// clang-format off
+const Point combTables[3][16] = {
+  // G
+  {
+    { { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } } },
+    { { { PION_LIMB(0x8F25D51A, 0xC9562D60), PION_LIMB(0x9525A7B2, 0x692CC760),
+          PION_LIMB(0xFDD6DC5C, 0xC0A4E231), PION_LIMB(0xCD6E53FE, 0x216936D3) } },
+      { { PION_LIMB(0x66666658, 0x66666666), PION_LIMB(0x66666666, 0x66666666),
+          PION_LIMB(0x66666666, 0x66666666), PION_LIMB(0x66666666, 0x66666666) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xA5B7DDA3, 0x6DDE8AB3), PION_LIMB(0x775152F5, 0x20F09F80),
+          PION_LIMB(0x64ABE37D, 0x66EA4E8E), PION_LIMB(0xD78B7665, 0x67875F0F) } } },
+    { { { PION_LIMB(0xF4EDA202, 0x3E0B6B8F), PION_LIMB(0xD51A35EB, 0x0078DB7E),
+          PION_LIMB(0xB4A08A96, 0xD44B60CF), PION_LIMB(0xBF2DF9D5, 0x6222BD88) } },
+      { { PION_LIMB(0x82E45313, 0x8F1EFA57), PION_LIMB(0xBA902B06, 0x5410B608),
+          PION_LIMB(0x261B7C4F, 0xDD6BDAED), PION_LIMB(0xEA4ED025, 0x0325BB42) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xB6740859, 0x2DFD92E9), PION_LIMB(0x9CC4BF86, 0x3B0ABE0E),
+          PION_LIMB(0x40094560, 0xC79980E6), PION_LIMB(0xC7D3AE0A, 0x628B09E2) } } },
+    { { { PION_LIMB(0x61CCFBA2, 0x1A700667), PION_LIMB(0xFF3A78C4, 0x2CDD6232),
+          PION_LIMB(0x3B1950AB, 0xB87D9BF2), PION_LIMB(0x9C294FFD, 0x0EBA91A7) } },
+      { { PION_LIMB(0xFE515E46, 0xE5E5BF1D), PION_LIMB(0x670D959B, 0x5AB5D1F8),
+          PION_LIMB(0xC32C93A1, 0x85970EDE), PION_LIMB(0xABEA7F2D, 0x1830473E) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x82DFFB70, 0xFDD346F6), PION_LIMB(0x3FFD32B5, 0x69A10996),
+          PION_LIMB(0xA2112525, 0x0752B8D9), PION_LIMB(0xCE400AF3, 0x38CD1113) } } },
+    { { { PION_LIMB(0x60B7E824, 0xFC8047AE), PION_LIMB(0xC2E723E5, 0x98E685C9),
+          PION_LIMB(0xE14E29A0, 0x952D3984), PION_LIMB(0x3C45F32C, 0x4C27AFFF) } },
+      { { PION_LIMB(0x4BF5A66B, 0x5BBABD11), PION_LIMB(0x51A4C49E, 0x90D0BE1E),
+          PION_LIMB(0x26C29C3A, 0x95F11EB6), PION_LIMB(0x526DC87D, 0x5F2C99E6) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x46F1338A, 0xE9E731C9), PION_LIMB(0x6663ADA9, 0x14786482),
+          PION_LIMB(0x07924B6A, 0xD4E15600), PION_LIMB(0x0BF4602F, 0x05A164FD) } } },
+    { { { PION_LIMB(0x680C969A, 0xFBE2FD29), PION_LIMB(0x31ECBCE6, 0xB0E6EC08),
+          PION_LIMB(0x8CC36053, 0x8AB3C1BE), PION_LIMB(0x2B88E48F, 0x6E64E555) } },
+      { { PION_LIMB(0x7BAFD09B, 0x25352A64), PION_LIMB(0x9EC55210, 0x36391158),
+          PION_LIMB(0x39B85145, 0x6A9DFC93), PION_LIMB(0xA4CB58BE, 0x383C510F) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x814683A9, 0xA138B0BC), PION_LIMB(0x783B8D60, 0x43FE5278),
+          PION_LIMB(0xA9B93591, 0x57BF2EB8), PION_LIMB(0x5104D8F9, 0x475C61F8) } } },
+    { { { PION_LIMB(0x43ABCA05, 0x8BF30E63), PION_LIMB(0x9BF8A641, 0x53807053),
+          PION_LIMB(0xE38F5E86, 0xC8180DC3), PION_LIMB(0xD81F344B, 0x6DF2BC1D) } },
+      { { PION_LIMB(0xDFBE3A34, 0x89F3F6D9), PION_LIMB(0x9F94E1A1, 0xE95D4C5D),
+          PION_LIMB(0xEF9249A1, 0x8981530E), PION_LIMB(0x37A68758, 0x6062DDF1) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x5A25F8B2, 0x93CED87B), PION_LIMB(0xD848FC92, 0xF7E588D0),
+          PION_LIMB(0xBEF719EC, 0xE6D770E8), PION_LIMB(0x25B2CB8A, 0x507C0226) } } },
+    { { { PION_LIMB(0x1B9D5A63, 0x527DC68C), PION_LIMB(0x6A0970EA, 0x73F332E1),
+          PION_LIMB(0x7B071F21, 0xD8499B7C), PION_LIMB(0x7225F3C0, 0x31ED9D6F) } },
+      { { PION_LIMB(0x54363667, 0xE6719240), PION_LIMB(0xAD112811, 0x7B853293),
+          PION_LIMB(0x493BB73E, 0xB0071C13), PION_LIMB(0xFDAA932E, 0x3D4728FD) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x2865FB39, 0x703BCDDE), PION_LIMB(0xE8F44232, 0x0F574737),
+          PION_LIMB(0x0BAF8FB7, 0xC1B485C5), PION_LIMB(0x8E2EA5C4, 0x4E602BAF) } } },
+    { { { PION_LIMB(0xC7DAD28D, 0xDB7AD644), PION_LIMB(0xB81D7D26, 0x7A9DDEE1),
+          PION_LIMB(0x1C7E177D, 0x2D8D0437), PION_LIMB(0x38185E7C, 0x1BC7AF1E) } },
+      { { PION_LIMB(0x00314833, 0xCAF2F659), PION_LIMB(0x631B270F, 0x1D027E12),
+          PION_LIMB(0x795DC049, 0x7A5EEF87), PION_LIMB(0x55661F2F, 0x61D909D8) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x6636C2C7, 0x51B84521), PION_LIMB(0x56DE7EF8, 0x9BB8F236),
+          PION_LIMB(0x4B1F0FBD, 0xCCB664DE), PION_LIMB(0x54B8FA44, 0x1A340B80) } } },
+    { { { PION_LIMB(0x07B06838, 0x85CCFCA3), PION_LIMB(0x654C7F10, 0xFAFAB365),
+          PION_LIMB(0xDB6F53A5, 0x46564C74), PION_LIMB(0x7AD5E203, 0x02C61C29) } },
+      { { PION_LIMB(0x04F259BC, 0x84C06375), PION_LIMB(0x671C602F, 0x8663FD76),
+          PION_LIMB(0xDCBFFAF3, 0x91902DD2), PION_LIMB(0xE5A933BD, 0x42DA0C66) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x0C62D525, 0x10A39D3A), PION_LIMB(0xD20A1CA4, 0x18DA8620),
+          PION_LIMB(0x61E14F1C, 0x3775E5BD), PION_LIMB(0xFE2A7A47, 0x1000B139) } } },
+    { { { PION_LIMB(0x66F4CA27, 0x1492ECC2), PION_LIMB(0xD0630657, 0xEB06154D),
+          PION_LIMB(0x774F5869, 0xF0C78BC5), PION_LIMB(0xA064ED8E, 0x71663CB3) } },
+      { { PION_LIMB(0x0ADA2DC6, 0x2770FE0D), PION_LIMB(0xFA27F864, 0xA5305FF6),
+          PION_LIMB(0xF2DA6C0D, 0x47785E62), PION_LIMB(0x1C0066D3, 0x5D1F56FD) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x857246F5, 0x5DAA6B49), PION_LIMB(0x35DC5FB7, 0xBBEDF373),
+          PION_LIMB(0xBC0941F9, 0x6FE384E6), PION_LIMB(0xDA39A2EC, 0x496C664D) } } },
+    { { { PION_LIMB(0x4CF46F3F, 0x270EFDD8), PION_LIMB(0xBC2B5CC9, 0x23E7A4C0),
+          PION_LIMB(0x319F0229, 0x96D7E9D6), PION_LIMB(0x0B5EE0F4, 0x3CEE130E) } },
+      { { PION_LIMB(0x3DF2ED09, 0xA4C39176), PION_LIMB(0x87D4AE97, 0x18F65DD0),
+          PION_LIMB(0x671D1F47, 0xA063CFF2), PION_LIMB(0x93F82791, 0x3F237545) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x7C932898, 0x8A144393), PION_LIMB(0x80145B2B, 0xE368F6C5),
+          PION_LIMB(0x2CE7E6E9, 0x437F5BC6), PION_LIMB(0x391C3F9A, 0x7508F66C) } } },
+    { { { PION_LIMB(0x23ADF1D1, 0x969364DD), PION_LIMB(0xF77F7041, 0xA289A9F5),
+          PION_LIMB(0x1B8DB034, 0x491519AE), PION_LIMB(0x876D2358, 0x76814F15) } },
+      { { PION_LIMB(0xEAB523FB, 0x8D54ACCF), PION_LIMB(0xEB2F424E, 0x68DB630F),
+          PION_LIMB(0x8BCFA837, 0x6EA4F5AB), PION_LIMB(0xD6B22A96, 0x0DBD9EBE) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xFDC53B75, 0x7CAF4939), PION_LIMB(0xD4939CF1, 0x74952AD4),
+          PION_LIMB(0x8E613432, 0x231C8937), PION_LIMB(0x4D47018E, 0x3E24E5A8) } } },
+    { { { PION_LIMB(0xCFA942B4, 0x178A8301), PION_LIMB(0xC6C47647, 0x0B950483),
+          PION_LIMB(0x62C911FC, 0x84760CB8), PION_LIMB(0xFA37B9D9, 0x6DC27CFC) } },
+      { { PION_LIMB(0x04B33E58, 0x488F8CBB), PION_LIMB(0xCC2791BC, 0x1922B7F9),
+          PION_LIMB(0xB5092E83, 0x1C54D972), PION_LIMB(0x0BEAA14D, 0x7208C6F1) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x40A20B6B, 0xF6948EDA), PION_LIMB(0x14425500, 0xB877862F),
+          PION_LIMB(0x68DA1F1B, 0x88AD21D8), PION_LIMB(0x31EB33FA, 0x56BC37C1) } } },
+    { { { PION_LIMB(0x6E7A8746, 0x8A0A5680), PION_LIMB(0x6B11DDC0, 0xDF47DDD6),
+          PION_LIMB(0xEAD8D910, 0x038FB07C), PION_LIMB(0x8FC12E00, 0x30D3A844) } },
+      { { PION_LIMB(0xF9A28906, 0x03DCAD34), PION_LIMB(0xA751ED85, 0x5DE79C82),
+          PION_LIMB(0x320C9352, 0xAAE15B9A), PION_LIMB(0x6D02B8CA, 0x3AB1D43A) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x6D080106, 0x53D91C4B), PION_LIMB(0x5505C291, 0x2DEBE8AD),
+          PION_LIMB(0x11801164, 0x3840D793), PION_LIMB(0x8206F111, 0x4EE2D2CB) } } },
+    { { { PION_LIMB(0xB5BE5FF0, 0x386B100D), PION_LIMB(0x8076AC32, 0x7194CABD),
+          PION_LIMB(0x35C9F27A, 0x429FDE2A), PION_LIMB(0xAB011849, 0x647CEFBC) } },
+      { { PION_LIMB(0x923D583F, 0xDB13DB59), PION_LIMB(0xE00A6E58, 0x084A91B7),
+          PION_LIMB(0x3C2ED620, 0x178BC945), PION_LIMB(0x90C7E779, 0x25183A99) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xD8EC9FEF, 0x788943D9), PION_LIMB(0x054B27A2, 0x30C27D3B),
+          PION_LIMB(0x5318621A, 0xF89147B9), PION_LIMB(0x5F4C090A, 0x0410E27A) } } },
+  },
+  // M
+  {
+    { { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } } },
+    { { { PION_LIMB(0x477E45E7, 0x1BBD6949), PION_LIMB(0x982C1C35, 0x37B3F303),
+          PION_LIMB(0xDAA539DE, 0xACA42EC0), PION_LIMB(0xFC26087D, 0x1209A780) } },
+      { { PION_LIMB(0x2C0348D0, 0xD6B6A06E), PION_LIMB(0xE8C2DD97, 0xA385DA6B),
+          PION_LIMB(0x20C9DA3A, 0xE118BFF1), PION_LIMB(0x66D1C6B0, 0x2FCDCEA5) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x8FBFB0AA, 0x38A28D83), PION_LIMB(0x6B5F5043, 0x238B2504),
+          PION_LIMB(0x83FFE553, 0x9D1ED000), PION_LIMB(0xE8519E32, 0x05EDE9BD) } } },
+    { { { PION_LIMB(0xC34EA880, 0x3B68AE81), PION_LIMB(0x3256DB0D, 0xA097A82F),
+          PION_LIMB(0xCBC1155C, 0xC55F7A6F), PION_LIMB(0x1749FB32, 0x0885FA18) } },
+      { { PION_LIMB(0x11E3F185, 0x20703D8E), PION_LIMB(0x170C4E38, 0xD220A8A1),
+          PION_LIMB(0x8D051DB1, 0x1896C90F), PION_LIMB(0x8F898C9D, 0x6E6C6A46) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x73336107, 0xE70DCB46), PION_LIMB(0x8BB814CE, 0x51E7653D),
+          PION_LIMB(0x4BC07297, 0xC1228B73), PION_LIMB(0x617EC330, 0x2858EA4F) } } },
+    { { { PION_LIMB(0x75B20372, 0x60A9D887), PION_LIMB(0x668B2B93, 0x98CEAFEE),
+          PION_LIMB(0x6A7C6BCD, 0x66DA19BE), PION_LIMB(0xA053DA7C, 0x530E9AE3) } },
+      { { PION_LIMB(0x4A737C3A, 0x2353A637), PION_LIMB(0x8ACE3167, 0x7672EEAB),
+          PION_LIMB(0x4254B5C2, 0x53C74BCF), PION_LIMB(0x76AF5924, 0x257E1053) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xB2824C41, 0xBD3B2F44), PION_LIMB(0x37AB56D9, 0x70AB2CD3),
+          PION_LIMB(0x12DA7BAD, 0x261840A7), PION_LIMB(0x4FB42537, 0x53D12892) } } },
+    { { { PION_LIMB(0xA6235C94, 0x14EA055E), PION_LIMB(0x50CE2BAD, 0x887AB377),
+          PION_LIMB(0x0474F74C, 0x9E0CA435), PION_LIMB(0x3C4C6AEE, 0x4D356AC1) } },
+      { { PION_LIMB(0x95948F6D, 0x46CA10E4), PION_LIMB(0x4038FA4E, 0x5A1B1AEB),
+          PION_LIMB(0xE94D73FF, 0xF589BEF2), PION_LIMB(0x1AD072D1, 0x1908827B) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xE95C7458, 0x75CF1969), PION_LIMB(0xF04CD35A, 0x569DB893),
+          PION_LIMB(0x1E7BD829, 0xC895A8FC), PION_LIMB(0xEFC773E4, 0x35DE1CA1) } } },
+    { { { PION_LIMB(0xA54454DA, 0x1C10D83D), PION_LIMB(0x54C73BCF, 0x2AD711D5),
+          PION_LIMB(0x58A63F69, 0xB290FD74), PION_LIMB(0xF30EC2F4, 0x7C518F19) } },
+      { { PION_LIMB(0x61791231, 0x2F2FB416), PION_LIMB(0xF29788D0, 0xA3A68CC3),
+          PION_LIMB(0x127EFF29, 0x099C2A46), PION_LIMB(0x07875F7C, 0x579AA16B) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x3FD4BB7F, 0xEFCFADB2), PION_LIMB(0x8B9B18D5, 0xC09AB9AF),
+          PION_LIMB(0x9D438059, 0x67D1AFB2), PION_LIMB(0x7801285C, 0x1F81AE67) } } },
+    { { { PION_LIMB(0x56B08E55, 0x5B4CC95D), PION_LIMB(0x8ED0D3AE, 0xE8BAACB8),
+          PION_LIMB(0x14304554, 0xC42059F6), PION_LIMB(0x5D7AB703, 0x28CB5A6B) } },
+      { { PION_LIMB(0x61EFF860, 0xF56B7860), PION_LIMB(0xC2754B21, 0x380EBA77),
+          PION_LIMB(0xB7FBE098, 0x0487755F), PION_LIMB(0x095CB40C, 0x4E380004) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x620651F7, 0x26BFC569), PION_LIMB(0x2D6EA6D3, 0x1E123E27),
+          PION_LIMB(0x318E4189, 0x6D58979D), PION_LIMB(0x429363AD, 0x7EA422A2) } } },
+    { { { PION_LIMB(0xE5737B4F, 0xF4F1DBDB), PION_LIMB(0xFD68645C, 0x89E886B1),
+          PION_LIMB(0x96D49CBE, 0x5CDCCB1D), PION_LIMB(0x2833D4EF, 0x3BAFB6B9) } },
+      { { PION_LIMB(0xBA308DCF, 0x84CF08E8), PION_LIMB(0x9B1061BA, 0x7918F662),
+          PION_LIMB(0x7C828766, 0xD0AC71AA), PION_LIMB(0x54B032D0, 0x3FADA403) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xABA1C94C, 0x68026B23), PION_LIMB(0x29A9FE7F, 0x33BBC4D6),
+          PION_LIMB(0x01865D96, 0x20856D76), PION_LIMB(0x0FBFB6DF, 0x3B0B9CB1) } } },
+    { { { PION_LIMB(0xFF22CA72, 0x36088701), PION_LIMB(0x18AA2261, 0xF2BC3AAB),
+          PION_LIMB(0x99E10578, 0xCC9859A3), PION_LIMB(0x512BC621, 0x460A436D) } },
+      { { PION_LIMB(0x7E11AE50, 0xEF5623D5), PION_LIMB(0x42BFC883, 0x1F5245F0),
+          PION_LIMB(0xB02FBC34, 0xECF0CEF0), PION_LIMB(0x2E5999D0, 0x1EA8AB1F) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x705DC7AD, 0xF89F0F46), PION_LIMB(0x4374D681, 0x206ED9DB),
+          PION_LIMB(0x7BEFF7A8, 0x599078E1), PION_LIMB(0x5ECBBCD3, 0x115E56A3) } } },
+    { { { PION_LIMB(0x9A1BCE4B, 0x71C4C675), PION_LIMB(0xEC8DF086, 0x62B930B0),
+          PION_LIMB(0x96DDB7B3, 0xE9BFC829), PION_LIMB(0x7B7874B0, 0x14A3EAF7) } },
+      { { PION_LIMB(0xF3E05612, 0x4A267A35), PION_LIMB(0x13DFE64C, 0x2AB052B5),
+          PION_LIMB(0x34AC2E5F, 0x011A5FAB), PION_LIMB(0xD11A15E4, 0x0A95C9BF) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x05FE2943, 0x52C1893C), PION_LIMB(0x3F879753, 0x8DA8115E),
+          PION_LIMB(0x2584B42D, 0x4113F293), PION_LIMB(0xAF3D76FF, 0x488F30DC) } } },
+    { { { PION_LIMB(0x53E71DAC, 0x21C38D59), PION_LIMB(0x97125E78, 0xF91D4E8F),
+          PION_LIMB(0xC4C2E2E5, 0x9650FBBA), PION_LIMB(0xF7E8435B, 0x58641B0D) } },
+      { { PION_LIMB(0x7F95D3BE, 0x3585F18E), PION_LIMB(0x2E5525BA, 0xAD5C4602),
+          PION_LIMB(0xCC03C51F, 0xF24C43D0), PION_LIMB(0x890A645E, 0x7D23FDD9) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xFBBBA504, 0x495F2A7B), PION_LIMB(0x09746AFF, 0x5CA8FB83),
+          PION_LIMB(0x8530DC45, 0xA1979901), PION_LIMB(0x157747C2, 0x112DD333) } } },
+    { { { PION_LIMB(0x0F2FBE4F, 0xD94A121E), PION_LIMB(0x8FDE82F8, 0x90B9984F),
+          PION_LIMB(0x11D1FAF6, 0x327EDCA6), PION_LIMB(0x148A6A48, 0x6CB9735E) } },
+      { { PION_LIMB(0xCCF9C20E, 0xB5C832F0), PION_LIMB(0xD25DAA56, 0x336FF107),
+          PION_LIMB(0x4970056F, 0x23234960), PION_LIMB(0x584C0E14, 0x50A9AD92) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x662AA30F, 0x3A435A51), PION_LIMB(0x292B3AD8, 0x5805A581),
+          PION_LIMB(0x2C6A4051, 0x6B6DCB81), PION_LIMB(0x585311AE, 0x546A066A) } } },
+    { { { PION_LIMB(0x964359B1, 0x4551C17B), PION_LIMB(0xD1EF0DEF, 0xDFCED0E4),
+          PION_LIMB(0xBF1BBC6A, 0x474E877A), PION_LIMB(0x38349C17, 0x04A13CB0) } },
+      { { PION_LIMB(0xCE66E2FB, 0xADBB82B6), PION_LIMB(0x35128EC3, 0x01CE17BC),
+          PION_LIMB(0xB9A6A32D, 0x2FC284FA), PION_LIMB(0x4C8C4A5A, 0x14A84E11) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x2806CA6D, 0xA054712B), PION_LIMB(0x4FF7BE14, 0xC6391646),
+          PION_LIMB(0xEAFFDEF5, 0x9AD22DCD), PION_LIMB(0x9D6B6BCE, 0x52730B8E) } } },
+    { { { PION_LIMB(0xAA99B8CB, 0xC9A08C2E), PION_LIMB(0x842A625F, 0x7E0A6066),
+          PION_LIMB(0x451793DC, 0x4C93B319), PION_LIMB(0x5CD5D0DC, 0x4ECDD225) } },
+      { { PION_LIMB(0xB3734C84, 0x0522A490), PION_LIMB(0x2B397C2C, 0x7661D970),
+          PION_LIMB(0xE97103B2, 0x8557F80E), PION_LIMB(0x342FB1AD, 0x0FB066A5) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x6F373469, 0xED2BF9FB), PION_LIMB(0x82621C04, 0xD84BA894),
+          PION_LIMB(0x663E65AF, 0xC28D0D3F), PION_LIMB(0x4DA43ED4, 0x22F0525A) } } },
+    { { { PION_LIMB(0x266E9475, 0xE2B49979), PION_LIMB(0xDD58A3E2, 0xF474FBB4),
+          PION_LIMB(0x30C3CAA1, 0xA2B286E7), PION_LIMB(0x58C9112C, 0x5FA6C1E3) } },
+      { { PION_LIMB(0x75E76A86, 0x9563D8D5), PION_LIMB(0xB8BC5964, 0xE312F5B7),
+          PION_LIMB(0xEA17C603, 0x4CEECB4E), PION_LIMB(0x33D103AE, 0x003639D0) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xEA20EA2D, 0x39575B73), PION_LIMB(0x8B4C7EBB, 0x925CB975),
+          PION_LIMB(0x8E1BD92C, 0xF840E03A), PION_LIMB(0xC1F15659, 0x1C107B84) } } },
+    { { { PION_LIMB(0xBD9CF40F, 0x0DFD9635), PION_LIMB(0xF49EB726, 0xF14B6F4B),
+          PION_LIMB(0x160011EC, 0x43D41E21), PION_LIMB(0xFA4A8C23, 0x362BD49E) } },
+      { { PION_LIMB(0x581E439A, 0x831FE831), PION_LIMB(0x68312015, 0xD8D327FE),
+          PION_LIMB(0x8F81439B, 0xE6143257), PION_LIMB(0xFBD1BF9E, 0x527AADDF) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xE8A99496, 0xCAF7CB85), PION_LIMB(0x2689E6B7, 0xF9313ED5),
+          PION_LIMB(0x0211C462, 0xA4030B99), PION_LIMB(0x5428414B, 0x01683FCC) } } },
+  },
+  // N
+  {
+    { { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } } },
+    { { { PION_LIMB(0x6C27FC23, 0x9CB3AF55), PION_LIMB(0x0D3A99D8, 0xEBC9087F),
+          PION_LIMB(0x99906E4D, 0x2B153C2F), PION_LIMB(0xF20F5A89, 0x17BFE667) } },
+      { { PION_LIMB(0x18B5BFD3, 0x30344FF4), PION_LIMB(0x920C9DF2, 0x653850AF),
+          PION_LIMB(0x8132EDA1, 0x5DB369DC), PION_LIMB(0x85BA68D8, 0x2BC486F8) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xFDEF36A4, 0x448D3B50), PION_LIMB(0x72500242, 0x1256B304),
+          PION_LIMB(0x81EDB1FA, 0xD97AC8B8), PION_LIMB(0x9042C5A1, 0x1F5CEFC4) } } },
+    { { { PION_LIMB(0x99B19353, 0xB0CA3090), PION_LIMB(0x4C14EABD, 0x1E812B6F),
+          PION_LIMB(0x32B24523, 0xB8E62D2E), PION_LIMB(0x9115C55D, 0x5B183963) } },
+      { { PION_LIMB(0xF49B6362, 0xA234E08B), PION_LIMB(0x68921195, 0x91F3B754),
+          PION_LIMB(0x08AD22CA, 0xF0A29CD8), PION_LIMB(0x842C9CDC, 0x17E02632) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x434FED67, 0x63D4E335), PION_LIMB(0xACBDFEC0, 0x6F186A4A),
+          PION_LIMB(0xFD86CA1D, 0x3FCC3256), PION_LIMB(0xEE0B974F, 0x1043CF3F) } } },
+    { { { PION_LIMB(0xFD6B5389, 0xEA259776), PION_LIMB(0x29F89499, 0xC053C47C),
+          PION_LIMB(0xDC209A98, 0xAA500170), PION_LIMB(0x5040A305, 0x19308766) } },
+      { { PION_LIMB(0x2DB8C312, 0x487B8B28), PION_LIMB(0x45AB7BF7, 0x85BB2E70),
+          PION_LIMB(0x35DD6CC1, 0x13208300), PION_LIMB(0xA3AA0882, 0x27CA0F03) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x0BC03868, 0x73B3D309), PION_LIMB(0x3CB8B71D, 0x8F261235),
+          PION_LIMB(0x2E215B79, 0x4A41E67B), PION_LIMB(0x7E5F0890, 0x1B62A754) } } },
+    { { { PION_LIMB(0xC2528B3E, 0x228CB1D7), PION_LIMB(0xF24A04FE, 0x2EEEACE8),
+          PION_LIMB(0x493477D7, 0x8CEBE9F2), PION_LIMB(0xCDC6C8A6, 0x5D7C8F8A) } },
+      { { PION_LIMB(0x6FFAC851, 0x71DB93B3), PION_LIMB(0xA76E3EEF, 0x3ED4C785),
+          PION_LIMB(0xAAC0E2A2, 0x7CA4B317), PION_LIMB(0x7A7C3FC2, 0x3EDE26DD) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xD7A5571E, 0x098585E9), PION_LIMB(0x8BA237EA, 0x79EB63D6),
+          PION_LIMB(0x5A07FCAA, 0x54E3D3E9), PION_LIMB(0x62B56910, 0x738BD557) } } },
+    { { { PION_LIMB(0xF70699F1, 0x20C91B69), PION_LIMB(0x7A864F55, 0xE9688993),
+          PION_LIMB(0x08BC2D2B, 0x0B2D5D15), PION_LIMB(0xD4B31A4F, 0x2A79778E) } },
+      { { PION_LIMB(0x46B6F925, 0xA60287FB), PION_LIMB(0x84BAD3E0, 0xA5583EEA),
+          PION_LIMB(0x398C8F7F, 0xCFB52879), PION_LIMB(0xDC63CAE4, 0x744BEDAC) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xD47E24D6, 0x120C3A74), PION_LIMB(0x1AE10ACE, 0xA8F26764),
+          PION_LIMB(0xD452AC5E, 0x368C864F), PION_LIMB(0x2169245A, 0x359533F3) } } },
+    { { { PION_LIMB(0x8C85941E, 0x6F76F4E5), PION_LIMB(0xD88B6720, 0x2DE74BD6),
+          PION_LIMB(0x1FCCBDA0, 0xA29C46DF), PION_LIMB(0x24DF6449, 0x45111100) } },
+      { { PION_LIMB(0x8AD75C62, 0x9BF50200), PION_LIMB(0xC542534F, 0x738055D5),
+          PION_LIMB(0x5A315B9A, 0xE9433ABD), PION_LIMB(0x1DAFE533, 0x37595E92) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x4EBDADA0, 0xC67B3101), PION_LIMB(0x3ACAB909, 0x0B71F594),
+          PION_LIMB(0xAD134D99, 0x9EDCF3B6), PION_LIMB(0x7A2DC005, 0x7C3048A6) } } },
+    { { { PION_LIMB(0x3BFA57AE, 0xA6AE31D2), PION_LIMB(0x82C1C9F9, 0x24EDA5A6),
+          PION_LIMB(0x22384B53, 0x138D85F2), PION_LIMB(0x57D65EA6, 0x3833D317) } },
+      { { PION_LIMB(0xCBD3658D, 0x2B3AA21A), PION_LIMB(0xD75361BB, 0xB620CDFF),
+          PION_LIMB(0x63AB8CBB, 0x7E26B8EF), PION_LIMB(0x90AF6581, 0x72B6D2FC) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xD81521D2, 0xFBCBDFA2), PION_LIMB(0x09C49AC6, 0xD513FE12),
+          PION_LIMB(0xB8170B5B, 0xFE5088EB), PION_LIMB(0xAF1D35CF, 0x60D2D5D8) } } },
+    { { { PION_LIMB(0x7823E9DB, 0x03C00412), PION_LIMB(0x0F7AA882, 0x7F826F48),
+          PION_LIMB(0x89A7CD81, 0x5EEA86DD), PION_LIMB(0x341450A1, 0x0F826417) } },
+      { { PION_LIMB(0x1D2040C4, 0x99FAFE8F), PION_LIMB(0x5DC15BAF, 0x540747C8),
+          PION_LIMB(0x5756224A, 0x623B2CF1), PION_LIMB(0xAF62127F, 0x1104F8FD) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x29098768, 0x61A85214), PION_LIMB(0x3A3FB709, 0xB72800B9),
+          PION_LIMB(0xB95AF272, 0x18EC3093), PION_LIMB(0xD18676AA, 0x613F45A2) } } },
+    { { { PION_LIMB(0x46F051A8, 0xFF66795D), PION_LIMB(0x54EF068A, 0x3E841B64),
+          PION_LIMB(0x19FEF341, 0x9C44F751), PION_LIMB(0x097AD316, 0x4547F559) } },
+      { { PION_LIMB(0x96EF31D0, 0xD0C0C52C), PION_LIMB(0x073FEF56, 0x4928B72B),
+          PION_LIMB(0x1842B1F5, 0x2BD877CF), PION_LIMB(0xBA807471, 0x11CE5234) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x745BB1AE, 0x5AAAE3AA), PION_LIMB(0x62A39B95, 0xDD86B5FE),
+          PION_LIMB(0x982F8CC9, 0x7721F099), PION_LIMB(0xBB72DDCB, 0x326B6912) } } },
+    { { { PION_LIMB(0xEBB9C4FE, 0x1F5EC4F9), PION_LIMB(0x144BDED3, 0xD7E76EE3),
+          PION_LIMB(0xE8985983, 0x7DD68E3D), PION_LIMB(0xB9799AC0, 0x00C1F183) } },
+      { { PION_LIMB(0x441B165D, 0x99CE02E9), PION_LIMB(0xCAEF771E, 0xB96AF0BC),
+          PION_LIMB(0xD93C3F65, 0xBF0B63E1), PION_LIMB(0x6DE6A7AA, 0x29443F6D) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x7C23A793, 0x4776FF7D), PION_LIMB(0x822A8DDB, 0xCEB0360B),
+          PION_LIMB(0xC894DE24, 0xB50191A8), PION_LIMB(0x7829D27C, 0x5EBEE839) } } },
+    { { { PION_LIMB(0xC46D8BA3, 0x5AC3A981), PION_LIMB(0x61725590, 0x3E7F2217),
+          PION_LIMB(0xB3BAFC5F, 0xE976997A), PION_LIMB(0xE8C5E520, 0x7A0F5655) } },
+      { { PION_LIMB(0xE1BCE748, 0xEF90F413), PION_LIMB(0x89026C97, 0xDA48224D),
+          PION_LIMB(0x314552D3, 0x9EE8CC26), PION_LIMB(0xE475DD5D, 0x08B1BC1D) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x3C8FDFC0, 0xFF2D6519), PION_LIMB(0xFE0A6ABF, 0x0045C621),
+          PION_LIMB(0xB6EA5548, 0xEBF5A0E0), PION_LIMB(0x1AD937BE, 0x288DAB25) } } },
+    { { { PION_LIMB(0x7054AF55, 0x50F30C0D), PION_LIMB(0xEE8340BC, 0x408B6DDC),
+          PION_LIMB(0x37186279, 0x580278C4), PION_LIMB(0x54D3787C, 0x7DBD31ED) } },
+      { { PION_LIMB(0x11B6CF48, 0x869C3727), PION_LIMB(0x7A002EF7, 0x72A61B48),
+          PION_LIMB(0x45447B70, 0xBEBF49EB), PION_LIMB(0x71667809, 0x783D7F12) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x869159F6, 0xED672B4E), PION_LIMB(0x625B1D33, 0x35103870),
+          PION_LIMB(0x49C52D6C, 0x0C5E13C9), PION_LIMB(0x2AA75192, 0x74A727D5) } } },
+    { { { PION_LIMB(0xA2822451, 0x81831EF0), PION_LIMB(0xFD534581, 0x7403F35E),
+          PION_LIMB(0xF63523BD, 0x737CDD10), PION_LIMB(0x54093246, 0x25919599) } },
+      { { PION_LIMB(0xD80932B8, 0xA350972F), PION_LIMB(0xEDB1D6F5, 0x42065197),
+          PION_LIMB(0x38690C12, 0x19D8A009), PION_LIMB(0x618FF770, 0x6643560D) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xE0343B54, 0xFEC0E06B), PION_LIMB(0x35797502, 0x9548FE89),
+          PION_LIMB(0xFBD41BBD, 0x96694937), PION_LIMB(0xDD584A27, 0x74DA3ED9) } } },
+    { { { PION_LIMB(0x0E0E8B22, 0xAC9F81F9), PION_LIMB(0x047DBF6F, 0xEBE4F213),
+          PION_LIMB(0x564EBEFD, 0x6D22E0DA), PION_LIMB(0xA5C8251B, 0x5245059C) } },
+      { { PION_LIMB(0x6BDE3A3C, 0x81F89BAC), PION_LIMB(0xAC462197, 0x49F8897E),
+          PION_LIMB(0xAC45BB58, 0x1F90C4A2), PION_LIMB(0xE0F8B4B2, 0x1C9DA1CD) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x789085B4, 0xFCF7ACBB), PION_LIMB(0x937CBAEA, 0x5D35C108),
+          PION_LIMB(0xAE24D78A, 0x8D319838), PION_LIMB(0x4EE7279B, 0x32686448) } } },
+    { { { PION_LIMB(0xFBDFF1F2, 0x41E54E88), PION_LIMB(0x07AC6ED8, 0xA6359587),
+          PION_LIMB(0x575D0812, 0x0F71AF5E), PION_LIMB(0x77814E07, 0x35B5EFF1) } },
+      { { PION_LIMB(0x4EF4FA5C, 0xFE19DC42), PION_LIMB(0x27B4D2E4, 0xB21F34FB),
+          PION_LIMB(0xCC95F26F, 0xDC6347D4), PION_LIMB(0x2B974F7E, 0x3180E07A) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0xC7846DE3, 0x1647206E), PION_LIMB(0x57A62855, 0xEB15336F),
+          PION_LIMB(0x8CC0A4B5, 0x60C731D6), PION_LIMB(0x28AFB830, 0x147DB977) } } },
+  },
+};
+// clang-format on
+
+#undef PION_LIMB
+
+} // namespace ed25519
+} // namespace spake2
@@ -0,0 +1,472 @@
+// SPDX-License-Identifier: NIST-PD
+
+#include "spake2.hpp"
+
+namespace spake2 {
+namespace ed25519 {
+namespace {
+
+using namespace limbs;
+
+#if defined(__SIZEOF_INT128__)
+#define PION_LIMB(lo, hi) ((static_cast<Limb>(hi) << 32) | (lo))
+#else
+#define PION_LIMB(lo, hi) (lo), (hi)
+#endif
+
+// clang-format off
+const Fe kP = { {
+  PION_LIMB(0xFFFFFFED, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF),
+  PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFF, 0x7FFFFFFF),
+} };
+const Scalar kL = { {
+  PION_LIMB(0x5CF5D3ED, 0x5812631A), PION_LIMB(0xA2F79CD6, 0x14DEF9DE),
+  PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x10000000),
+} };
+// curve coefficient d = -121665/121666
+const Fe kD = { {
+  PION_LIMB(0x135978A3, 0x75EB4DCA), PION_LIMB(0x4141D8AB, 0x00700A4D),
+  PION_LIMB(0x7779E898, 0x8CC74079), PION_LIMB(0x2B6FFE73, 0x52036CEE),
+} };
+const Fe kD2 = { {
+  PION_LIMB(0x26B2F159, 0xEBD69B94), PION_LIMB(0x8283B156, 0x00E0149A),
+  PION_LIMB(0xEEF3D130, 0x198E80F2), PION_LIMB(0x56DFFCE7, 0x2406D9DC),
+} };
+const Fe kSqrtM1 = { {
+  PION_LIMB(0x4A0EA0B0, 0xC4EE1B27), PION_LIMB(0xAD2FE478, 0x2F431806),
+  PION_LIMB(0x3DFBD7A7, 0x2B4D0099), PION_LIMB(0x4FC1DF0B, 0x2B832480),
+} };
+// clang-format on
+
+#undef PION_LIMB
+
+Fe
+feSmall(Limb v)
+{
+  Fe r{};
+  r[0] = v;
+  return r;
+}
+
+/** @brief Add 38 * carry into a, where 2^256 = 38 mod p. */
+void
+feFold(Fe& a, Limb carry)
+{
+  DLimb c = static_cast<DLimb>(a[0]) + static_cast<DLimb>(carry) * 38;
+  a[0] = static_cast<Limb>(c);
+  for (int i = 1; i < NLimbs; ++i) {
+    c = static_cast<DLimb>(a[i]) + (c >> LimbBits);
+    a[i] = static_cast<Limb>(c);
+  }
+  // a second carry leaves a small value that cannot overflow again
+  a[0] += static_cast<Limb>(c >> LimbBits) * 38;
+}
+
+void
+feAdd(Fe& r, const Fe& a, const Fe& b)
+{
+  DLimb c = 0;
+  for (int i = 0; i < NLimbs; ++i) {
+    c = static_cast<DLimb>(a[i]) + b[i] + (c >> LimbBits);
+    r[i] = static_cast<Limb>(c);
+  }
+  feFold(r, static_cast<Limb>(c >> LimbBits));
+}
+
+void
+feSub(Fe& r, const Fe& a, const Fe& b)
+{
+  Limb borrow = 0;
+  for (int i = 0; i < NLimbs; ++i) {
+    DLimb t = static_cast<DLimb>(a[i]) - b[i] - borrow;
+    r[i] = static_cast<Limb>(t);
+    borrow = static_cast<Limb>(t >> LimbBits) & 1;
+  }
+  // a wrap-around added 2^256, subtract 38 instead
+  DLimb t = static_cast<DLimb>(r[0]) - static_cast<DLimb>(borrow) * 38;
+  r[0] = static_cast<Limb>(t);
+  borrow = static_cast<Limb>(t >> LimbBits) & 1;
+  for (int i = 1; i < NLimbs; ++i) {
+    t = static_cast<DLimb>(r[i]) - borrow;
+    r[i] = static_cast<Limb>(t);
+    borrow = static_cast<Limb>(t >> LimbBits) & 1;
+  }
+  // a second wrap-around leaves a large value that cannot underflow again
+  r[0] -= borrow * 38;
+}
+
+void
+feMul(Fe& r, const Fe& a, const Fe& b)
+{
+  Limb t[2 * NLimbs] = {};
+  for (int i = 0; i < NLimbs; ++i) {
+    DLimb c = 0;
+    for (int j = 0; j < NLimbs; ++j) {
+      c = static_cast<DLimb>(t[i + j]) + static_cast<DLimb>(a[j]) * b[i] + (c >> LimbBits);
+      t[i + j] = static_cast<Limb>(c);
+    }
+    t[i + NLimbs] = static_cast<Limb>(c >> LimbBits);
+  }
+
+  DLimb c = 0;
+  for (int i = 0; i < NLimbs; ++i) {
+    c = static_cast<DLimb>(t[i]) + static_cast<DLimb>(t[NLimbs + i]) * 38 + (c >> LimbBits);
+    r[i] = static_cast<Limb>(c);
+  }
+  feFold(r, static_cast<Limb>(c >> LimbBits));
+}
+
+/** @brief Return the unique representative in range [0, p-1]. */
+Fe
+feFreeze(const Fe& a)
+{
+  Fe r;
+  reduceOnce(r, a, 0, kP);
+  reduceOnce(r, r, 0, kP);
+  return r;
+}
+
+bool
+feEqual(const Fe& a, const Fe& b)
+{
+  return isEqual(feFreeze(a), feFreeze(b));
+}
+
+/** @brief r = a^e; the exponent is public. */
+void
+fePow(Fe& r, const Fe& a, const Fe& e)
+{
+  Fe acc = feSmall(1);
+  for (int i = 255; i >= 0; --i) {
+    feMul(acc, acc, acc);
+    if (bit(e, i)) {
+      feMul(acc, acc, a);
+    }
+  }
+  r = acc;
+}
+
+void
+feInv(Fe& r, const Fe& a)
+{
+  Fe e = kP;
+  e[0] -= 2;
+  fePow(r, a, e);
+}
+
+void
+pointSetZero(Point& P)
+{
+  P.X.fill(0);
+  P.Y = feSmall(1);
+  P.Z = feSmall(1);
+  P.T.fill(0);
+}
+
+/** @brief Doubling for a = -1 (dbl-2008-hwcd). */
+void
+pointDbl(Point& R, const Point& P)
+{
+  Fe A, B, C, E, F, G, H;
+  feMul(A, P.X, P.X);
+  feMul(B, P.Y, P.Y);
+  feMul(C, P.Z, P.Z);
+  feAdd(C, C, C);
+  feAdd(H, A, B);
+  feAdd(E, P.X, P.Y);
+  feMul(E, E, E);
+  feSub(E, H, E);
+  feSub(G, A, B);
+  feAdd(F, C, G);
+  feMul(R.X, E, F);
+  feMul(R.Y, G, H);
+  feMul(R.T, E, H);
+  feMul(R.Z, F, G);
+}
+
+/** @brief r = table[index], reading every entry. */
+void
+pointSelect(Point& r, const Point table[16], unsigned index)
+{
+  r = Point{};
+  for (unsigned j = 0; j < 16; ++j) {
+    Limb mask = ~maskNonZero(j ^ index);
+    for (int i = 0; i < NLimbs; ++i) {
+      r.X[i] |= table[j].X[i] & mask;
+      r.Y[i] |= table[j].Y[i] & mask;
+      r.Z[i] |= table[j].Z[i] & mask;
+      r.T[i] |= table[j].T[i] & mask;
+    }
+  }
+}
+
+/** @brief Encode P in the 32-octet encoding of RFC 8032, given zInv = 1/Z. */
+void
+writeAffine(uint8_t output[32], size_t* len, const Point& P, const Fe& zInv)
+{
+  Fe x, y;
+  feMul(x, P.X, zInv);
+  feMul(y, P.Y, zInv);
+  x = feFreeze(x);
+  y = feFreeze(y);
+  y[NLimbs - 1] |= static_cast<Limb>(bit(x, 0)) << (LimbBits - 1);
+  toBytesLE(output, y);
+  *len = 32;
+}
+
+/** @brief Return column i of the comb, i.e. bits i, 64+i, 128+i, 192+i of k. */
+unsigned
+combDigit(const Scalar& k, int i)
+{
+  return bit(k, i) | (bit(k, 64 + i) << 1) | (bit(k, 128 + i) << 2) | (bit(k, 192 + i) << 3);
+}
+
+} // namespace
+
+void
+scalarReduce(Scalar& k, const uint8_t* input, size_t len)
+{
+  reduceBytes(k, input, len, kL);
+}
+
+void
+scalarWrite(uint8_t output[32], const Scalar& k)
+{
+  toBytesBE(output, k);
+}
+
+bool
+scalarIsZero(const Scalar& k)
+{
+  return isZero(k);
+}
+
+bool
+pointRead(Point& P, const uint8_t* input, size_t len)
+{
+  if (len != 32) {
+    return false;
+  }
+
+  Fe y;
+  fromBytesLE(y, input);
+  unsigned sign = bit(y, 255);
+  y[NLimbs - 1] &= ~(static_cast<Limb>(1) << (LimbBits - 1));
+  if (!lessThan(y, kP)) {
+    return false;
+  }
+
+  // x^2 = u / v, where u = y^2 - 1 and v = d y^2 + 1
+  Fe one = feSmall(1), u, v, v3, t, x;
+  feMul(u, y, y);
+  feMul(v, u, kD);
+  feSub(u, u, one);
+  feAdd(v, v, one);
+
+  // x = u v^3 (u v^7)^((p-5)/8)
+  feMul(v3, v, v);
+  feMul(v3, v3, v);
+  feMul(t, v3, v3);
+  feMul(t, t, v);
+  feMul(t, t, u);
+  Fe e = kP;
+  e[0] -= 5;
+  for (int i = 0; i < NLimbs; ++i) {
+    e[i] = (e[i] >> 3) | (i + 1 < NLimbs ? e[i + 1] << (LimbBits - 3) : 0);
+  }
+  fePow(t, t, e);
+  feMul(x, u, v3);
+  feMul(x, x, t);
+
+  // check v x^2 = u, or v x^2 = -u in which case x is multiplied by sqrt(-1)
+  Fe vx2;
+  feMul(vx2, x, x);
+  feMul(vx2, vx2, v);
+  if (!feEqual(vx2, u)) {
+    feAdd(vx2, vx2, u);
+    if (!isZero(feFreeze(vx2))) {
+      return false;
+    }
+    feMul(x, x, kSqrtM1);
+  }
+
+  x = feFreeze(x);
+  if (isZero(x) && sign == 1) {
+    return false;
+  }
+  if (bit(x, 0) != sign) {
+    feSub(x, Fe{}, x);
+  }
+
+  P.X = x;
+  P.Y = y;
+  P.Z = one;
+  feMul(P.T, x, y);
+  return true;
+}
+
+void
+pointWrite(uint8_t output[32], size_t* len, const Point& P)
+{
+  Fe zInv;
+  feInv(zInv, P.Z);
+  writeAffine(output, len, P, zInv);
+}
+
+void
+pointWriteBatch(uint8_t* const output[], size_t len[], const Point P[], size_t n)
+{
+  for (size_t first = 0; first < n; first += WriteBatchChunk) {
+    size_t count = std::min<size_t>(WriteBatchChunk, n - first);
+    const Point* Q = &P[first];
+
+    // prefix[i] = Z[0] * ... * Z[i]; Z is never zero in extended coordinates
+    Fe prefix[WriteBatchChunk];
+    prefix[0] = Q[0].Z;
+    for (size_t i = 1; i < count; ++i) {
+      feMul(prefix[i], prefix[i - 1], Q[i].Z);
+    }
+
+    // Montgomery's trick: walk back from the inverse of the product
+    Fe inv, zInv;
+    feInv(inv, prefix[count - 1]);
+    for (size_t i = count - 1; i > 0; --i) {
+      feMul(zInv, inv, prefix[i - 1]);
+      feMul(inv, inv, Q[i].Z);
+      writeAffine(output[first + i], &len[first + i], Q[i], zInv);
+    }
+    writeAffine(output[first], &len[first], Q[0], inv);
+  }
+}
+
+bool
+pointIsZero(const Point& P)
+{
+  return isZero(feFreeze(P.X)) && feEqual(P.Y, P.Z);
+}
+
+/** @brief Unified addition for a = -1 (add-2008-hwcd-3), which is complete on edwards25519. */
+void
+pointAdd(Point& R, const Point& P, const Point& Q)
+{
+  Fe A, B, C, D, E, F, G, H, t;
+  feSub(A, P.Y, P.X);
+  feSub(t, Q.Y, Q.X);
+  feMul(A, A, t);
+  feAdd(B, P.Y, P.X);
+  feAdd(t, Q.Y, Q.X);
+  feMul(B, B, t);
+  feMul(C, P.T, kD2);
+  feMul(C, C, Q.T);
+  feMul(D, P.Z, Q.Z);
+  feAdd(D, D, D);
+  feSub(E, B, A);
+  feSub(F, D, C);
+  feAdd(G, D, C);
+  feAdd(H, B, A);
+  feMul(R.X, E, F);
+  feMul(R.Y, G, H);
+  feMul(R.T, E, H);
+  feMul(R.Z, F, G);
+}
+
+void
+pointSub(Point& R, const Point& P, const Point& Q)
+{
+  Point negQ = Q;
+  feSub(negQ.X, Fe{}, Q.X);
+  feSub(negQ.T, Fe{}, Q.T);
+  pointAdd(R, P, negQ);
+}
+
+void
+pointMulCofactor(Point& R, const Point& P)
+{
+  pointDbl(R, P);
+  pointDbl(R, R);
+  pointDbl(R, R);
+}
+
+void
+pointMul(Point& R, const Scalar& k, const Point& P)
+{
+  pointMulRange(R, k, P, 0, MulIterations);
+}
+
+void
+pointMulBase(Point& R, Base base, const Scalar& k)
+{
+  pointMulBaseRange(R, base, k, 0, MulIterations);
+}
+
+void
+pointMulBase2(Point& R, Base base1, const Scalar& k1, Base base2, const Scalar& k2)
+{
+  pointMulBase2Range(R, base1, k1, base2, k2, 0, MulIterations);
+}
+
+void
+pointMulRange(Point& acc, const Scalar& k, const Point& P, int begin, int end)
+{
+  // T[j] = j * P
+  Point T[16];
+  pointSetZero(T[0]);
+  T[1] = P;
+  for (int j = 2; j < 16; ++j) {
+    pointAdd(T[j], T[j - 1], P);
+  }
+
+  // fixed 4-bit windows, most significant first
+  if (begin == 0) {
+    pointSetZero(acc);
+  }
+  Point t;
+  for (int n = begin; n < end; ++n) {
+    int w = MulIterations - 1 - n;
+    for (int i = 0; i < 4; ++i) {
+      pointDbl(acc, acc);
+    }
+    unsigned d = static_cast<unsigned>(k[4 * w / LimbBits] >> (4 * w % LimbBits)) & 0x0F;
+    pointSelect(t, T, d);
+    pointAdd(acc, acc, t);
+  }
+}
+
+void
+pointMulBaseRange(Point& acc, Base base, const Scalar& k, int begin, int end)
+{
+  const Point* T = combTables[base];
+  if (begin == 0) {
+    pointSetZero(acc);
+  }
+  Point t;
+  for (int n = begin; n < end; ++n) {
+    pointDbl(acc, acc);
+    pointSelect(t, T, combDigit(k, MulIterations - 1 - n));
+    pointAdd(acc, acc, t);
+  }
+}
+
+void
+pointMulBase2Range(Point& acc, Base base1, const Scalar& k1, Base base2, const Scalar& k2,
+                   int begin, int end)
+{
+  // both combs share the doublings
+  const Point* T1 = combTables[base1];
+  const Point* T2 = combTables[base2];
+  if (begin == 0) {
+    pointSetZero(acc);
+  }
+  Point t;
+  for (int n = begin; n < end; ++n) {
+    int i = MulIterations - 1 - n;
+    pointDbl(acc, acc);
+    pointSelect(t, T1, combDigit(k1, i));
+    pointAdd(acc, acc, t);
+    pointSelect(t, T2, combDigit(k2, i));
+    pointAdd(acc, acc, t);
+  }
+}
+
+} // namespace ed25519
+} // namespace spake2
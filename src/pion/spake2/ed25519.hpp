@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: NIST-PD
+
+#ifndef PION_SPAKE2_ED25519_HPP
+#define PION_SPAKE2_ED25519_HPP
+
+#include "limbs.hpp"
+
+namespace spake2 {
+/** @brief Constant-time edwards25519 group arithmetic with fixed-size limbs. */
+namespace ed25519 {
+
+/** @brief Integer modulo p = 2^255 - 19, in range [0, 2^256). */
+using Fe = limbs::U256;
+
+/** @brief Scalar in range [0, l-1], where l is the order of the prime-order subgroup. */
+using Scalar = limbs::U256;
+
+/** @brief Point in extended twisted Edwards coordinates (X:Y:Z:T), where XY = ZT. */
+struct Point
+{
+  Fe X;
+  Fe Y;
+  Fe Z;
+  Fe T;
+};
+
+enum
+{
+  /** @brief Number of loop iterations in each scalar multiplication. */
+  MulIterations = 64,
+  /** @brief Number of points that share a field inversion in pointWriteBatch(). */
+  WriteBatchChunk = 16,
+};
+
+/** @brief Fixed bases with precomputed tables. */
+enum Base
+{
+  BaseG,
+  BaseM,
+  BaseN,
+};
+
+/**
+ * @brief Comb tables of the fixed bases, indexed by Base.
+ *
+ * See p256_native::combTables. They are generated by mk/spake2-native-tables.py, so that they
+ * stay in flash.
+ */
+extern const Point combTables[3][16];
+
+/** @brief Set k = input mod l, where input is a big endian integer of any length. */
+void
+scalarReduce(Scalar& k, const uint8_t* input, size_t len);
+
+/** @brief Write k as 32 octets big endian. */
+void
+scalarWrite(uint8_t output[32], const Scalar& k);
+
+bool
+scalarIsZero(const Scalar& k);
+
+/**
+ * @brief Decode a point in the 32-octet encoding of RFC 8032.
+ * @return whether the encoding is canonical and the point is on the curve.
+ */
+bool
+pointRead(Point& P, const uint8_t* input, size_t len);
+
+/** @brief Encode a point in the 32-octet encoding of RFC 8032. */
+void
+pointWrite(uint8_t output[32], size_t* len, const Point& P);
+
+/**
+ * @brief Encode n points as pointWrite() does, sharing one field inversion among every
+ *        WriteBatchChunk points (Montgomery's trick).
+ * @param[out] output output buffers, 32 octets each.
+ * @param[out] len encoded lengths.
+ */
+void
+pointWriteBatch(uint8_t* const output[], size_t len[], const Point P[], size_t n);
+
+bool
+pointIsZero(const Point& P);
+
+/** @brief R = P + Q. */
+void
+pointAdd(Point& R, const Point& P, const Point& Q);
+
+/** @brief R = P - Q. */
+void
+pointSub(Point& R, const Point& P, const Point& Q);
+
+/** @brief R = 8 * P, which clears any small order component. */
+void
+pointMulCofactor(Point& R, const Point& P);
+
+/** @brief R = k * P, in constant time. */
+void
+pointMul(Point& R, const Scalar& k, const Point& P);
+
+/** @brief R = k * base, in constant time, using the comb table of base. */
+void
+pointMulBase(Point& R, Base base, const Scalar& k);
+
+/** @brief R = k1 * base1 + k2 * base2, in constant time, sharing doublings between both combs. */
+void
+pointMulBase2(Point& R, Base base1, const Scalar& k1, Base base2, const Scalar& k2);
+
+/**
+ * @brief Perform loop iterations [begin, end) of pointMul(), updating the accumulator acc.
+ *
+ * acc is set to the identity when begin is 0. Running all MulIterations iterations, in one or
+ * more calls, yields acc = k * P. Each call rebuilds the window table of P.
+ */
+void
+pointMulRange(Point& acc, const Scalar& k, const Point& P, int begin, int end);
+
+/** @brief Perform loop iterations [begin, end) of pointMulBase(), see pointMulRange(). */
+void
+pointMulBaseRange(Point& acc, Base base, const Scalar& k, int begin, int end);
+
+/** @brief Perform loop iterations [begin, end) of pointMulBase2(), see pointMulRange(). */
+void
+pointMulBase2Range(Point& acc, Base base1, const Scalar& k1, Base base2, const Scalar& k2,
+                   int begin, int end);
+
+} // namespace ed25519
+} // namespace spake2
+
+#endif // PION_SPAKE2_ED25519_HPP
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: NIST-PD
+
+#ifndef PION_SPAKE2_LIMBS_HPP
+#define PION_SPAKE2_LIMBS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace spake2 {
+/** @brief Constant-time helpers on 256-bit integers with fixed-size limbs. */
+namespace limbs {
+
+#if defined(__SIZEOF_INT128__)
+using Limb = uint64_t;
+using DLimb = unsigned __int128;
+#else
+using Limb = uint32_t;
+using DLimb = uint64_t;
+#endif
+
+enum
+{
+  LimbBits = 8 * sizeof(Limb),
+  NLimbs = 256 / LimbBits,
+};
+
+/** @brief 256-bit integer as little endian limbs. */
+using U256 = std::array<Limb, NLimbs>;
+
+/** @brief Return all-ones if x is nonzero, otherwise zero. */
+inline Limb
+maskNonZero(Limb x)
+{
+  return static_cast<Limb>(0) - ((x | (static_cast<Limb>(0) - x)) >> (LimbBits - 1));
+}
+
+/** @brief r = mask ? a : b. */
+inline void
+select(U256& r, Limb mask, const U256& a, const U256& b)
+{
+  for (int i = 0; i < NLimbs; ++i) {
+    r[i] = (a[i] & mask) | (b[i] & ~mask);
+  }
+}
+
+/** @brief r = (carry:a) - m if (carry:a) >= m, otherwise r = a; requires (carry:a) < 2m. */
+inline void
+reduceOnce(U256& r, const U256& a, Limb carry, const U256& m)
+{
+  U256 d;
+  Limb borrow = 0;
+  for (int i = 0; i < NLimbs; ++i) {
+    DLimb t = static_cast<DLimb>(a[i]) - m[i] - borrow;
+    d[i] = static_cast<Limb>(t);
+    borrow = static_cast<Limb>(t >> LimbBits) & 1;
+  }
+  // keep a if there is a borrow out of the top limb that the carry does not absorb
+  select(r, maskNonZero(borrow & ~carry), a, d);
+}
+
+/** @brief r = input mod m, where input is a big endian integer of any length. */
+inline void
+reduceBytes(U256& r, const uint8_t* input, size_t len, const U256& m)
+{
+  r.fill(0);
+  for (size_t pos = 0; pos < len; ++pos) {
+    for (int bit = 7; bit >= 0; --bit) {
+      // r = 2r + bit, which is below 2m
+      U256 s;
+      Limb carry = (input[pos] >> bit) & 1;
+      for (int i = 0; i < NLimbs; ++i) {
+        s[i] = (r[i] << 1) | carry;
+        carry = r[i] >> (LimbBits - 1);
+      }
+      reduceOnce(r, s, carry, m);
+    }
+  }
+}
+
+/** @brief Return bit i of a. */
+inline unsigned
+bit(const U256& a, int i)
+{
+  return static_cast<unsigned>(a[i / LimbBits] >> (i % LimbBits)) & 1;
+}
+
+inline bool
+isEqual(const U256& a, const U256& b)
+{
+  Limb diff = 0;
+  for (int i = 0; i < NLimbs; ++i) {
+    diff |= a[i] ^ b[i];
+  }
+  return diff == 0;
+}
+
+inline bool
+isZero(const U256& a)
+{
+  return isEqual(a, U256{});
+}
+
+/** @brief Determine whether a < m; timing may depend on the values. */
+inline bool
+lessThan(const U256& a, const U256& m)
+{
+  for (int i = NLimbs - 1; i >= 0; --i) {
+    if (a[i] != m[i]) {
+      return a[i] < m[i];
+    }
+  }
+  return false;
+}
+
+/** @brief Read 32 octets big endian. */
+inline void
+fromBytesBE(U256& r, const uint8_t* input)
+{
+  r.fill(0);
+  for (size_t i = 0; i < 32; ++i) {
+    r[i / sizeof(Limb)] |= static_cast<Limb>(input[31 - i]) << (8 * (i % sizeof(Limb)));
+  }
+}
+
+/** @brief Write 32 octets big endian. */
+inline void
+toBytesBE(uint8_t* output, const U256& a)
+{
+  for (size_t i = 0; i < 32; ++i) {
+    output[31 - i] = static_cast<uint8_t>(a[i / sizeof(Limb)] >> (8 * (i % sizeof(Limb))));
+  }
+}
+
+/** @brief Read 32 octets little endian. */
+inline void
+fromBytesLE(U256& r, const uint8_t* input)
+{
+  r.fill(0);
+  for (size_t i = 0; i < 32; ++i) {
+    r[i / sizeof(Limb)] |= static_cast<Limb>(input[i]) << (8 * (i % sizeof(Limb)));
+  }
+}
+
+/** @brief Write 32 octets little endian. */
+inline void
+toBytesLE(uint8_t* output, const U256& a)
+{
+  for (size_t i = 0; i < 32; ++i) {
+    output[i] = static_cast<uint8_t>(a[i / sizeof(Limb)] >> (8 * (i % sizeof(Limb))));
+  }
+}
+
+} // namespace limbs
+} // namespace spake2
+
+#endif // PION_SPAKE2_LIMBS_HPP
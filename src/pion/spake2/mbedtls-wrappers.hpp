@@ -6,6 +6,12 @@
 #include "../common.hpp"
 #include <mbedtls/entropy.h>
 
+// mbedtls 3.x renames internal struct fields unless accessed through MBEDTLS_PRIVATE();
+// mbedtls 2.x has no such macro and its fields are accessed directly.
+#ifndef MBEDTLS_PRIVATE
+#define MBEDTLS_PRIVATE(member) member
+#endif
+
 namespace mbed {
 
 template<typename T, void (*InitFunc)(T*), void (*FreeFunc)(T*)>
@@ -0,0 +1,566 @@
+// SPDX-License-Identifier: NIST-PD
+
+#include "p256-multi.hpp"
+
+#if PION_SPAKE2_P256_MULTI
+
+#include <algorithm>
+#include <immintrin.h>
+
+#define PION_AVX2 __attribute__((target("avx2")))
+
+namespace spake2 {
+namespace p256_multi {
+namespace {
+
+// Field elements are kept in Montgomery form with R = 2^261, as 9 limbs of 29 bits.
+// Each limb is a 256-bit vector holding that limb of 4 independent elements (SoA layout).
+// All operations take and return normalized elements: limbs below 2^29, value below 2p.
+
+constexpr int NLimbs = 9;
+constexpr int LimbBits = 29;
+constexpr uint64_t LimbMask = (uint64_t(1) << LimbBits) - 1;
+
+const uint32_t kP[NLimbs] = {
+  0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFF, 0x000001FF, 0x00000000,
+  0x00000000, 0x00040000, 0x1FE00000, 0x00FFFFFF,
+};
+const uint32_t kP2[NLimbs] = {
+  0x1FFFFFFE, 0x1FFFFFFF, 0x1FFFFFFF, 0x000003FF, 0x00000000,
+  0x00000000, 0x00080000, 0x1FC00000, 0x01FFFFFF,
+};
+const uint32_t kP4[NLimbs] = {
+  0x1FFFFFFC, 0x1FFFFFFF, 0x1FFFFFFF, 0x000007FF, 0x00000000,
+  0x00000000, 0x00100000, 0x1F800000, 0x03FFFFFF,
+};
+// 4p with limbs rebalanced so that subtracting any normalized limb cannot go negative
+const uint32_t kP4Sub[NLimbs] = {
+  0x3FFFFFFC, 0x3FFFFFFE, 0x3FFFFFFE, 0x200007FE, 0x1FFFFFFF,
+  0x1FFFFFFF, 0x200FFFFF, 0x3F7FFFFF, 0x03FFFFFE,
+};
+// R^2 mod p
+const uint32_t kR2[NLimbs] = {
+  0x00000C00, 0x00000000, 0x1FFF0000, 0x1FDFFFFF, 0x1FBFFFFF,
+  0x1FFFFFFF, 0x1FFFFFFF, 0x1FFFFFFE, 0x00000013,
+};
+// R mod p, i.e. 1 in Montgomery form
+const uint32_t kOneMont[NLimbs] = {
+  0x00000020, 0x00000000, 0x00000000, 0x1FFFC000, 0x1FFFFFFF,
+  0x1FFFFFFF, 0x1F7FFFFF, 0x03FFFFFF, 0x00000000,
+};
+// curve coefficient b in Montgomery form
+const uint32_t kBMont[NLimbs] = {
+  0x1897BBFB, 0x1CDF6229, 0x018486C4, 0x01732821, 0x1DAD59E0,
+  0x0ABF7212, 0x1A06D110, 0x17721D20, 0x008600C3,
+};
+const uint32_t kZero[NLimbs] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+const uint32_t kOneRaw[NLimbs] = { 1, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+struct Fe
+{
+  __m256i v[NLimbs];
+};
+
+struct Point
+{
+  Fe X;
+  Fe Y;
+  Fe Z;
+};
+
+/** @brief Field elements of Lanes points, in memory without alignment requirement. */
+struct FeStore
+{
+  uint64_t v[NLimbs][Lanes];
+};
+
+PION_AVX2 inline void
+feConst(Fe& r, const uint32_t c[NLimbs])
+{
+  for (int i = 0; i < NLimbs; ++i) {
+    r.v[i] = _mm256_set1_epi64x(c[i]);
+  }
+}
+
+PION_AVX2 inline void
+feLoad(Fe& r, const FeStore& s)
+{
+  for (int i = 0; i < NLimbs; ++i) {
+    r.v[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.v[i]));
+  }
+}
+
+PION_AVX2 inline void
+feStore(FeStore& s, const Fe& a)
+{
+  for (int i = 0; i < NLimbs; ++i) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.v[i]), a.v[i]);
+  }
+}
+
+/** @brief Propagate carries so that every limb is below 2^29; limbs must be non-negative. */
+PION_AVX2 inline void
+feCarry(Fe& a)
+{
+  const __m256i mask = _mm256_set1_epi64x(LimbMask);
+  for (int i = 0; i < NLimbs - 1; ++i) {
+    a.v[i + 1] = _mm256_add_epi64(a.v[i + 1], _mm256_srli_epi64(a.v[i], LimbBits));
+    a.v[i] = _mm256_and_si256(a.v[i], mask);
+  }
+}
+
+/** @brief a = a - m if a >= m, in constant time. */
+PION_AVX2 inline void
+feCondSub(Fe& a, const uint32_t m[NLimbs])
+{
+  const __m256i mask = _mm256_set1_epi64x(LimbMask);
+  Fe d;
+  __m256i borrow = _mm256_setzero_si256();
+  for (int i = 0; i < NLimbs; ++i) {
+    __m256i t = _mm256_sub_epi64(_mm256_sub_epi64(a.v[i], _mm256_set1_epi64x(m[i])), borrow);
+    borrow = _mm256_srli_epi64(t, 63);
+    d.v[i] = _mm256_and_si256(t, mask);
+  }
+  // final borrow means a < m: keep a
+  __m256i keep = _mm256_sub_epi64(_mm256_setzero_si256(), borrow);
+  for (int i = 0; i < NLimbs; ++i) {
+    a.v[i] = _mm256_or_si256(_mm256_and_si256(keep, a.v[i]), _mm256_andnot_si256(keep, d.v[i]));
+  }
+}
+
+PION_AVX2 inline void
+feAdd(Fe& r, const Fe& a, const Fe& b)
+{
+  for (int i = 0; i < NLimbs; ++i) {
+    r.v[i] = _mm256_add_epi64(a.v[i], b.v[i]);
+  }
+  feCarry(r);
+  feCondSub(r, kP2);
+}
+
+PION_AVX2 inline void
+feSub(Fe& r, const Fe& a, const Fe& b)
+{
+  for (int i = 0; i < NLimbs; ++i) {
+    r.v[i] =
+      _mm256_sub_epi64(_mm256_add_epi64(a.v[i], _mm256_set1_epi64x(kP4Sub[i])), b.v[i]);
+  }
+  feCarry(r);
+  feCondSub(r, kP4);
+  feCondSub(r, kP2);
+}
+
+/**
+ * @brief Montgomery multiplication r = a * b / R mod p.
+ *
+ * Since p = -1 mod 2^29, the Montgomery quotient digit is the low limb itself.
+ * Column sums stay below 2^63, so carries are deferred until the end.
+ */
+PION_AVX2 inline void
+feMul(Fe& r, const Fe& a, const Fe& b)
+{
+  const __m256i mask = _mm256_set1_epi64x(LimbMask);
+  __m256i p[NLimbs];
+  for (int j = 0; j < NLimbs; ++j) {
+    p[j] = _mm256_set1_epi64x(kP[j]);
+  }
+
+  __m256i t[NLimbs];
+  for (int j = 0; j < NLimbs; ++j) {
+    t[j] = _mm256_setzero_si256();
+  }
+
+  for (int i = 0; i < NLimbs; ++i) {
+    for (int j = 0; j < NLimbs; ++j) {
+      t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(a.v[i], b.v[j]));
+    }
+    __m256i q = _mm256_and_si256(t[0], mask);
+    for (int j = 0; j < NLimbs; ++j) {
+      t[j] = _mm256_add_epi64(t[j], _mm256_mul_epu32(q, p[j]));
+    }
+    // t[0] is now divisible by 2^29: shift down by one limb
+    __m256i carry = _mm256_srli_epi64(t[0], LimbBits);
+    for (int j = 0; j < NLimbs - 1; ++j) {
+      t[j] = t[j + 1];
+    }
+    t[NLimbs - 1] = _mm256_setzero_si256();
+    t[0] = _mm256_add_epi64(t[0], carry);
+  }
+
+  for (int j = 0; j < NLimbs; ++j) {
+    r.v[j] = t[j];
+  }
+  feCarry(r);
+}
+
+PION_AVX2 inline void
+feMulConst(Fe& r, const Fe& a, const uint32_t c[NLimbs])
+{
+  Fe b;
+  feConst(b, c);
+  feMul(r, a, b);
+}
+
+/** @brief r = a^(p-2) = a^-1, in constant time. */
+PION_AVX2 void
+feInv(Fe& r, const Fe& a)
+{
+  // p-2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff ffffffff fffffffd
+  static const uint32_t e[8] = {
+    0xFFFFFFFD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF,
+  };
+  Fe acc;
+  feConst(acc, kOneMont);
+  for (int i = 255; i >= 0; --i) {
+    feMul(acc, acc, acc);
+    if ((e[i / 32] >> (i % 32)) & 1) {
+      feMul(acc, acc, a);
+    }
+  }
+  r = acc;
+}
+
+/** @brief Complete point addition for a = -3 (Renes-Costello-Batina, algorithm 4). */
+PION_AVX2 void
+pointAdd(Point& R, const Point& P, const Point& Q)
+{
+  Fe t0, t1, t2, t3, t4, X3, Y3, Z3;
+  feMul(t0, P.X, Q.X);
+  feMul(t1, P.Y, Q.Y);
+  feMul(t2, P.Z, Q.Z);
+  feAdd(t3, P.X, P.Y);
+  feAdd(t4, Q.X, Q.Y);
+  feMul(t3, t3, t4);
+  feAdd(t4, t0, t1);
+  feSub(t3, t3, t4);
+  feAdd(t4, P.Y, P.Z);
+  feAdd(X3, Q.Y, Q.Z);
+  feMul(t4, t4, X3);
+  feAdd(X3, t1, t2);
+  feSub(t4, t4, X3);
+  feAdd(X3, P.X, P.Z);
+  feAdd(Y3, Q.X, Q.Z);
+  feMul(X3, X3, Y3);
+  feAdd(Y3, t0, t2);
+  feSub(Y3, X3, Y3);
+  feMulConst(Z3, t2, kBMont);
+  feSub(X3, Y3, Z3);
+  feAdd(Z3, X3, X3);
+  feAdd(X3, X3, Z3);
+  feSub(Z3, t1, X3);
+  feAdd(X3, t1, X3);
+  feMulConst(Y3, Y3, kBMont);
+  feAdd(t1, t2, t2);
+  feAdd(t2, t1, t2);
+  feSub(Y3, Y3, t2);
+  feSub(Y3, Y3, t0);
+  feAdd(t1, Y3, Y3);
+  feAdd(Y3, t1, Y3);
+  feAdd(t1, t0, t0);
+  feAdd(t0, t1, t0);
+  feSub(t0, t0, t2);
+  feMul(t1, t4, Y3);
+  feMul(t2, t0, Y3);
+  feMul(Y3, X3, Z3);
+  feAdd(Y3, Y3, t2);
+  feMul(X3, t3, X3);
+  feSub(X3, X3, t1);
+  feMul(Z3, t4, Z3);
+  feMul(t1, t3, t0);
+  feAdd(Z3, Z3, t1);
+  R.X = X3;
+  R.Y = Y3;
+  R.Z = Z3;
+}
+
+/** @brief Complete point doubling for a = -3 (Renes-Costello-Batina, algorithm 6). */
+PION_AVX2 void
+pointDbl(Point& R, const Point& P)
+{
+  Fe t0, t1, t2, t3, X3, Y3, Z3;
+  feMul(t0, P.X, P.X);
+  feMul(t1, P.Y, P.Y);
+  feMul(t2, P.Z, P.Z);
+  feMul(t3, P.X, P.Y);
+  feAdd(t3, t3, t3);
+  feMul(Z3, P.X, P.Z);
+  feAdd(Z3, Z3, Z3);
+  feMulConst(Y3, t2, kBMont);
+  feSub(Y3, Y3, Z3);
+  feAdd(X3, Y3, Y3);
+  feAdd(Y3, X3, Y3);
+  feSub(X3, t1, Y3);
+  feAdd(Y3, t1, Y3);
+  feMul(Y3, X3, Y3);
+  feMul(X3, X3, t3);
+  feAdd(t3, t2, t2);
+  feAdd(t2, t2, t3);
+  feMulConst(Z3, Z3, kBMont);
+  feSub(Z3, Z3, t2);
+  feSub(Z3, Z3, t0);
+  feAdd(t3, Z3, Z3);
+  feAdd(Z3, Z3, t3);
+  feAdd(t3, t0, t0);
+  feAdd(t0, t3, t0);
+  feSub(t0, t0, t2);
+  feMul(t0, t0, Z3);
+  feAdd(Y3, Y3, t0);
+  feMul(t0, P.Y, P.Z);
+  feAdd(t0, t0, t0);
+  feMul(Z3, t0, Z3);
+  feSub(X3, X3, Z3);
+  feMul(Z3, t0, t1);
+  feAdd(Z3, Z3, Z3);
+  feAdd(Z3, Z3, Z3);
+  R.X = X3;
+  R.Y = Y3;
+  R.Z = Z3;
+}
+
+/** @brief r = table[digit] in each lane, reading every entry. */
+PION_AVX2 inline void
+pointSelect(Point& r, const Point table[16], __m256i digit)
+{
+  Fe* dst[] = { &r.X, &r.Y, &r.Z };
+  for (int c = 0; c < 3; ++c) {
+    for (int i = 0; i < NLimbs; ++i) {
+      dst[c]->v[i] = _mm256_setzero_si256();
+    }
+  }
+  for (int j = 0; j < 16; ++j) {
+    __m256i sel = _mm256_cmpeq_epi64(digit, _mm256_set1_epi64x(j));
+    const Fe* src[] = { &table[j].X, &table[j].Y, &table[j].Z };
+    for (int c = 0; c < 3; ++c) {
+      for (int i = 0; i < NLimbs; ++i) {
+        dst[c]->v[i] = _mm256_or_si256(dst[c]->v[i], _mm256_and_si256(sel, src[c]->v[i]));
+      }
+    }
+  }
+}
+
+/** @brief Convert 32-octet big endian integers into limbs, one integer per lane. */
+void
+bytesToLimbs(FeStore& s, const uint8_t* const in[Lanes])
+{
+  for (size_t lane = 0; lane < Lanes; ++lane) {
+    for (int i = 0; i < NLimbs; ++i) {
+      uint64_t limb = 0;
+      for (int bit = 0; bit < LimbBits; ++bit) {
+        int pos = i * LimbBits + bit;
+        if (pos < 256) {
+          limb |= static_cast<uint64_t>((in[lane][31 - pos / 8] >> (pos % 8)) & 1) << bit;
+        }
+      }
+      s.v[i][lane] = limb;
+    }
+  }
+}
+
+/** @brief Convert limbs into 32-octet big endian integers; values must be below 2^256. */
+void
+limbsToBytes(uint8_t* const out[Lanes], const FeStore& s, size_t nLanes)
+{
+  for (size_t lane = 0; lane < nLanes; ++lane) {
+    std::fill_n(out[lane], 32, 0);
+    for (int pos = 0; pos < 256; ++pos) {
+      uint8_t bit = (s.v[pos / LimbBits][lane] >> (pos % LimbBits)) & 1;
+      out[lane][31 - pos / 8] |= bit << (pos % 8);
+    }
+  }
+}
+
+/** @brief Compute R = k * P in each lane, in projective coordinates. */
+PION_AVX2 void
+scalarMul(Point& R, const uint8_t* const k[Lanes], const uint8_t* const P[Lanes])
+{
+  const uint8_t* px[Lanes];
+  const uint8_t* py[Lanes];
+  for (size_t lane = 0; lane < Lanes; ++lane) {
+    px[lane] = P[lane] + 1;
+    py[lane] = P[lane] + 33;
+  }
+
+  FeStore s;
+  Fe r2;
+  feConst(r2, kR2);
+  Point table[16];
+  bytesToLimbs(s, px);
+  feLoad(table[1].X, s);
+  feMul(table[1].X, table[1].X, r2);
+  bytesToLimbs(s, py);
+  feLoad(table[1].Y, s);
+  feMul(table[1].Y, table[1].Y, r2);
+  feConst(table[1].Z, kOneMont);
+
+  // table[j] = j * P, table[0] is the point at infinity (0:1:0)
+  feConst(table[0].X, kZero);
+  feConst(table[0].Y, kOneMont);
+  feConst(table[0].Z, kZero);
+  for (int j = 2; j < 16; ++j) {
+    pointAdd(table[j], table[j - 1], table[1]);
+  }
+
+  // fixed 4-bit windows, most significant first
+  R = table[0];
+  Point T;
+  for (int w = 63; w >= 0; --w) {
+    for (int i = 0; i < 4; ++i) {
+      pointDbl(R, R);
+    }
+    int64_t d[Lanes];
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+      d[lane] = (k[lane][31 - w / 2] >> (4 * (w % 2))) & 0x0F;
+    }
+    pointSelect(T, table, _mm256_set_epi64x(d[3], d[2], d[1], d[0]));
+    pointAdd(R, R, T);
+  }
+}
+
+/** @brief Compute projective results of one group of lanes and save them. */
+PION_AVX2 void
+computeGroup(FeStore& X, FeStore& Y, FeStore& Z, const uint8_t* const k[Lanes],
+             const uint8_t* const P[Lanes])
+{
+  Point R;
+  scalarMul(R, k, P);
+  feStore(X, R.X);
+  feStore(Y, R.Y);
+  feStore(Z, R.Z);
+}
+
+/**
+ * @brief Replace each Z with Z^-1, using one inversion for all groups (Montgomery's trick).
+ * @param nGroups number of groups, in range [1, ChunkGroups].
+ * @return false if any Z is zero.
+ */
+PION_AVX2 bool
+invertAll(FeStore Z[], size_t nGroups)
+{
+  FeStore prefix[ChunkGroups];
+  Fe acc, z;
+  feLoad(acc, Z[0]);
+  feStore(prefix[0], acc);
+  for (size_t g = 1; g < nGroups; ++g) {
+    feLoad(z, Z[g]);
+    feMul(acc, acc, z);
+    feStore(prefix[g], acc);
+  }
+
+  // acc is zero in a lane iff it is 0 or p after leaving Montgomery form
+  Fe plain;
+  feMulConst(plain, acc, kOneRaw);
+  feCondSub(plain, kP);
+  __m256i any = _mm256_setzero_si256();
+  for (int i = 0; i < NLimbs; ++i) {
+    any = _mm256_or_si256(any, plain.v[i]);
+  }
+  __m256i isZero = _mm256_cmpeq_epi64(any, _mm256_setzero_si256());
+  if (!_mm256_testz_si256(isZero, isZero)) {
+    return false;
+  }
+
+  Fe inv, t;
+  feInv(inv, acc);
+  for (size_t g = nGroups - 1; g > 0; --g) {
+    feLoad(t, prefix[g - 1]);
+    feMul(t, inv, t);
+    feLoad(z, Z[g]);
+    feMul(inv, inv, z);
+    feStore(Z[g], t);
+  }
+  feStore(Z[0], inv);
+  return true;
+}
+
+/** @brief Convert one group of projective results to affine and serialize them. */
+PION_AVX2 void
+finishGroup(uint8_t* const R[Lanes], size_t nLanes, const FeStore& X, const FeStore& Y,
+            const FeStore& Zinv)
+{
+  Fe x, y, zi;
+  feLoad(zi, Zinv);
+  feLoad(x, X);
+  feMul(x, x, zi);
+  feMulConst(x, x, kOneRaw);
+  feCondSub(x, kP);
+  feLoad(y, Y);
+  feMul(y, y, zi);
+  feMulConst(y, y, kOneRaw);
+  feCondSub(y, kP);
+
+  FeStore s;
+  uint8_t* out[Lanes] = {};
+  for (size_t lane = 0; lane < nLanes; ++lane) {
+    R[lane][0] = 0x04;
+    out[lane] = R[lane] + 1;
+  }
+  feStore(s, x);
+  limbsToBytes(out, s, nLanes);
+  for (size_t lane = 0; lane < nLanes; ++lane) {
+    out[lane] = R[lane] + 33;
+  }
+  feStore(s, y);
+  limbsToBytes(out, s, nLanes);
+}
+
+/** @brief Compute one chunk of at most ChunkGroups * Lanes items. */
+bool
+mulChunk(size_t n, const uint8_t* const k[], const uint8_t* const P[], uint8_t* const R[])
+{
+  size_t nGroups = (n + Lanes - 1) / Lanes;
+  FeStore X[ChunkGroups], Y[ChunkGroups], Z[ChunkGroups];
+  for (size_t g = 0; g < nGroups; ++g) {
+    // unused lanes of the last group repeat the first item
+    const uint8_t* kk[Lanes];
+    const uint8_t* pp[Lanes];
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+      size_t i = g * Lanes + lane;
+      kk[lane] = k[i < n ? i : 0];
+      pp[lane] = P[i < n ? i : 0];
+    }
+    computeGroup(X[g], Y[g], Z[g], kk, pp);
+  }
+
+  if (!invertAll(Z, nGroups)) {
+    return false;
+  }
+
+  for (size_t g = 0; g < nGroups; ++g) {
+    size_t nLanes = std::min(Lanes, n - g * Lanes);
+    finishGroup(R + g * Lanes, nLanes, X[g], Y[g], Z[g]);
+  }
+  return true;
+}
+
+bool enabled = true;
+
+} // namespace
+
+bool
+isAvailable()
+{
+  return enabled && __builtin_cpu_supports("avx2");
+}
+
+void
+setEnabled(bool value)
+{
+  enabled = value;
+}
+
+bool
+mul(size_t n, const uint8_t* const k[], const uint8_t* const P[], uint8_t* const R[])
+{
+  constexpr size_t chunk = ChunkGroups * Lanes;
+  bool ok = true;
+  for (size_t i = 0; i < n; i += chunk) {
+    size_t m = std::min(chunk, n - i);
+    ok = mulChunk(m, k + i, P + i, R + i) && ok;
+  }
+  return ok;
+}
+
+} // namespace p256_multi
+} // namespace spake2
+
+#endif // PION_SPAKE2_P256_MULTI
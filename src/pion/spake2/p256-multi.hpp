@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: NIST-PD
+
+#ifndef PION_SPAKE2_P256_MULTI_HPP
+#define PION_SPAKE2_P256_MULTI_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Whether the AVX2 multi-buffer P-256 backend is compiled in.
+ *
+ * It is available on x86-64 hosts built with GCC or Clang, and can be disabled by defining this
+ * macro to 0. Whether the CPU supports AVX2 is determined at runtime.
+ */
+#ifndef PION_SPAKE2_P256_MULTI
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(ARDUINO)
+#define PION_SPAKE2_P256_MULTI 1
+#else
+#define PION_SPAKE2_P256_MULTI 0
+#endif
+#endif
+
+namespace spake2 {
+namespace p256_multi {
+
+/** @brief Lanes processed in parallel. */
+static constexpr size_t Lanes = 4;
+
+/** @brief Groups of lanes that share a field inversion; mul() processes items in such chunks. */
+static constexpr size_t ChunkGroups = 8;
+
+#if PION_SPAKE2_P256_MULTI
+
+/** @brief Determine whether the CPU supports the multi-buffer backend and it is enabled. */
+bool
+isAvailable();
+
+/**
+ * @brief Enable or disable the multi-buffer backend; it is enabled by default.
+ *
+ * When disabled, isAvailable() returns false as if the CPU did not support AVX2, so that tests
+ * and benchmarks can exercise the fallback path. This is not synchronized with concurrent
+ * batches.
+ */
+void
+setEnabled(bool enabled);
+
+/**
+ * @brief Compute R[i] = k[i] * P[i] for each i < n.
+ * @param k scalars, 32 octets big endian each, in range [1, order-1].
+ * @param P points, 65 octets in uncompressed SEC1 format each, validated to be on the curve.
+ * @param[out] R results, 65 octets in uncompressed SEC1 format each.
+ * @return whether success; false if any result is the point at infinity.
+ * @pre isAvailable()
+ *
+ * Scalar multiplications run in constant time, @c Lanes at a time. The conversion of results
+ * to affine coordinates shares a single field inversion per lane in each chunk of
+ * @c ChunkGroups groups. All working storage is on the stack.
+ */
+bool
+mul(size_t n, const uint8_t* const k[], const uint8_t* const P[], uint8_t* const R[]);
+
+#else
+
+inline bool
+isAvailable()
+{
+  return false;
+}
+
+inline void
+setEnabled(bool)
+{}
+
+inline bool
+mul(size_t, const uint8_t* const[], const uint8_t* const[], uint8_t* const[])
+{
+  return false;
+}
+
+#endif // PION_SPAKE2_P256_MULTI
+
+} // namespace p256_multi
+} // namespace spake2
+
+#endif // PION_SPAKE2_P256_MULTI_HPP
@@ -0,0 +1,324 @@
+// SPDX-License-Identifier: NIST-PD
+// Generated by mk/spake2-native-tables.py p256, do not edit.
+
+#include "p256-native.hpp"
+
+#if PION_SPAKE2_P256_NATIVE
+
+#if defined(__SIZEOF_INT128__)
+#define PION_LIMB(lo, hi) ((static_cast<limbs::Limb>(hi) << 32) | (lo))
+#else
+#define PION_LIMB(lo, hi) (lo), (hi)
+#endif
+
+namespace spake2 {
+namespace p256_native {
+
+// clang-format off
+const Point combTables[3][16] = {
+  // G
+  {
+    { { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } },
+      { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } } },
+    { { { PION_LIMB(0x18A9143C, 0x79E730D4), PION_LIMB(0x5FEDB601, 0x75BA95FC),
+          PION_LIMB(0x77622510, 0x79FB732B), PION_LIMB(0xA53755C6, 0x18905F76) } },
+      { { PION_LIMB(0xCE95560A, 0xDDF25357), PION_LIMB(0xBA19E45C, 0x8B4AB8E4),
+          PION_LIMB(0xDD21F325, 0xD2E88688), PION_LIMB(0x25885D85, 0x8571FF18) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x16A0D2BB, 0x4F922FC5), PION_LIMB(0x1A623499, 0x0D5CC16C),
+          PION_LIMB(0x57C62C8B, 0x9241CF3A), PION_LIMB(0xFD1B667F, 0x2F5E6961) } },
+      { { PION_LIMB(0xF5A01797, 0x5C15C70B), PION_LIMB(0x60956192, 0x3D20B44D),
+          PION_LIMB(0x071FDB52, 0x04911B37), PION_LIMB(0x8D6F0F7B, 0xF648F916) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xE137BBBC, 0x9E566847), PION_LIMB(0x8A6A0BEC, 0xE434469E),
+          PION_LIMB(0x79D73463, 0xB1C42761), PION_LIMB(0x133D0015, 0x5ABE0285) } },
+      { { PION_LIMB(0xC04C7DAB, 0x92AA837C), PION_LIMB(0x43260C07, 0x573D9F4C),
+          PION_LIMB(0x78E6CC37, 0x0C931562), PION_LIMB(0x6B6F7383, 0x94BB725B) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xBFE20925, 0x62A8C244), PION_LIMB(0x8FDCE867, 0x91C19AC3),
+          PION_LIMB(0xDD387063, 0x5A96A5D5), PION_LIMB(0x21D324F6, 0x61D587D4) } },
+      { { PION_LIMB(0xA37173EA, 0xE87673A2), PION_LIMB(0x53778B65, 0x23848008),
+          PION_LIMB(0x05BAB43E, 0x10F8441E), PION_LIMB(0x4621EFBE, 0xFA11FE12) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x2CB19FFD, 0x1C891F2B), PION_LIMB(0xB1923C23, 0x01BA8D5B),
+          PION_LIMB(0x8AC5CA8E, 0xB6D03D67), PION_LIMB(0x1F13BEDC, 0x586EB04C) } },
+      { { PION_LIMB(0x27E8ED09, 0x0C35C6E5), PION_LIMB(0x1819EDE2, 0x1E81A33C),
+          PION_LIMB(0x56C652FA, 0x278FD6C0), PION_LIMB(0x70864F11, 0x19D5AC08) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xD2B533D5, 0x62577734), PION_LIMB(0xA1BDDDC0, 0x673B8AF6),
+          PION_LIMB(0xA79EC293, 0x577E7C9A), PION_LIMB(0xC3B266B1, 0xBB6DE651) } },
+      { { PION_LIMB(0xB65259B3, 0xE7E9303A), PION_LIMB(0xD03A7480, 0xD6A0AFD3),
+          PION_LIMB(0x9B3CFC27, 0xC5AC83D1), PION_LIMB(0x5D18B99B, 0x60B4619A) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x1AE5AA1C, 0xBD6A38E1), PION_LIMB(0x49E73658, 0xB8B7652B),
+          PION_LIMB(0xEE5F87ED, 0x0B130014), PION_LIMB(0xAEEBFFCD, 0x9D0F27B2) } },
+      { { PION_LIMB(0x7A730A55, 0xCA924631), PION_LIMB(0xDDBBC83A, 0x9C955B2F),
+          PION_LIMB(0xAC019A71, 0x07C1DFE0), PION_LIMB(0x356EC48D, 0x244A566D) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xF4F8B16A, 0x56F8410E), PION_LIMB(0xC47B266A, 0x97241AFE),
+          PION_LIMB(0x6D9C87C1, 0x0A406B8E), PION_LIMB(0xCD42AB1B, 0x803F3E02) } },
+      { { PION_LIMB(0x04DBEC69, 0x7F0309A8), PION_LIMB(0x3BBAD05F, 0xA83B85F7),
+          PION_LIMB(0xAD8E197F, 0xC6097273), PION_LIMB(0x5067ADC1, 0xC097440E) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xC379AB34, 0x846A56F2), PION_LIMB(0x841DF8D1, 0xA8EE068B),
+          PION_LIMB(0x176C68EF, 0x20314459), PION_LIMB(0x915F1F30, 0xF1AF32D5) } },
+      { { PION_LIMB(0x5D75BD50, 0x99C37531), PION_LIMB(0xF72F67BC, 0x837CFFBA),
+          PION_LIMB(0x48D7723F, 0x0613A418), PION_LIMB(0xE2D41C8B, 0x23D0F130) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xD5BE5A2B, 0xED93E225), PION_LIMB(0x5934F3C6, 0x6FE79983),
+          PION_LIMB(0x22626FFC, 0x43140926), PION_LIMB(0x7990216A, 0x50BBB4D9) } },
+      { { PION_LIMB(0xE57EC63E, 0x378191C6), PION_LIMB(0x181DCDB2, 0x65422C40),
+          PION_LIMB(0x0236E0F6, 0x41A8099B), PION_LIMB(0x01FE49C3, 0x2B100118) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x9B391593, 0xFC68B5C5), PION_LIMB(0x598270FC, 0xC385F5A2),
+          PION_LIMB(0xD19ADCBB, 0x7144F3AA), PION_LIMB(0x83FBAE0C, 0xDD558999) } },
+      { { PION_LIMB(0x74B82FF4, 0x93B88B8E), PION_LIMB(0x71E734C9, 0xD2E03C40),
+          PION_LIMB(0x43C0322A, 0x9A7A9EAF), PION_LIMB(0x149D6041, 0xE6E4C551) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x80EC21FE, 0x5FE14BFE), PION_LIMB(0xC255BE82, 0xF6CE116A),
+          PION_LIMB(0x2F4A5D67, 0x98BC5A07), PION_LIMB(0xDB7E63AF, 0xFAD27148) } },
+      { { PION_LIMB(0x29AB05B3, 0x90C0B6AC), PION_LIMB(0x4E251AE6, 0x37A9A83C),
+          PION_LIMB(0xC2AADE7D, 0x0A7DC875), PION_LIMB(0x9F0E1A84, 0x77387DE3) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xA56C0DD7, 0x1E9ECC49), PION_LIMB(0x46086C74, 0xA5CFFCD8),
+          PION_LIMB(0xF505AECE, 0x8F7A1408), PION_LIMB(0xBEF0C47E, 0xB37B85C0) } },
+      { { PION_LIMB(0xCC0E6A8F, 0x3596B6E4), PION_LIMB(0x6B388F23, 0xFD6D4BBF),
+          PION_LIMB(0xC39CEF4E, 0xABA453FA), PION_LIMB(0xF9F628D5, 0x9C135AC8) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x95C8F8BE, 0x0A1C7294), PION_LIMB(0x3BF362BF, 0x2961C480),
+          PION_LIMB(0xDF63D4AC, 0x9E418403), PION_LIMB(0x91ECE900, 0xC109F9CB) } },
+      { { PION_LIMB(0x58945705, 0xC2D095D0), PION_LIMB(0xDDEB85C0, 0xB9083D96),
+          PION_LIMB(0x7A40449B, 0x84692B8D), PION_LIMB(0x2EEE1EE1, 0x9BC3344F) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x42913074, 0x0D5AE356), PION_LIMB(0x48A542B1, 0x55491B27),
+          PION_LIMB(0xB310732A, 0x469CA665), PION_LIMB(0x5F1A4CC1, 0x29591D52) } },
+      { { PION_LIMB(0xB84F983F, 0xE76F5B6B), PION_LIMB(0x9F5F84E1, 0xBE7EEF41),
+          PION_LIMB(0x80BAA189, 0x1200D496), PION_LIMB(0x18EF332C, 0x6376551F) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+  },
+  // M
+  {
+    { { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } },
+      { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } } },
+    { { { PION_LIMB(0x25031EE1, 0x8E46DB1E), PION_LIMB(0x3F5117F2, 0x06891739),
+          PION_LIMB(0xC962BF07, 0x28312D86), PION_LIMB(0xE4C348F2, 0xC780D935) } },
+      { { PION_LIMB(0x83B540CB, 0xF8D72509), PION_LIMB(0x8A0134D5, 0x3992291E),
+          PION_LIMB(0xF44340D4, 0x024DA7B1), PION_LIMB(0x5D3A7884, 0xFDB70AFA) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x576A9EED, 0xE7D1F04D), PION_LIMB(0xB8CDDBB8, 0xB0CDE40C),
+          PION_LIMB(0xB5311E73, 0xE48BB025), PION_LIMB(0x98B67E36, 0xDAE58D1A) } },
+      { { PION_LIMB(0x86D3492C, 0x59D84DC9), PION_LIMB(0x314172D3, 0xD439FB7A),
+          PION_LIMB(0x0FC23CF0, 0x8E62346F), PION_LIMB(0x34268196, 0xB8B8FBC9) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x8639665F, 0x7A5C07AD), PION_LIMB(0x9235C06F, 0x26D92AE4),
+          PION_LIMB(0xF0E1CA9F, 0x01AAEAFB), PION_LIMB(0x59758A29, 0xCA829AC6) } },
+      { { PION_LIMB(0xBB6D7D38, 0xF2246C92), PION_LIMB(0x8E374EED, 0x844A37B8),
+          PION_LIMB(0x83DAEB81, 0xEC4B0727), PION_LIMB(0x1541EF6D, 0x98C186B2) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x67C50D28, 0xDB74DA46), PION_LIMB(0xFF58624A, 0x503E4598),
+          PION_LIMB(0xC25AF3F7, 0x385352C7), PION_LIMB(0x87C8CF41, 0xB5DBFB8D) } },
+      { { PION_LIMB(0xFC36AA11, 0x8EDE4A08), PION_LIMB(0x3030FF93, 0x3D15D900),
+          PION_LIMB(0x888CDB23, 0xAC83B91B), PION_LIMB(0x5CE44AE3, 0xF6F05B7B) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xD7A2A3BA, 0x71AF9ACC), PION_LIMB(0xC54EE197, 0xF3362C61),
+          PION_LIMB(0xFA0327D1, 0xD6A9B4E6), PION_LIMB(0xFA216881, 0x4180D366) } },
+      { { PION_LIMB(0x23293089, 0x99941A08), PION_LIMB(0xB536F9AC, 0xB2A8D25B),
+          PION_LIMB(0xDE9FF551, 0x2F493CB0), PION_LIMB(0x86554E6F, 0x1132DF31) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xF4E528D9, 0xFF47F14A), PION_LIMB(0x55C8E6CC, 0x1428E833),
+          PION_LIMB(0x922C168E, 0xE8A76DC0), PION_LIMB(0x2552BA33, 0xF4F65469) } },
+      { { PION_LIMB(0x45F8FF3D, 0xFD2C6254), PION_LIMB(0x7196B9FD, 0x40E219DD),
+          PION_LIMB(0x557C9D2C, 0xA39B8893), PION_LIMB(0xD4381CC0, 0xA832C140) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x98BEE8CB, 0x08AA0DB8), PION_LIMB(0xDE28B8FE, 0xF6E4B606),
+          PION_LIMB(0xE48E440B, 0x3E8346F6), PION_LIMB(0xF107B5C6, 0xBE168642) } },
+      { { PION_LIMB(0x1774E88A, 0x73F25256), PION_LIMB(0xA796865C, 0xA90BC7DC),
+          PION_LIMB(0xC66885A0, 0xEADA5979), PION_LIMB(0x029067FF, 0xF6EF1EF8) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xE5DE1008, 0x1D55284E), PION_LIMB(0xE8519BCB, 0xBBCAF357),
+          PION_LIMB(0x555249A0, 0x344B4E9B), PION_LIMB(0x936CD5E6, 0xC9714E3B) } },
+      { { PION_LIMB(0x3E4699F3, 0x4C69C222), PION_LIMB(0x5C1405F3, 0x04017E41),
+          PION_LIMB(0x8DA47A11, 0x612E0ECC), PION_LIMB(0x4046852A, 0x882FE580) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x63AA8B58, 0x2C011658), PION_LIMB(0x98DA341C, 0x5B10A531),
+          PION_LIMB(0x3582B22B, 0x82906CA2), PION_LIMB(0x5A1ED81C, 0x4FBF197F) } },
+      { { PION_LIMB(0xC20A6637, 0x6DEEA7C9), PION_LIMB(0x3664DAE0, 0xCDA4DF89),
+          PION_LIMB(0x35D00D80, 0xE88C9FAD), PION_LIMB(0x268F17D9, 0x24A4DE84) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x3713E207, 0x09CDF2A6), PION_LIMB(0xF10085C9, 0xDBF0C4B6),
+          PION_LIMB(0xAB27592D, 0x9E9332A2), PION_LIMB(0xEE102CCF, 0xD6DC78EB) } },
+      { { PION_LIMB(0xB65CF416, 0xF3E107C2), PION_LIMB(0x4B5D4684, 0x643E4AD5),
+          PION_LIMB(0x4EC10AB4, 0xA561B7AE), PION_LIMB(0x0A61ECA3, 0xB5D404C2) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xFBE80D66, 0x53468158), PION_LIMB(0x4EF8DD73, 0xC828416A),
+          PION_LIMB(0x0CA57C02, 0x6F7BB0E3), PION_LIMB(0xDC518361, 0x289C94BB) } },
+      { { PION_LIMB(0x4C3C5171, 0x0B034251), PION_LIMB(0xED407C94, 0xBE992E97),
+          PION_LIMB(0xA76A65AF, 0x5359725F), PION_LIMB(0x609D727A, 0x1FAEB6AB) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x28323D65, 0x63A1B8A7), PION_LIMB(0x0DECD566, 0x93E3B4B9),
+          PION_LIMB(0x3FE0E7FE, 0xC30062A8), PION_LIMB(0x7ECF2060, 0xDF6B2373) } },
+      { { PION_LIMB(0x150F8713, 0x48EB8582), PION_LIMB(0x0C531A35, 0x30F16851),
+          PION_LIMB(0x76FC54D3, 0x2779BD9C), PION_LIMB(0xAA52BA20, 0xD19435EB) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x3A6234F6, 0xC71E03B0), PION_LIMB(0x064BEBA4, 0xFDCD1817),
+          PION_LIMB(0x2B670977, 0xA9A26872), PION_LIMB(0x207F5982, 0x06EA79F1) } },
+      { { PION_LIMB(0x6094907D, 0x856CB9DE), PION_LIMB(0xCC44AF15, 0xC29D18D5),
+          PION_LIMB(0xF36A11C3, 0x23844659), PION_LIMB(0xB788E217, 0xADE0C22D) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x55AA1E97, 0x9F1CB002), PION_LIMB(0x35B47CF8, 0xCC7C0604),
+          PION_LIMB(0x1E73BE83, 0xF9BADB72), PION_LIMB(0x37202EEC, 0x5E0B0AFD) } },
+      { { PION_LIMB(0x98521951, 0xFC64D48E), PION_LIMB(0x56545706, 0xE6F88ABD),
+          PION_LIMB(0x63558B10, 0x69852DCD), PION_LIMB(0xC56C5DE6, 0x21D99DA3) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xA66335E8, 0xBE2DD4B0), PION_LIMB(0x47EE0D48, 0x5D1FAD1C),
+          PION_LIMB(0x27DC1E05, 0x6F6A5B57), PION_LIMB(0x45BE70FF, 0xA9C68D7D) } },
+      { { PION_LIMB(0xD77A310F, 0x1E22218B), PION_LIMB(0xA2A07C98, 0x708A1E98),
+          PION_LIMB(0x6C342ECE, 0x5F4CB591), PION_LIMB(0x24D6CA8B, 0x66C40081) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+  },
+  // N
+  {
+    { { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } },
+      { { PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000),
+          PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000000, 0x00000000) } } },
+    { { { PION_LIMB(0xAFDB6071, 0x5109D1D8), PION_LIMB(0x5843D9FB, 0x902C406E),
+          PION_LIMB(0xBF4B67E6, 0x91CFE8BA), PION_LIMB(0x229EFEAD, 0x27382BA0) } },
+      { { PION_LIMB(0x3476905B, 0x494E0A03), PION_LIMB(0xB1F23B0B, 0xD0F2BCD4),
+          PION_LIMB(0x36D38A4F, 0x1661DF78), PION_LIMB(0x8DA4116C, 0x72DCFCAB) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x6D08C54F, 0xE0AC3D58), PION_LIMB(0x27724EB5, 0xCF474903),
+          PION_LIMB(0x45F5A96B, 0xA5B6AF2E), PION_LIMB(0x048650AC, 0x6C7D01C8) } },
+      { { PION_LIMB(0x9A904439, 0x894F59E0), PION_LIMB(0x19E739E5, 0x47C44BA9),
+          PION_LIMB(0xE3B54112, 0x6AA10176), PION_LIMB(0x779120D9, 0xB56E5C94) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x0B9F6277, 0xFA6E7323), PION_LIMB(0x22CB3BAE, 0x8F9AC6A4),
+          PION_LIMB(0x75198F1C, 0xE417BDA7), PION_LIMB(0x056DFA63, 0x84E8DC9D) } },
+      { { PION_LIMB(0x30BFB4C9, 0x9C152918), PION_LIMB(0xB38876A1, 0xA34F7BB3),
+          PION_LIMB(0x368D5CE6, 0x1946C618), PION_LIMB(0xE3E82BD2, 0xEBAAF100) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xB25A15F0, 0xB6A47ED4), PION_LIMB(0xE7941958, 0x279AC707),
+          PION_LIMB(0x9DB33C38, 0xCB3B115A), PION_LIMB(0x5000AB4C, 0xFCF46215) } },
+      { { PION_LIMB(0x4A66450F, 0x9E0DBECC), PION_LIMB(0xF67CADE3, 0x5FB641A5),
+          PION_LIMB(0x0CB51D0D, 0x1D1F2404), PION_LIMB(0x74311231, 0x1707E7F1) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x4C49A2F8, 0xD274CA4D), PION_LIMB(0xA01BA601, 0x42DA2D36),
+          PION_LIMB(0x31F65DD7, 0x3A9CE763), PION_LIMB(0x5158F4E3, 0xD813245D) } },
+      { { PION_LIMB(0x1AFDDEA0, 0x9B270CEC), PION_LIMB(0x1B6F6B14, 0x3FE960F5),
+          PION_LIMB(0x5EA93217, 0xDF05933C), PION_LIMB(0x7911E131, 0xC23AEBAE) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x5D958492, 0x3489DD74), PION_LIMB(0x10F02EDB, 0x5FABD597),
+          PION_LIMB(0xFB0C7968, 0x46250365), PION_LIMB(0x6653275F, 0x44D4419E) } },
+      { { PION_LIMB(0xBAF07977, 0xC3B67776), PION_LIMB(0xB253FB24, 0xAB5FF77C),
+          PION_LIMB(0x6123B5FA, 0xF5934D69), PION_LIMB(0x8E3A3074, 0xD9241D01) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x96EF93AB, 0x43E08204), PION_LIMB(0x540C49D1, 0xB7A76127),
+          PION_LIMB(0xD6DF7CBD, 0x9D0F1612), PION_LIMB(0x5609419F, 0x579AABED) } },
+      { { PION_LIMB(0x73AF3E02, 0x98449BCE), PION_LIMB(0xAD37D1C0, 0xB5597B22),
+          PION_LIMB(0x97C0EC2A, 0xA67AF6F6), PION_LIMB(0xF7393B68, 0xA1783A48) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xEDBA9A3D, 0x50909E27), PION_LIMB(0xA3CF4B00, 0x27254D64),
+          PION_LIMB(0x3DE6A839, 0x75848645), PION_LIMB(0x5F1FF907, 0xAE1BE9AE) } },
+      { { PION_LIMB(0x4EC46B94, 0x396AC83B), PION_LIMB(0xD4832716, 0xDE14DF6C),
+          PION_LIMB(0x5D3D9CF1, 0x495BB97B), PION_LIMB(0xFA150446, 0x4D06320A) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x97F48DB5, 0x790BB3D5), PION_LIMB(0x02E3BE43, 0x4239C9D0),
+          PION_LIMB(0x83CB133C, 0x4BC5F87F), PION_LIMB(0xCB487202, 0xBC57C8A8) } },
+      { { PION_LIMB(0xF7EE8731, 0xF4E70265), PION_LIMB(0x6F98D70D, 0x7AF57C3A),
+          PION_LIMB(0xC2B51EDB, 0x8144AF1E), PION_LIMB(0x757A99C9, 0x03FC6327) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x265DB74D, 0xD834CD1E), PION_LIMB(0x5D93D7B9, 0xD5551502),
+          PION_LIMB(0x5E5A74C4, 0xBDA3A2B1), PION_LIMB(0x23B2A8ED, 0x56132437) } },
+      { { PION_LIMB(0x2791C615, 0x6B62B950), PION_LIMB(0x9B4150E2, 0x4439F223),
+          PION_LIMB(0x420D5FA1, 0x3E07F18A), PION_LIMB(0xE8E99288, 0xD67BAA44) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x707C3953, 0x1D268C03), PION_LIMB(0x782EED9E, 0xAE7242C5),
+          PION_LIMB(0x84B62ED2, 0xE65B0DAE), PION_LIMB(0x44AB63BF, 0x8148B924) } },
+      { { PION_LIMB(0x86FE7807, 0x5DB71BE1), PION_LIMB(0xFC42D2D1, 0xAE38422F),
+          PION_LIMB(0x0F35532D, 0xB03C167D), PION_LIMB(0xB13158C1, 0x68DCB502) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0x06B9ECFB, 0x3A534170), PION_LIMB(0x5630F606, 0xF4B81220),
+          PION_LIMB(0x74F3F607, 0xEBA64475), PION_LIMB(0xE10FE4B9, 0x57BA07A0) } },
+      { { PION_LIMB(0xBED0A42E, 0xC1DB58B9), PION_LIMB(0x4845E436, 0xFFF0870B),
+          PION_LIMB(0x828D4388, 0x75C9FE6E), PION_LIMB(0x72BB4C14, 0x07F2F91E) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xD5939C7E, 0x2EB99BED), PION_LIMB(0x7D079F16, 0x4EFE8B73),
+          PION_LIMB(0xE07D60B0, 0x5D499868), PION_LIMB(0x7EA34498, 0xBB18DC51) } },
+      { { PION_LIMB(0x542FC045, 0x0CFD01DC), PION_LIMB(0x61C073A4, 0x448D4F81),
+          PION_LIMB(0x50CC61BE, 0xC4E48D70), PION_LIMB(0xFBDE05A5, 0x3A8DBACF) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xA88FC838, 0x011DBD79), PION_LIMB(0x20E6FCAA, 0xA9037097),
+          PION_LIMB(0x9DF13E3C, 0x464ACDA2), PION_LIMB(0x21B82529, 0xD4E66118) } },
+      { { PION_LIMB(0x20BD7F75, 0xF4664547), PION_LIMB(0x1BF83FFC, 0x27F4FBE2),
+          PION_LIMB(0x088E1938, 0xD72C4BE8), PION_LIMB(0xC6A3F205, 0x46D91DEC) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+    { { { PION_LIMB(0xEBFB49F4, 0x41E2FADF), PION_LIMB(0x092F23AC, 0x23F8F306),
+          PION_LIMB(0xA5BB57E4, 0x7AB68E98), PION_LIMB(0x1B71712C, 0xC2E89054) } },
+      { { PION_LIMB(0x4D5C47D3, 0x5565F943), PION_LIMB(0x6733AF92, 0x85BB7294),
+          PION_LIMB(0x78B1180B, 0xCEC8408F), PION_LIMB(0x46CF411B, 0x1362D300) } },
+      { { PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+          PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000) } } },
+  },
+};
+// clang-format on
+
+#undef PION_LIMB
+
+} // namespace p256_native
+} // namespace spake2
+
+#endif // PION_SPAKE2_P256_NATIVE
@@ -0,0 +1,524 @@
+// SPDX-License-Identifier: NIST-PD
+
+#include "spake2.hpp"
+
+#if PION_SPAKE2_P256_NATIVE
+
+namespace spake2 {
+namespace p256_native {
+namespace {
+
+using namespace limbs;
+
+#if defined(__SIZEOF_INT128__)
+#define PION_LIMB(lo, hi) ((static_cast<Limb>(hi) << 32) | (lo))
+#else
+#define PION_LIMB(lo, hi) (lo), (hi)
+#endif
+
+// clang-format off
+const Fe kP = { {
+  PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFF, 0x00000000),
+  PION_LIMB(0x00000000, 0x00000000), PION_LIMB(0x00000001, 0xFFFFFFFF),
+} };
+const Fe kN = { {
+  PION_LIMB(0xFC632551, 0xF3B9CAC2), PION_LIMB(0xA7179E84, 0xBCE6FAAD),
+  PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0x00000000, 0xFFFFFFFF),
+} };
+// R^2 mod p, where R = 2^256
+const Fe kR2 = { {
+  PION_LIMB(0x00000003, 0x00000000), PION_LIMB(0xFFFFFFFF, 0xFFFFFFFB),
+  PION_LIMB(0xFFFFFFFE, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFD, 0x00000004),
+} };
+// R mod p, i.e. 1 in Montgomery form
+const Fe kOne = { {
+  PION_LIMB(0x00000001, 0x00000000), PION_LIMB(0x00000000, 0xFFFFFFFF),
+  PION_LIMB(0xFFFFFFFF, 0xFFFFFFFF), PION_LIMB(0xFFFFFFFE, 0x00000000),
+} };
+// curve coefficient b in Montgomery form
+const Fe kB = { {
+  PION_LIMB(0x29C4BDDF, 0xD89CDF62), PION_LIMB(0x78843090, 0xACF005CD),
+  PION_LIMB(0xF7212ED6, 0xE5A220AB), PION_LIMB(0x04874834, 0xDC30061D),
+} };
+// clang-format on
+
+#undef PION_LIMB
+
+void
+feAdd(Fe& r, const Fe& a, const Fe& b)
+{
+  Fe s;
+  Limb carry = 0;
+  for (int i = 0; i < NLimbs; ++i) {
+    DLimb t = static_cast<DLimb>(a[i]) + b[i] + carry;
+    s[i] = static_cast<Limb>(t);
+    carry = static_cast<Limb>(t >> LimbBits);
+  }
+  reduceOnce(r, s, carry, kP);
+}
+
+void
+feSub(Fe& r, const Fe& a, const Fe& b)
+{
+  Fe d;
+  Limb borrow = 0;
+  for (int i = 0; i < NLimbs; ++i) {
+    DLimb t = static_cast<DLimb>(a[i]) - b[i] - borrow;
+    d[i] = static_cast<Limb>(t);
+    borrow = static_cast<Limb>(t >> LimbBits) & 1;
+  }
+  // add p back if the subtraction wrapped around
+  Limb mask = static_cast<Limb>(0) - borrow;
+  Limb carry = 0;
+  for (int i = 0; i < NLimbs; ++i) {
+    DLimb t = static_cast<DLimb>(d[i]) + (kP[i] & mask) + carry;
+    r[i] = static_cast<Limb>(t);
+    carry = static_cast<Limb>(t >> LimbBits);
+  }
+}
+
+/**
+ * @brief Montgomery multiplication r = a * b / R mod p (CIOS method).
+ *
+ * Since p = -1 mod 2^LimbBits, the Montgomery quotient digit is the low limb itself.
+ */
+void
+feMul(Fe& r, const Fe& a, const Fe& b)
+{
+  Limb t[NLimbs + 2] = {};
+  for (int i = 0; i < NLimbs; ++i) {
+    DLimb c = 0;
+    for (int j = 0; j < NLimbs; ++j) {
+      c = static_cast<DLimb>(t[j]) + static_cast<DLimb>(a[j]) * b[i] + (c >> LimbBits);
+      t[j] = static_cast<Limb>(c);
+    }
+    c = static_cast<DLimb>(t[NLimbs]) + (c >> LimbBits);
+    t[NLimbs] = static_cast<Limb>(c);
+    t[NLimbs + 1] = static_cast<Limb>(c >> LimbBits);
+
+    Limb q = t[0];
+    c = static_cast<DLimb>(t[0]) + static_cast<DLimb>(q) * kP[0];
+    for (int j = 1; j < NLimbs; ++j) {
+      c = static_cast<DLimb>(t[j]) + static_cast<DLimb>(q) * kP[j] + (c >> LimbBits);
+      t[j - 1] = static_cast<Limb>(c);
+    }
+    c = static_cast<DLimb>(t[NLimbs]) + (c >> LimbBits);
+    t[NLimbs - 1] = static_cast<Limb>(c);
+    t[NLimbs] = t[NLimbs + 1] + static_cast<Limb>(c >> LimbBits);
+  }
+
+  Fe lo;
+  std::copy_n(t, NLimbs, lo.begin());
+  reduceOnce(r, lo, t[NLimbs], kP);
+}
+
+/** @brief r = a^(p-2) = a^-1 in Montgomery form; the exponent is public. */
+void
+feInv(Fe& r, const Fe& a)
+{
+  Fe e = kP;
+  e[0] -= 2;
+  Fe acc = kOne;
+  for (int i = 255; i >= 0; --i) {
+    feMul(acc, acc, acc);
+    if (bit(e, i)) {
+      feMul(acc, acc, a);
+    }
+  }
+  r = acc;
+}
+
+/** @brief r = a^((p+1)/4), a square root of a if one exists; the exponent is public. */
+void
+feSqrt(Fe& r, const Fe& a)
+{
+  // p = 3 mod 4, so the exponent is p + 1 shifted right by 2 bits
+  Fe e = kP;
+  Limb carry = 1;
+  for (int i = 0; i < NLimbs; ++i) {
+    e[i] += carry;
+    carry &= static_cast<Limb>(e[i] == 0);
+  }
+  Fe acc = kOne;
+  for (int i = 255; i >= 2; --i) {
+    feMul(acc, acc, acc);
+    if (bit(e, i)) {
+      feMul(acc, acc, a);
+    }
+  }
+  r = acc;
+}
+
+void
+feToMont(Fe& r, const Fe& a)
+{
+  feMul(r, a, kR2);
+}
+
+void
+feFromMont(Fe& r, const Fe& a)
+{
+  Fe one{};
+  one[0] = 1;
+  feMul(r, a, one);
+}
+
+void
+pointSetZero(Point& P)
+{
+  P.X.fill(0);
+  P.Y = kOne;
+  P.Z.fill(0);
+}
+
+/** @brief Complete point doubling for a = -3 (Renes-Costello-Batina, algorithm 6). */
+void
+pointDbl(Point& R, const Point& P)
+{
+  Fe t0, t1, t2, t3, X3, Y3, Z3;
+  feMul(t0, P.X, P.X);
+  feMul(t1, P.Y, P.Y);
+  feMul(t2, P.Z, P.Z);
+  feMul(t3, P.X, P.Y);
+  feAdd(t3, t3, t3);
+  feMul(Z3, P.X, P.Z);
+  feAdd(Z3, Z3, Z3);
+  feMul(Y3, kB, t2);
+  feSub(Y3, Y3, Z3);
+  feAdd(X3, Y3, Y3);
+  feAdd(Y3, X3, Y3);
+  feSub(X3, t1, Y3);
+  feAdd(Y3, t1, Y3);
+  feMul(Y3, X3, Y3);
+  feMul(X3, X3, t3);
+  feAdd(t3, t2, t2);
+  feAdd(t2, t2, t3);
+  feMul(Z3, kB, Z3);
+  feSub(Z3, Z3, t2);
+  feSub(Z3, Z3, t0);
+  feAdd(t3, Z3, Z3);
+  feAdd(Z3, Z3, t3);
+  feAdd(t3, t0, t0);
+  feAdd(t0, t3, t0);
+  feSub(t0, t0, t2);
+  feMul(t0, t0, Z3);
+  feAdd(Y3, Y3, t0);
+  feMul(t0, P.Y, P.Z);
+  feAdd(t0, t0, t0);
+  feMul(Z3, t0, Z3);
+  feSub(X3, X3, Z3);
+  feMul(Z3, t0, t1);
+  feAdd(Z3, Z3, Z3);
+  feAdd(Z3, Z3, Z3);
+  R.X = X3;
+  R.Y = Y3;
+  R.Z = Z3;
+}
+
+/** @brief r = table[index], reading every entry. */
+void
+pointSelect(Point& r, const Point table[16], unsigned index)
+{
+  r = Point{};
+  for (unsigned j = 0; j < 16; ++j) {
+    Limb mask = ~maskNonZero(j ^ index);
+    for (int i = 0; i < NLimbs; ++i) {
+      r.X[i] |= table[j].X[i] & mask;
+      r.Y[i] |= table[j].Y[i] & mask;
+      r.Z[i] |= table[j].Z[i] & mask;
+    }
+  }
+}
+
+/**
+ * @brief Encode P in uncompressed SEC1 format, given zInv = 1/Z.
+ *
+ * The point at infinity is encoded as a single zero octet, in the same way as mbedtls.
+ */
+void
+writeAffine(uint8_t output[65], size_t* len, const Point& P, const Fe& zInv)
+{
+  if (isZero(P.Z)) {
+    output[0] = 0x00;
+    *len = 1;
+    return;
+  }
+
+  Fe x, y;
+  feMul(x, P.X, zInv);
+  feFromMont(x, x);
+  feMul(y, P.Y, zInv);
+  feFromMont(y, y);
+
+  output[0] = 0x04;
+  toBytesBE(&output[1], x);
+  toBytesBE(&output[33], y);
+  *len = 65;
+}
+
+/** @brief Return column i of the comb, i.e. bits i, 64+i, 128+i, 192+i of k. */
+unsigned
+combDigit(const Scalar& k, int i)
+{
+  return bit(k, i) | (bit(k, 64 + i) << 1) | (bit(k, 128 + i) << 2) | (bit(k, 192 + i) << 3);
+}
+
+} // namespace
+
+void
+scalarReduce(Scalar& k, const uint8_t* input, size_t len)
+{
+  reduceBytes(k, input, len, kN);
+}
+
+void
+scalarWrite(uint8_t output[32], const Scalar& k)
+{
+  toBytesBE(output, k);
+}
+
+bool
+scalarIsZero(const Scalar& k)
+{
+  return isZero(k);
+}
+
+bool
+pointRead(Point& P, const uint8_t* input, size_t len)
+{
+  bool compressed = len == 33 && (input[0] == 0x02 || input[0] == 0x03);
+  if (!compressed && (len != 65 || input[0] != 0x04)) {
+    return false;
+  }
+
+  Fe x;
+  fromBytesBE(x, &input[1]);
+  if (!lessThan(x, kP)) {
+    return false;
+  }
+  feToMont(P.X, x);
+  P.Z = kOne;
+
+  // rhs = x^3 - 3x + b
+  Fe rhs, t;
+  feMul(rhs, P.X, P.X);
+  feMul(rhs, rhs, P.X);
+  feAdd(t, P.X, P.X);
+  feAdd(t, t, P.X);
+  feSub(rhs, rhs, t);
+  feAdd(rhs, rhs, kB);
+
+  if (compressed) {
+    // y is the square root of rhs with the parity given by the prefix
+    Fe y;
+    feSqrt(P.Y, rhs);
+    feFromMont(y, P.Y);
+    if ((y[0] & 0x01) != (input[0] & 0x01)) {
+      Fe zero{};
+      feSub(P.Y, zero, P.Y);
+    }
+  } else {
+    Fe y;
+    fromBytesBE(y, &input[33]);
+    if (!lessThan(y, kP)) {
+      return false;
+    }
+    feToMont(P.Y, y);
+  }
+
+  // check y^2 = x^3 - 3x + b, which fails if rhs has no square root
+  Fe lhs;
+  feMul(lhs, P.Y, P.Y);
+  return isEqual(lhs, rhs);
+}
+
+void
+pointWrite(uint8_t output[65], size_t* len, const Point& P)
+{
+  Fe zInv;
+  feInv(zInv, P.Z);
+  writeAffine(output, len, P, zInv);
+}
+
+void
+pointWriteBatch(uint8_t* const output[], size_t len[], const Point P[], size_t n)
+{
+  for (size_t first = 0; first < n; first += WriteBatchChunk) {
+    size_t count = std::min<size_t>(WriteBatchChunk, n - first);
+    const Point* Q = &P[first];
+
+    // prefix[i] = Z[0] * ... * Z[i], where the Z of the point at infinity counts as 1
+    Fe prefix[WriteBatchChunk];
+    for (size_t i = 0; i < count; ++i) {
+      const Fe& z = pointIsZero(Q[i]) ? kOne : Q[i].Z;
+      if (i == 0) {
+        prefix[i] = z;
+      } else {
+        feMul(prefix[i], prefix[i - 1], z);
+      }
+    }
+
+    // Montgomery's trick: walk back from the inverse of the product
+    Fe inv, zInv;
+    feInv(inv, prefix[count - 1]);
+    for (size_t i = count - 1; i > 0; --i) {
+      feMul(zInv, inv, prefix[i - 1]);
+      feMul(inv, inv, pointIsZero(Q[i]) ? kOne : Q[i].Z);
+      writeAffine(output[first + i], &len[first + i], Q[i], zInv);
+    }
+    writeAffine(output[first], &len[first], Q[0], inv);
+  }
+}
+
+bool
+pointIsZero(const Point& P)
+{
+  return isZero(P.Z);
+}
+
+/** @brief Complete point addition for a = -3 (Renes-Costello-Batina, algorithm 4). */
+void
+pointAdd(Point& R, const Point& P, const Point& Q)
+{
+  Fe t0, t1, t2, t3, t4, X3, Y3, Z3;
+  feMul(t0, P.X, Q.X);
+  feMul(t1, P.Y, Q.Y);
+  feMul(t2, P.Z, Q.Z);
+  feAdd(t3, P.X, P.Y);
+  feAdd(t4, Q.X, Q.Y);
+  feMul(t3, t3, t4);
+  feAdd(t4, t0, t1);
+  feSub(t3, t3, t4);
+  feAdd(t4, P.Y, P.Z);
+  feAdd(X3, Q.Y, Q.Z);
+  feMul(t4, t4, X3);
+  feAdd(X3, t1, t2);
+  feSub(t4, t4, X3);
+  feAdd(X3, P.X, P.Z);
+  feAdd(Y3, Q.X, Q.Z);
+  feMul(X3, X3, Y3);
+  feAdd(Y3, t0, t2);
+  feSub(Y3, X3, Y3);
+  feMul(Z3, kB, t2);
+  feSub(X3, Y3, Z3);
+  feAdd(Z3, X3, X3);
+  feAdd(X3, X3, Z3);
+  feSub(Z3, t1, X3);
+  feAdd(X3, t1, X3);
+  feMul(Y3, kB, Y3);
+  feAdd(t1, t2, t2);
+  feAdd(t2, t1, t2);
+  feSub(Y3, Y3, t2);
+  feSub(Y3, Y3, t0);
+  feAdd(t1, Y3, Y3);
+  feAdd(Y3, t1, Y3);
+  feAdd(t1, t0, t0);
+  feAdd(t0, t1, t0);
+  feSub(t0, t0, t2);
+  feMul(t1, t4, Y3);
+  feMul(t2, t0, Y3);
+  feMul(Y3, X3, Z3);
+  feAdd(Y3, Y3, t2);
+  feMul(X3, t3, X3);
+  feSub(X3, X3, t1);
+  feMul(Z3, t4, Z3);
+  feMul(t1, t3, t0);
+  feAdd(Z3, Z3, t1);
+  R.X = X3;
+  R.Y = Y3;
+  R.Z = Z3;
+}
+
+void
+pointSub(Point& R, const Point& P, const Point& Q)
+{
+  Point negQ = Q;
+  feSub(negQ.Y, Fe{}, Q.Y);
+  pointAdd(R, P, negQ);
+}
+
+void
+pointMul(Point& R, const Scalar& k, const Point& P)
+{
+  pointMulRange(R, k, P, 0, MulIterations);
+}
+
+void
+pointMulBase(Point& R, Base base, const Scalar& k)
+{
+  pointMulBaseRange(R, base, k, 0, MulIterations);
+}
+
+void
+pointMulBase2(Point& R, Base base1, const Scalar& k1, Base base2, const Scalar& k2)
+{
+  pointMulBase2Range(R, base1, k1, base2, k2, 0, MulIterations);
+}
+
+void
+pointMulRange(Point& acc, const Scalar& k, const Point& P, int begin, int end)
+{
+  // T[j] = j * P
+  Point T[16];
+  pointSetZero(T[0]);
+  T[1] = P;
+  for (int j = 2; j < 16; ++j) {
+    pointAdd(T[j], T[j - 1], P);
+  }
+
+  // fixed 4-bit windows, most significant first
+  if (begin == 0) {
+    pointSetZero(acc);
+  }
+  Point t;
+  for (int n = begin; n < end; ++n) {
+    int w = MulIterations - 1 - n;
+    for (int i = 0; i < 4; ++i) {
+      pointDbl(acc, acc);
+    }
+    unsigned d = static_cast<unsigned>(k[4 * w / LimbBits] >> (4 * w % LimbBits)) & 0x0F;
+    pointSelect(t, T, d);
+    pointAdd(acc, acc, t);
+  }
+}
+
+void
+pointMulBaseRange(Point& acc, Base base, const Scalar& k, int begin, int end)
+{
+  const Point* T = combTables[base];
+  if (begin == 0) {
+    pointSetZero(acc);
+  }
+  Point t;
+  for (int n = begin; n < end; ++n) {
+    pointDbl(acc, acc);
+    pointSelect(t, T, combDigit(k, MulIterations - 1 - n));
+    pointAdd(acc, acc, t);
+  }
+}
+
+void
+pointMulBase2Range(Point& acc, Base base1, const Scalar& k1, Base base2, const Scalar& k2,
+                   int begin, int end)
+{
+  // both combs share the doublings
+  const Point* T1 = combTables[base1];
+  const Point* T2 = combTables[base2];
+  if (begin == 0) {
+    pointSetZero(acc);
+  }
+  Point t;
+  for (int n = begin; n < end; ++n) {
+    int i = MulIterations - 1 - n;
+    pointDbl(acc, acc);
+    pointSelect(t, T1, combDigit(k1, i));
+    pointAdd(acc, acc, t);
+    pointSelect(t, T2, combDigit(k2, i));
+    pointAdd(acc, acc, t);
+  }
+}
+
+} // namespace p256_native
+} // namespace spake2
+
+#endif // PION_SPAKE2_P256_NATIVE
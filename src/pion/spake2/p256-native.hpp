@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: NIST-PD
+
+#ifndef PION_SPAKE2_P256_NATIVE_HPP
+#define PION_SPAKE2_P256_NATIVE_HPP
+
+#include "limbs.hpp"
+
+/**
+ * @brief Whether SPAKE2-P256 uses the native fixed-limb backend instead of mbedtls.
+ *
+ * It is enabled by default. Define this macro to 0 to select the mbedtls reference backend.
+ */
+#ifndef PION_SPAKE2_P256_NATIVE
+#define PION_SPAKE2_P256_NATIVE 1
+#endif
+
+namespace spake2 {
+namespace p256_native {
+
+/** @brief Integer modulo p or n. */
+using Fe = limbs::U256;
+
+/** @brief Scalar in range [0, n-1]. */
+using Scalar = Fe;
+
+/** @brief Point in projective coordinates (X:Y:Z), with field elements in Montgomery form. */
+struct Point
+{
+  Fe X;
+  Fe Y;
+  Fe Z;
+};
+
+enum
+{
+  /** @brief Number of loop iterations in each scalar multiplication. */
+  MulIterations = 64,
+  /** @brief Number of points that share a field inversion in pointWriteBatch(). */
+  WriteBatchChunk = 16,
+};
+
+/** @brief Fixed bases with precomputed tables. */
+enum Base
+{
+  BaseG,
+  BaseM,
+  BaseN,
+};
+
+/**
+ * @brief Comb tables of the fixed bases, indexed by Base.
+ *
+ * For base B, T[d] = sum of 2^(64j) * B for each bit j set in d, so that the scalar can be
+ * processed in 64 steps of one doubling and one addition. They are generated by
+ * mk/spake2-native-tables.py and constant-initialized, so that they stay in flash.
+ */
+extern const Point combTables[3][16];
+
+/** @brief Set k = input mod n, where input is a big endian integer of any length. */
+void
+scalarReduce(Scalar& k, const uint8_t* input, size_t len);
+
+/** @brief Write k as 32 octets big endian. */
+void
+scalarWrite(uint8_t output[32], const Scalar& k);
+
+bool
+scalarIsZero(const Scalar& k);
+
+/**
+ * @brief Decode a point in uncompressed (65 octets) or compressed (33 octets) SEC1 format.
+ * @return whether the encoding is valid and the point is on the curve.
+ */
+bool
+pointRead(Point& P, const uint8_t* input, size_t len);
+
+/**
+ * @brief Encode a point in uncompressed SEC1 format.
+ *
+ * The point at infinity is encoded as a single zero octet, in the same way as mbedtls.
+ */
+void
+pointWrite(uint8_t output[65], size_t* len, const Point& P);
+
+/**
+ * @brief Encode n points as pointWrite() does, sharing one field inversion among every
+ *        WriteBatchChunk points (Montgomery's trick).
+ * @param[out] output output buffers, 65 octets each.
+ * @param[out] len encoded lengths.
+ */
+void
+pointWriteBatch(uint8_t* const output[], size_t len[], const Point P[], size_t n);
+
+bool
+pointIsZero(const Point& P);
+
+/** @brief R = P + Q. */
+void
+pointAdd(Point& R, const Point& P, const Point& Q);
+
+/** @brief R = P - Q. */
+void
+pointSub(Point& R, const Point& P, const Point& Q);
+
+/** @brief R = k * P, in constant time. */
+void
+pointMul(Point& R, const Scalar& k, const Point& P);
+
+/** @brief R = k * base, in constant time, using the comb table of base. */
+void
+pointMulBase(Point& R, Base base, const Scalar& k);
+
+/** @brief R = k1 * base1 + k2 * base2, in constant time, sharing doublings between both combs. */
+void
+pointMulBase2(Point& R, Base base1, const Scalar& k1, Base base2, const Scalar& k2);
+
+/**
+ * @brief Perform loop iterations [begin, end) of pointMul(), updating the accumulator acc.
+ *
+ * acc is set to the identity when begin is 0. Running all MulIterations iterations, in one or
+ * more calls, yields acc = k * P. Each call rebuilds the window table of P.
+ */
+void
+pointMulRange(Point& acc, const Scalar& k, const Point& P, int begin, int end);
+
+/** @brief Perform loop iterations [begin, end) of pointMulBase(), see pointMulRange(). */
+void
+pointMulBaseRange(Point& acc, Base base, const Scalar& k, int begin, int end);
+
+/** @brief Perform loop iterations [begin, end) of pointMulBase2(), see pointMulRange(). */
+void
+pointMulBase2Range(Point& acc, Base base1, const Scalar& k1, Base base2, const Scalar& k2,
+                   int begin, int end);
+
+} // namespace p256_native
+} // namespace spake2
+
+#endif // PION_SPAKE2_P256_NATIVE_HPP
@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: NIST-PD
+// Generated by mk/spake2-tables.py, do not edit.
+
+#include "spake2.hpp"
+
+#include <cstddef>
+
+#if PION_SPAKE2_ROM_TABLES
+
+#if defined(MBEDTLS_HAVE_INT64)
+#define PION_LIMB(lo, hi) ((static_cast<mbedtls_mpi_uint>(hi) << 32) | (lo))
+#else
+#define PION_LIMB(lo, hi) (lo), (hi)
+#endif
+
+#define PION_MPI(l)                                                                                \
+  {                                                                                                \
+    1, sizeof(l) / sizeof(mbedtls_mpi_uint), const_cast<mbedtls_mpi_uint*>(l)                      \
+  }
+#define PION_POINT(b, i)                                                                           \
+  {                                                                                                \
+    PION_MPI(limbs[b][i][0]), PION_MPI(limbs[b][i][1]), PION_MPI(one)                              \
+  }
+
+namespace spake2 {
+namespace detail {
+
+// PION_MPI() initializes the fields of mbedtls_mpi in the order of mbedtls 2.x: s, n, p
+static_assert(offsetof(mbedtls_mpi, MBEDTLS_PRIVATE(s)) == 0 &&
+                offsetof(mbedtls_mpi, MBEDTLS_PRIVATE(n)) <
+                  offsetof(mbedtls_mpi, MBEDTLS_PRIVATE(p)),
+              "mbedtls_mpi layout is not supported, define PION_SPAKE2_ROM_TABLES=0");
+static_assert(CombTables<P256>::Size == 16, "");
+
+static const mbedtls_mpi_uint one[] = { 1 };
+
+// clang-format off
+static const mbedtls_mpi_uint limbs[3][16][2][32 / sizeof(mbedtls_mpi_uint)] = {
+  // G
+  {
+    { { PION_LIMB(0xD898C296, 0xF4A13945), PION_LIMB(0x2DEB33A0, 0x77037D81),
+        PION_LIMB(0x63A440F2, 0xF8BCE6E5), PION_LIMB(0xE12C4247, 0x6B17D1F2) },
+      { PION_LIMB(0x37BF51F5, 0xCBB64068), PION_LIMB(0x6B315ECE, 0x2BCE3357),
+        PION_LIMB(0x7C0F9E16, 0x8EE7EB4A), PION_LIMB(0xFE1A7F9B, 0x4FE342E2) } },
+    { { PION_LIMB(0x04BAC870, 0xF7D24BB7), PION_LIMB(0x3A23C6AB, 0x593A09A0),
+        PION_LIMB(0xF94C9D1D, 0xDFCC2358), PION_LIMB(0x297BED02, 0x3CFA0F87) },
+      { PION_LIMB(0x40F26940, 0xCE98A30B), PION_LIMB(0x0248A8AF, 0x62121C0D),
+        PION_LIMB(0x8309AF9B, 0xA758AA80), PION_LIMB(0x70BE12C6, 0xE4E37694) } },
+    { { PION_LIMB(0x86EF7D7D, 0xDD37E3FF), PION_LIMB(0x088B86DB, 0xF6D77C27),
+        PION_LIMB(0x254C5491, 0x28FE9A4F), PION_LIMB(0x6DF0FD5E, 0xD6690337) },
+      { PION_LIMB(0xADDAD596, 0x9FF04992), PION_LIMB(0x9E4373F9, 0xF3D1A7AF),
+        PION_LIMB(0xDF074167, 0xA13E9578), PION_LIMB(0xE6D13D22, 0x20E2A53C) } },
+    { { PION_LIMB(0x525D6ABF, 0xAEBFD735), PION_LIMB(0x96BEA25A, 0xC302F8F4),
+        PION_LIMB(0x544920A4, 0xDB82B3EA), PION_LIMB(0x02EADB2E, 0x621C75D1) },
+      { PION_LIMB(0x9EF485F0, 0x8939DC4C), PION_LIMB(0x57C46D63, 0x225D03D8),
+        PION_LIMB(0x522D7F70, 0x4FDAC96F), PION_LIMB(0xB4FA649D, 0xD7C4A4FE) } },
+    { { PION_LIMB(0xC0B9372A, 0x8BC659AA), PION_LIMB(0xEDD9583F, 0xF7659958),
+        PION_LIMB(0x8C267D88, 0x9F05F94A), PION_LIMB(0xC99A739D, 0x00DC46E7) },
+      { PION_LIMB(0xDF55D0F2, 0x4AF50A00), PION_LIMB(0x8156BF6A, 0xB5EB202D),
+        PION_LIMB(0x5228C111, 0x40D1E3AB), PION_LIMB(0x45793424, 0x0312A557) } },
+    { { PION_LIMB(0x7EB8CFEE, 0x8D9692F7), PION_LIMB(0x0D8C013D, 0x05E3F223),
+        PION_LIMB(0x84E32E59, 0x76347A52), PION_LIMB(0x15B0A1E5, 0x3C53E290) },
+      { PION_LIMB(0xFAE798D4, 0x538B7DA5), PION_LIMB(0x00D23591, 0x1B9F1BD1),
+        PION_LIMB(0x9A08693F, 0x11A9F072), PION_LIMB(0x140EFEB3, 0xD30E7CDA) } },
+    { { PION_LIMB(0xF8E8F683, 0x6DFCF787), PION_LIMB(0x3F7FBE90, 0x13D72B7A),
+        PION_LIMB(0x2DF232CF, 0xFD426D94), PION_LIMB(0x5FE39AAD, 0xED84BB42) },
+      { PION_LIMB(0x732995FC, 0x023E67A1), PION_LIMB(0x355430E3, 0x67DD0A8E),
+        PION_LIMB(0x97A1D703, 0x0CF83B61), PION_LIMB(0x583C33F2, 0xA3233455) } },
+    { { PION_LIMB(0x5F165D99, 0xCEBBBC7B), PION_LIMB(0x8A4EEE61, 0x50CC51C1),
+        PION_LIMB(0x1B4D0D1F, 0xB31D2353), PION_LIMB(0x66382ADA, 0x95E18452) },
+      { PION_LIMB(0x0A839B5B, 0xACAD4F81), PION_LIMB(0x4142FF0F, 0xA0A2A96E),
+        PION_LIMB(0x1F4FA12F, 0x3EAA8289), PION_LIMB(0x6B0FB8F3, 0x68D68C8F) } },
+    { { PION_LIMB(0x51BBB3F1, 0x9311A269), PION_LIMB(0x8D0F4F65, 0xE80F26BD),
+        PION_LIMB(0x6BECCBB9, 0x9D3DC334), PION_LIMB(0x101E5DE4, 0x54E244D5) },
+      { PION_LIMB(0xF1B19E28, 0xB3AD4C6E), PION_LIMB(0x58C2E3B7, 0x4334FBC0),
+        PION_LIMB(0x35DF9C25, 0x19BD4107), PION_LIMB(0xEC106EB6, 0xD6BBEC0E) } },
+    { { PION_LIMB(0x3FEFCFC8, 0xE8881A83), PION_LIMB(0xB9B5290B, 0xAEA3C9E0),
+        PION_LIMB(0x771E4688, 0x10B37ECD), PION_LIMB(0xD4D021B6, 0xEE0816A3) },
+      { PION_LIMB(0xB3A8CAA1, 0x8E9929BF), PION_LIMB(0xC105F2D1, 0x48915DCF),
+        PION_LIMB(0xDB49019F, 0x3A5FDF82), PION_LIMB(0xAD9006E1, 0xC4A438E3) } },
+    { { PION_LIMB(0xE83AD2C9, 0x5D6DC503), PION_LIMB(0xAED035BE, 0xCA9F7A1D),
+        PION_LIMB(0xCBD21E33, 0x552788AC), PION_LIMB(0xE09CB9F0, 0x8699DD31) },
+      { PION_LIMB(0x329BF961, 0x38584196), PION_LIMB(0xB82A5AF9, 0x4CB20E96),
+        PION_LIMB(0xC72C78C1, 0x24199908), PION_LIMB(0xE92859B7, 0x16E65484) } },
+    { { PION_LIMB(0xDB3038DD, 0xA20A2C70), PION_LIMB(0xE99D5C7C, 0x5F0B46D5),
+        PION_LIMB(0x4B600B83, 0xC9B97D37), PION_LIMB(0x3DF3245E, 0x186C7F79) },
+      { PION_LIMB(0x4F1CE57F, 0x2AF72460), PION_LIMB(0x91E2D8ED, 0x9249897F),
+        PION_LIMB(0x8D2EA797, 0x8139B36A), PION_LIMB(0x9AB58913, 0x9C428DB8) } },
+    { { PION_LIMB(0x4BE6458D, 0x1F1E4F3F), PION_LIMB(0x595E6547, 0x5F72CC22),
+        PION_LIMB(0x271A93F1, 0x5BC5341E), PION_LIMB(0x58A5F263, 0xC62E155C) },
+      { PION_LIMB(0x58BA7FF4, 0x5F6F845A), PION_LIMB(0x7E36A6AD, 0x67E1F7DC),
+        PION_LIMB(0xEEAA4D04, 0xD33A7657), PION_LIMB(0x18267E4E, 0xFF9F2322) } },
+    { { PION_LIMB(0xC7644C1D, 0xE33F0255), PION_LIMB(0xBB9002D8, 0x4030ECC3),
+        PION_LIMB(0xF4646F9F, 0xA4486916), PION_LIMB(0x959C44FA, 0x5E677D0C) },
+      { PION_LIMB(0xD88B9144, 0xE2E7D7D0), PION_LIMB(0x6248F91F, 0x5D93A86F),
+        PION_LIMB(0x02993AEA, 0xE33D0BD5), PION_LIMB(0x3100D31E, 0x449F0CE6) } },
+    { { PION_LIMB(0xFDAAB256, 0x52DF1588), PION_LIMB(0x3127354C, 0x68C0CD44),
+        PION_LIMB(0xA591F853, 0x2A849471), PION_LIMB(0x93D0CB92, 0xE4DA88E9) },
+      { PION_LIMB(0x1639C624, 0x6D1EA35D), PION_LIMB(0x263707BA, 0x60FE2A36),
+        PION_LIMB(0xD0F3BC51, 0x97FC50DE), PION_LIMB(0x10062E80, 0xF7FA4D15) } },
+    { { PION_LIMB(0x5B696527, 0x2E75A266), PION_LIMB(0x5A00169C, 0x1A2530B0),
+        PION_LIMB(0x4286FB42, 0x76C4C180), PION_LIMB(0x8E831D5B, 0x825F0194) },
+      { PION_LIMB(0xEF703739, 0xDBF0A11F), PION_LIMB(0xCE5B106A, 0x106F9BC4),
+        PION_LIMB(0x24111150, 0x61794C4F), PION_LIMB(0xBC723A17, 0x435872FE) } },
+  },
+  // M
+  {
+    { { PION_LIMB(0x3D8FA12F, 0xAFD49733), PION_LIMB(0xF3DCAB95, 0x3B64E16E),
+        PION_LIMB(0x2579F299, 0xBA9DD724), PION_LIMB(0xACE46E55, 0x886E2F97) },
+      { PION_LIMB(0xA12E2D20, 0xCA547D55), PION_LIMB(0x19C785E0, 0x5C7BE094),
+        PION_LIMB(0xFF02AC8E, 0x4E0B0E65), PION_LIMB(0x3E43CE22, 0x5FF35516) } },
+    { { PION_LIMB(0x45A1C080, 0x1F810AF6), PION_LIMB(0x60DD0A66, 0xCD086708),
+        PION_LIMB(0x386C7559, 0xE64E7222), PION_LIMB(0xC68D2025, 0x976EF4C8) },
+      { PION_LIMB(0xAC648BB2, 0x8BA61C12), PION_LIMB(0x9110F285, 0xEE63AB64),
+        PION_LIMB(0x0686E77E, 0x89C45052), PION_LIMB(0x06ACFDC8, 0x8FF38255) } },
+    { { PION_LIMB(0x05A3BCBE, 0xEE1F7D8D), PION_LIMB(0xFB576E47, 0x67283EDF),
+        PION_LIMB(0xC8B34609, 0xCDCDC38C), PION_LIMB(0xD2F7782F, 0xFE6EF675) },
+      { PION_LIMB(0x7E3585D2, 0x9B56882C), PION_LIMB(0x15A7FF73, 0xB9465E23),
+        PION_LIMB(0x826DF526, 0x831E8EF0), PION_LIMB(0x7152F205, 0x498AA11E) } },
+    { { PION_LIMB(0x67DD5BC7, 0xAA70ABEB), PION_LIMB(0x5155DEFE, 0xF44C09F5),
+        PION_LIMB(0xFE93E7F2, 0xFC6FE15E), PION_LIMB(0x33937354, 0x96053DFD) },
+      { PION_LIMB(0x053FBF42, 0x793F49B5), PION_LIMB(0xF26D5990, 0x4D2FC012),
+        PION_LIMB(0x70072E83, 0xF1AA8DD0), PION_LIMB(0xCC0CA6E4, 0xA2E41562) } },
+    { { PION_LIMB(0x7D941AD6, 0xD1CE25C4), PION_LIMB(0xA91706A4, 0xC2E9BBD2),
+        PION_LIMB(0x441005A0, 0x082B16D5), PION_LIMB(0xED6F3629, 0xB44E395F) },
+      { PION_LIMB(0xBA87EECB, 0x67E3BA07), PION_LIMB(0x4E02ACEE, 0x45AE0A47),
+        PION_LIMB(0x559353C9, 0x88D2490F), PION_LIMB(0x2437E417, 0xA999FD79) } },
+    { { PION_LIMB(0xF8181A46, 0x66DE0632), PION_LIMB(0x06EB383B, 0x22AB5BEC),
+        PION_LIMB(0xBE770B7F, 0x2532F02E), PION_LIMB(0xE60B057C, 0x69FA71CD) },
+      { PION_LIMB(0xD3371940, 0xCA73431A), PION_LIMB(0x46C97FA7, 0xB0793926),
+        PION_LIMB(0x88271CCA, 0x547CC9D2), PION_LIMB(0x17E47005, 0xDDE9AEB1) } },
+    { { PION_LIMB(0x45D0D2A1, 0x3DAB2CE6), PION_LIMB(0x121EC7E0, 0x09A2C2CD),
+        PION_LIMB(0x25919769, 0xE5FE0890), PION_LIMB(0x072D15C8, 0x77C77857) },
+      { PION_LIMB(0xD79AD92C, 0xEA4D6946), PION_LIMB(0xCFFAD260, 0xAE33DC35),
+        PION_LIMB(0x96FC0E7E, 0xCFB0A053), PION_LIMB(0xD71240B1, 0x70DDDA5E) } },
+    { { PION_LIMB(0x5892892E, 0x814C4047), PION_LIMB(0x7A7119AA, 0x45B420C6),
+        PION_LIMB(0x5CDA60EC, 0xDDC53CC7), PION_LIMB(0xD734E5EF, 0x6280C2DB) },
+      { PION_LIMB(0xDD6615C9, 0x755F306E), PION_LIMB(0x158277F9, 0xE51AC3D6),
+        PION_LIMB(0xB7866AA2, 0x3496398A), PION_LIMB(0xBBE934A8, 0x45924020) } },
+    { { PION_LIMB(0x9EC6FCC6, 0xD004A3BB), PION_LIMB(0xA7C0DC0D, 0xCA46D925),
+        PION_LIMB(0x8BFA7FD5, 0x19B34E4A), PION_LIMB(0xAF983958, 0xC034C814) },
+      { PION_LIMB(0x253B6DB8, 0xD24AE8E6), PION_LIMB(0x21E05AA9, 0x8951C22A),
+        PION_LIMB(0xC326D7FE, 0xAE21FDEC), PION_LIMB(0xFADE6442, 0x519CF5D5) } },
+    { { PION_LIMB(0xD45B4728, 0x4FB6A3D6), PION_LIMB(0xBD29BF97, 0x3DB186D7),
+        PION_LIMB(0x9A23F739, 0x311DBDB6), PION_LIMB(0x890C347F, 0x0A463B4F) },
+      { PION_LIMB(0x58D52E94, 0x28AB8CF6), PION_LIMB(0x497D410F, 0xC6A615B8),
+        PION_LIMB(0x19FED48C, 0xCCBB0B93), PION_LIMB(0x9120433C, 0xA4976D1A) } },
+    { { PION_LIMB(0x1AF8D6F5, 0x3F672359), PION_LIMB(0x0B16DB28, 0x9A8BEDB3),
+        PION_LIMB(0xB8F94ACE, 0xEFC06731), PION_LIMB(0xED6F2A1E, 0x885E0EE6) },
+      { PION_LIMB(0x925492FB, 0xF9E6890F), PION_LIMB(0x1EBCC8B2, 0xC34B859D),
+        PION_LIMB(0xD84173D1, 0xE2170DCC), PION_LIMB(0xA360EA62, 0x3442EB7C) } },
+    { { PION_LIMB(0xC8E9BE04, 0xD5E695D3), PION_LIMB(0x35E222FD, 0x76C28DCC),
+        PION_LIMB(0x5B7C344C, 0xB48C7902), PION_LIMB(0x22440E6F, 0x4A20FD92) },
+      { PION_LIMB(0xE78CA6AD, 0x45FEEE5F), PION_LIMB(0x3F00013B, 0xD580547F),
+        PION_LIMB(0x638999E9, 0xE93C16B0), PION_LIMB(0x5F483B8F, 0x16D31B9F) } },
+    { { PION_LIMB(0x04434DC0, 0xA3C0FD42), PION_LIMB(0xDEC16168, 0x10C07AB0),
+        PION_LIMB(0xF7027136, 0xFEBA4E1C), PION_LIMB(0x29C8D42D, 0xE340024B) },
+      { PION_LIMB(0x9EAFD4CC, 0xD638DFF6), PION_LIMB(0xF07C9CB1, 0x72777FE4),
+        PION_LIMB(0x8277B025, 0xA84CB177), PION_LIMB(0xCDA06A04, 0xEA065006) } },
+    { { PION_LIMB(0xB531B8DF, 0x03A288AF), PION_LIMB(0x395DA8CE, 0x93AB22AA),
+        PION_LIMB(0xEAB0D598, 0xBC0293F1), PION_LIMB(0x17A39A9D, 0xDBA355F0) },
+      { PION_LIMB(0x1D293CAA, 0xF84D1459), PION_LIMB(0x1CCC9B65, 0xD6717865),
+        PION_LIMB(0x59E78CD6, 0x86C23D16), PION_LIMB(0xE5928B85, 0xDF5578C4) } },
+    { { PION_LIMB(0x8407C064, 0x365643C2), PION_LIMB(0x9DD3CED4, 0xF3B886B6),
+        PION_LIMB(0xA7CED82E, 0xBA1690B9), PION_LIMB(0xA1618E82, 0xA37874DB) },
+      { PION_LIMB(0xF0005745, 0xC6620808), PION_LIMB(0xE097B702, 0xF4A65D96),
+        PION_LIMB(0x9E66DDF2, 0x0014EF40), PION_LIMB(0x98779CC5, 0x039CDF20) } },
+    { { PION_LIMB(0x4378F2BD, 0xBDD7FD65), PION_LIMB(0xC01568C2, 0xBA377B48),
+        PION_LIMB(0x8DD7CE63, 0x396B92E1), PION_LIMB(0x3FDB1FA6, 0x7C572A9A) },
+      { PION_LIMB(0x94E31F18, 0xC34DB9AE), PION_LIMB(0xC24283FC, 0x7C6A752D),
+        PION_LIMB(0x2107E675, 0xF7F3F03A), PION_LIMB(0x55B66B81, 0x0090F38B) } },
+  },
+  // N
+  {
+    { { PION_LIMB(0xA1292B49, 0x4B4F98BA), PION_LIMB(0x014D49A2, 0x19C629D7),
+        PION_LIMB(0x38C37707, 0xB04D997F), PION_LIMB(0x39C62937, 0xD8BBD6C6) },
+      { PION_LIMB(0x656EDBE7, 0x64490B1E), PION_LIMB(0x34808CD5, 0x4D9BD360),
+        PION_LIMB(0x7F5168C6, 0x08A63633), PION_LIMB(0xBFADE450, 0x07D60AA6) } },
+    { { PION_LIMB(0x96D66883, 0x36A42BE7), PION_LIMB(0x6A304BB3, 0xA729B86C),
+        PION_LIMB(0xB3CAD5A1, 0x4333E52F), PION_LIMB(0xAE236C66, 0x9FA8CA21) },
+      { PION_LIMB(0x4C88C24E, 0xBED9626D), PION_LIMB(0xCAB59304, 0x4D9E7AE7),
+        PION_LIMB(0x65360F16, 0x66BFD67C), PION_LIMB(0xCAC1A32E, 0x325FE7C8) } },
+    { { PION_LIMB(0x479AF0C5, 0x6D3032AF), PION_LIMB(0xFEC5FD7A, 0x4FDB91E2),
+        PION_LIMB(0x6984F043, 0x63FF4766), PION_LIMB(0x7CB8D920, 0x7CA00B35) },
+      { PION_LIMB(0xA5356B05, 0x35A37C0B), PION_LIMB(0x978EE667, 0x3F582A0C),
+        PION_LIMB(0x829B6D25, 0x0597D041), PION_LIMB(0x3A54718C, 0x56AE7EE8) } },
+    { { PION_LIMB(0x5BB2B95C, 0xDD23451D), PION_LIMB(0xDFA68F6E, 0xD148E3EF),
+        PION_LIMB(0x0A7CDFD1, 0xA2722464), PION_LIMB(0x90A6BDD6, 0xE806B2BB) },
+      { PION_LIMB(0xA0D35C31, 0x8A097DCE), PION_LIMB(0xDEDC1733, 0x42D554C7),
+        PION_LIMB(0x6B024ACB, 0x07729CEB), PION_LIMB(0xA981AE44, 0x84F5ED9F) } },
+    { { PION_LIMB(0x91A944B4, 0x344EED13), PION_LIMB(0x4B88465E, 0x8736D965),
+        PION_LIMB(0x538E5B1C, 0xAC959914), PION_LIMB(0x5D475184, 0x9E3A7AA9) },
+      { PION_LIMB(0x1FC1D8E7, 0xF9424879), PION_LIMB(0x1EE0AAF3, 0xE25AA821),
+        PION_LIMB(0x0C265D99, 0xC2C0A9C6), PION_LIMB(0xE11514CC, 0xC72B9C93) } },
+    { { PION_LIMB(0x82FB2914, 0xCDBAA528), PION_LIMB(0x8912B92C, 0x35AF5FAC),
+        PION_LIMB(0x02D27C9E, 0x59A8F335), PION_LIMB(0xF3C56D4D, 0x38E23484) },
+      { PION_LIMB(0x41551D9F, 0xFF8F7FF6), PION_LIMB(0x47283FB5, 0x709723E9),
+        PION_LIMB(0x01A5EE3D, 0x169BD956), PION_LIMB(0x46EF12E1, 0x895E9BD0) } },
+    { { PION_LIMB(0x0FFF3E6D, 0x3FC5CE77), PION_LIMB(0x99CEC575, 0x8B3BB226),
+        PION_LIMB(0x26A9A7D2, 0x5EBFE69A), PION_LIMB(0x01A5A3B3, 0x7AFED0C6) },
+      { PION_LIMB(0xA87A4CEC, 0x1D3CF7A0), PION_LIMB(0xB05FF8E2, 0xF8135A5E),
+        PION_LIMB(0x875AE33E, 0x48C88AAC), PION_LIMB(0xC33264EE, 0xAC23DE9E) } },
+    { { PION_LIMB(0x392BCBD7, 0x76FC1350), PION_LIMB(0xB00791CF, 0xC90D3EF4),
+        PION_LIMB(0xF9E9BA09, 0x4FE1D7D3), PION_LIMB(0x6B416D68, 0xE822CB91) },
+      { PION_LIMB(0x97A1B5E7, 0x77B9F351), PION_LIMB(0xE1C9305F, 0x089F5DA4),
+        PION_LIMB(0xA3A36D49, 0xDEAEEF8F), PION_LIMB(0xACC4E64F, 0xC52BDAF0) } },
+    { { PION_LIMB(0x15C28812, 0xC123F47D), PION_LIMB(0x7DF64BC6, 0x76D11BBF),
+        PION_LIMB(0x141CFE56, 0x4A58538C), PION_LIMB(0x8133F762, 0x5CDCE701) },
+      { PION_LIMB(0xCDDBA577, 0x9ED16D87), PION_LIMB(0x3C9B2FEC, 0x0315A657),
+        PION_LIMB(0x85EED60E, 0x2EF35525), PION_LIMB(0x7B68AF94, 0xB0AF389C) } },
+    { { PION_LIMB(0x02C21C57, 0x6868BBCD), PION_LIMB(0xFA3BB665, 0xE774FFA2),
+        PION_LIMB(0x33C4DE9F, 0xCA09D323), PION_LIMB(0x62159CB9, 0x19865AAC) },
+      { PION_LIMB(0xFA814D87, 0xCDD82F4C), PION_LIMB(0xA768D105, 0xEA48F553),
+        PION_LIMB(0x9BCCFC9E, 0x3025842B), PION_LIMB(0xDECEEF6E, 0xE3833E49) } },
+    { { PION_LIMB(0xFA64B9BA, 0x692C8FC1), PION_LIMB(0x763D4D89, 0x259BEBC5),
+        PION_LIMB(0x949E648B, 0xBC60719A), PION_LIMB(0x0843FA1F, 0xFB514329) },
+      { PION_LIMB(0x4C6E4A95, 0xF8861405), PION_LIMB(0xD5294CEA, 0x6D5B0D2C),
+        PION_LIMB(0xF81753C8, 0xFF64EAF3), PION_LIMB(0x71455120, 0x8A928037) } },
+    { { PION_LIMB(0x4CBCCDF9, 0x6BAE9DFE), PION_LIMB(0x8564F1CF, 0x4B7AB550),
+        PION_LIMB(0xDC797B88, 0x02391F2A), PION_LIMB(0xF8085846, 0x2DB78DFE) },
+      { PION_LIMB(0xBE87D1D6, 0x77F95681), PION_LIMB(0x45563DAA, 0x5EA4A908),
+        PION_LIMB(0x10BFAE88, 0x7B776358), PION_LIMB(0x9CB30407, 0xCBC6D12A) } },
+    { { PION_LIMB(0xB8BCD4BD, 0x8CCF8E91), PION_LIMB(0xCB216669, 0x1955D86A),
+        PION_LIMB(0x6B4E95C6, 0x33439270), PION_LIMB(0x343BECBA, 0x8352DFD2) },
+      { PION_LIMB(0xE5F8F075, 0xCC856DBE), PION_LIMB(0x40F7C9EB, 0x8EF094C3),
+        PION_LIMB(0x5F352689, 0xEE11F432), PION_LIMB(0x0DBB1523, 0xC41B788A) } },
+    { { PION_LIMB(0x3553FA31, 0x7E44923A), PION_LIMB(0x2734D84C, 0xD332C3D4),
+        PION_LIMB(0x87D1BCFD, 0x8C2A7F89), PION_LIMB(0xE64943C8, 0x50DBBBEA) },
+      { PION_LIMB(0xE4116499, 0xF0536763), PION_LIMB(0xA5912185, 0x96D3D2F1),
+        PION_LIMB(0x6015AE23, 0x3031B72D), PION_LIMB(0xDB04ECF3, 0x83ECAE13) } },
+    { { PION_LIMB(0x9F03BC16, 0x16BAF2D2), PION_LIMB(0x846241A0, 0xC4A7E0A0),
+        PION_LIMB(0xF5C4E157, 0xC97F0265), PION_LIMB(0xD4FE12D5, 0xC62359EA) },
+      { PION_LIMB(0x183E0CDB, 0x00E21C57), PION_LIMB(0x620D3C77, 0x4BD3117A),
+        PION_LIMB(0xE8464D7E, 0xB5193CE1), PION_LIMB(0x4BD35C76, 0xD4EB77EE) } },
+    { { PION_LIMB(0xF752E4E0, 0xFF67816F), PION_LIMB(0xE2C053FF, 0x6C02F46D),
+        PION_LIMB(0xEA3C55E7, 0x3226A23E), PION_LIMB(0xBE4C5B95, 0x86EF3167) },
+      { PION_LIMB(0x17CB3BB3, 0xBEC49CC3), PION_LIMB(0x5CD93DC0, 0xE3A53965),
+        PION_LIMB(0x2F4E97D9, 0x8F3ADC71), PION_LIMB(0x6DEA4416, 0xBD26B397) } },
+  },
+};
+
+static const mbedtls_ecp_point tableG[] = {
+  PION_POINT(0, 0),
+  PION_POINT(0, 1),
+  PION_POINT(0, 2),
+  PION_POINT(0, 3),
+  PION_POINT(0, 4),
+  PION_POINT(0, 5),
+  PION_POINT(0, 6),
+  PION_POINT(0, 7),
+  PION_POINT(0, 8),
+  PION_POINT(0, 9),
+  PION_POINT(0, 10),
+  PION_POINT(0, 11),
+  PION_POINT(0, 12),
+  PION_POINT(0, 13),
+  PION_POINT(0, 14),
+  PION_POINT(0, 15),
+};
+
+static const mbedtls_ecp_point tableM[] = {
+  PION_POINT(1, 0),
+  PION_POINT(1, 1),
+  PION_POINT(1, 2),
+  PION_POINT(1, 3),
+  PION_POINT(1, 4),
+  PION_POINT(1, 5),
+  PION_POINT(1, 6),
+  PION_POINT(1, 7),
+  PION_POINT(1, 8),
+  PION_POINT(1, 9),
+  PION_POINT(1, 10),
+  PION_POINT(1, 11),
+  PION_POINT(1, 12),
+  PION_POINT(1, 13),
+  PION_POINT(1, 14),
+  PION_POINT(1, 15),
+};
+
+static const mbedtls_ecp_point tableN[] = {
+  PION_POINT(2, 0),
+  PION_POINT(2, 1),
+  PION_POINT(2, 2),
+  PION_POINT(2, 3),
+  PION_POINT(2, 4),
+  PION_POINT(2, 5),
+  PION_POINT(2, 6),
+  PION_POINT(2, 7),
+  PION_POINT(2, 8),
+  PION_POINT(2, 9),
+  PION_POINT(2, 10),
+  PION_POINT(2, 11),
+  PION_POINT(2, 12),
+  PION_POINT(2, 13),
+  PION_POINT(2, 14),
+  PION_POINT(2, 15),
+};
+
+// clang-format on
+
+const mbedtls_ecp_point*
+CombTables<P256>::get(int base)
+{
+  static const mbedtls_ecp_point* const tables[] = { tableG, tableM, tableN };
+  return tables[base];
+}
+
+} // namespace detail
+} // namespace spake2
+
+#endif // PION_SPAKE2_ROM_TABLES
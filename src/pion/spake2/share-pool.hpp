@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: NIST-PD
+
+#ifndef PION_SPAKE2_SHARE_POOL_HPP
+#define PION_SPAKE2_SHARE_POOL_HPP
+
+#include "spake2.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spake2 {
+
+/**
+ * @brief Pool of ephemeral SPAKE2 shares (x, x * P), filled by a background thread.
+ *
+ * A Context constructed with a pool takes its random scalar x and x * P from the pool, so that
+ * its public share only costs w * (M|N) and a point addition. Each share is handed out once and
+ * is erased from the pool when taken. When the pool is empty, the Context draws x itself.
+ * take() may be called from any thread. If generating a share fails, e.g. because a DRBG reseed
+ * finds no entropy, the refill thread retries with exponential back-off. The pool needs
+ * std::thread, so that it is only available when PION_SPAKE2_SHARE_POOL is enabled.
+ */
+template<typename Group>
+class SharePool
+{
+public:
+  struct Share
+  {
+    std::array<uint8_t, Group::ScalarSize> x;
+    std::array<uint8_t, Group::UncompressedPointSize> xP;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param depth number of shares kept ready.
+   *
+   * The refill thread starts immediately, and draws randomness from its own Drbg::forThread().
+   */
+  explicit SharePool(size_t depth)
+    : m_shares(depth)
+    , m_thread(&SharePool::refill, this)
+  {}
+
+  ~SharePool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+    mbedtls_platform_zeroize(m_shares.data(), m_shares.size() * sizeof(Share));
+  }
+
+  SharePool(const SharePool&) = delete;
+  SharePool& operator=(const SharePool&) = delete;
+
+  /**
+   * @brief Take a share out of the pool.
+   * @param[out] share the share; the caller should zeroize it after use.
+   * @return whether a share was available.
+   */
+  bool take(Share& share) noexcept
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_count == 0) {
+        ++m_misses;
+        return false;
+      }
+      Share& top = m_shares[--m_count];
+      share = top;
+      mbedtls_platform_zeroize(&top, sizeof(top));
+      ++m_hits;
+    }
+    m_cv.notify_one();
+    return true;
+  }
+
+  /** @brief Return the number of take() calls that obtained a share. */
+  uint64_t getHits() const noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+  }
+
+  /** @brief Return the number of take() calls that found the pool empty. */
+  uint64_t getMisses() const noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+  }
+
+private:
+  void refill() noexcept
+  {
+    Drbg& drbg = Drbg::forThread();
+    typename detail::BackendOf<Group>::type backend;
+    std::chrono::milliseconds backoff(MinBackoffMs);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop) {
+      if (m_count == m_shares.size()) {
+        m_cv.wait(lock);
+        continue;
+      }
+
+      lock.unlock();
+      Share share;
+      bool ok = generate(backend, drbg, share);
+      lock.lock();
+      if (!ok) {
+        // contexts draw x themselves meanwhile, if the pool runs empty
+        mbedtls_platform_zeroize(&share, sizeof(share));
+        m_cv.wait_for(lock, backoff, [this] { return m_stop; });
+        backoff = std::min(2 * backoff, std::chrono::milliseconds(MaxBackoffMs));
+        continue;
+      }
+      backoff = std::chrono::milliseconds(MinBackoffMs);
+      m_shares[m_count++] = share;
+      mbedtls_platform_zeroize(&share, sizeof(share));
+    }
+  }
+
+  template<typename Backend>
+  static bool generate(Backend& backend, Drbg& drbg, Share& share) noexcept
+  {
+    // NOTE: generate 8 extra bytes to avoid bias in modulo operation
+    std::array<uint8_t, Group::ScalarSize + 8> random{};
+    int ret = mbedtls_hmac_drbg_random(drbg, random.data(), random.size());
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+
+    typename Backend::Scalar x;
+    typename Backend::Point xP;
+    size_t xPLen = 0;
+    bool ok = backend.reduceScalar(x, random.data(), random.size()) &&
+              backend.writeScalar(share.x.data(), x) &&
+              backend.mulBase(xP, detail::BaseG, x, mbedtls_hmac_drbg_random,
+                              static_cast<mbedtls_hmac_drbg_context*>(drbg)) &&
+              backend.writePoint(share.xP.data(), &xPLen, xP);
+    mbedtls_platform_zeroize(random.data(), random.size());
+    return ok;
+  }
+
+private:
+  enum
+  {
+    MinBackoffMs = 10,
+    MaxBackoffMs = 1000,
+  };
+
+  std::vector<Share> m_shares;
+  size_t m_count = 0;
+  bool m_stop = false;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::thread m_thread;
+};
+
+} // namespace spake2
+
+#endif // PION_SPAKE2_SHARE_POOL_HPP
@@ -2,25 +2,22 @@
 
 #include "spake2.hpp"
 
-#include <endian.h>
-
 namespace spake2 {
 namespace detail {
 
-void
-appendToTranscript(std::vector<uint8_t>& transcript, const uint8_t* buf, size_t buflen)
-{
-  uint64_t len = htole64(buflen);
-  auto lenptr = reinterpret_cast<const uint8_t*>(&len);
-  transcript.insert(transcript.end(), lenptr, lenptr + sizeof(len));
-  transcript.insert(transcript.end(), buf, buf + buflen);
-}
-
-const ndnph::mbedtls::Mpi ContextBase::s_one{ 1 };
-const ndnph::mbedtls::Mpi ContextBase::s_minusOne{ -1 };
+const ndnph::mbedtls::Mpi MbedBackendBase::s_one{ 1 };
+const ndnph::mbedtls::Mpi MbedBackendBase::s_minusOne{ -1 };
 
 } // namespace detail
 
+Drbg&
+Drbg::forThread() noexcept
+{
+  static thread_local mbed::Entropy entropy;
+  static thread_local Drbg drbg(entropy);
+  return drbg;
+}
+
 const uint8_t P256::M[] = {
   0x04, 0x88, 0x6e, 0x2f, 0x97, 0xac, 0xe4, 0x6e, 0x55, 0xba, 0x9d, 0xd7, 0x24,
   0x25, 0x79, 0xf2, 0x99, 0x3b, 0x64, 0xe1, 0x6e, 0xf3, 0xdc, 0xab, 0x95, 0xaf,
@@ -78,4 +75,13 @@ const uint8_t P521::N[] = {
   0x02, 0x06, 0x42, 0x4b, 0x3f, 0xe7, 0x96, 0x8a, 0xa8, 0xe0, 0xb1, 0xf3, 0x34,
 };
 
+const uint8_t Edwards25519::M[] = {
+  0xd0, 0x48, 0x03, 0x2c, 0x6e, 0xa0, 0xb6, 0xd6, 0x97, 0xdd, 0xc2, 0xe8, 0x6b, 0xda, 0x85, 0xa3,
+  0x3a, 0xda, 0xc9, 0x20, 0xf1, 0xbf, 0x18, 0xe1, 0xb0, 0xc6, 0xd1, 0x66, 0xa5, 0xce, 0xcd, 0xaf,
+};
+const uint8_t Edwards25519::N[] = {
+  0xd3, 0xbf, 0xb5, 0x18, 0xf4, 0x4f, 0x34, 0x30, 0xf2, 0x9d, 0x0c, 0x92, 0xaf, 0x50, 0x38, 0x65,
+  0xa1, 0xed, 0x32, 0x81, 0xdc, 0x69, 0xb3, 0x5d, 0xd8, 0x68, 0xba, 0x85, 0xf8, 0x86, 0xc4, 0xab,
+};
+
 } // namespace spake2
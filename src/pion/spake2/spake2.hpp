@@ -3,13 +3,18 @@
 #ifndef PION_SPAKE2_SPAKE2_HPP
 #define PION_SPAKE2_SPAKE2_HPP
 
+#include "drbg.hpp"
+#include "ed25519.hpp"
 #include "mbedtls-wrappers.hpp"
-
-#include <vector>
+#include "p256-native.hpp"
 
 #include <mbedtls/hkdf.h>
 #include <mbedtls/hmac_drbg.h>
 #include <mbedtls/md.h>
+#include <mbedtls/platform_util.h>
+#include <mbedtls/version.h>
+
+#include <limits>
 
 #ifdef SPAKE2_DEBUG
 #include <iostream>
@@ -23,6 +28,43 @@
   } while (false)
 #endif
 
+/**
+ * @brief Whether to use build-time generated comb tables for the SPAKE2-P256 fixed bases.
+ *
+ * The tables are placed in flash, so that no heap memory is needed for them.
+ * They are used by the mbedtls backend only; the native backend, which is the default, always
+ * keeps its own comb tables in flash (see p256_native::combTables). They are enabled by default
+ * on ESP32 when PION_SPAKE2_P256_NATIVE is 0, and can be disabled by defining this macro to 0.
+ * The tables are laid out as mbedtls 2.x structures, so they are not enabled by default with
+ * other mbedtls versions.
+ */
+#ifndef PION_SPAKE2_ROM_TABLES
+#if defined(ARDUINO_ARCH_ESP32) && MBEDTLS_ECP_FIXED_POINT_OPTIM == 1 &&                           \
+  MBEDTLS_VERSION_MAJOR == 2 && !PION_SPAKE2_P256_NATIVE
+#define PION_SPAKE2_ROM_TABLES 1
+#else
+#define PION_SPAKE2_ROM_TABLES 0
+#endif
+#endif
+
+/**
+ * @brief Whether to provide SharePool, see share-pool.hpp.
+ *
+ * SharePool refills itself on a background std::thread. It is disabled by default on Arduino,
+ * whose toolchains may lack std::thread, and can be disabled by defining this macro to 0.
+ */
+#ifndef PION_SPAKE2_SHARE_POOL
+#if defined(ARDUINO)
+#define PION_SPAKE2_SHARE_POOL 0
+#else
+#define PION_SPAKE2_SHARE_POOL 1
+#endif
+#endif
+
+#if defined(MBEDTLS_ECP_RESTARTABLE) && !defined(ARDUINO)
+#include <mutex>
+#endif
+
 namespace spake2 {
 
 enum class Role
@@ -31,79 +73,1083 @@ enum class Role
   Bob,
 };
 
-namespace detail {
+/** @brief Result of an incremental computation step. */
+enum class Progress
+{
+  Done,
+  Pending,
+  Failure,
+};
+
+namespace detail {
+
+// std::max is not constexpr in C++11
+template<typename T>
+constexpr const T&
+max(const T& a, const T& b)
+{
+  return a < b ? b : a;
+}
+
+/** @brief Write the length prefix of a protocol transcript field, as 64-bit little endian. */
+inline void
+writeTranscriptLength(uint8_t* output, size_t buflen) noexcept
+{
+  uint64_t len = buflen;
+  for (size_t i = 0; i < sizeof(len); ++i) {
+    output[i] = static_cast<uint8_t>(len >> (8 * i));
+  }
+}
+
+/** @brief mbedtls_md_update() or mbedtls_md_hmac_update(). */
+using MdUpdate = int (*)(mbedtls_md_context_t*, const unsigned char*, size_t);
+
+/** @brief Feed a length-prefixed protocol transcript field into a digest or HMAC. */
+inline bool
+updateTranscript(mbedtls_md_context_t* md, MdUpdate update, const uint8_t* buf,
+                 size_t buflen) noexcept
+{
+  std::array<uint8_t, sizeof(uint64_t)> prefix;
+  writeTranscriptLength(prefix.data(), buflen);
+  int ret = update(md, prefix.data(), prefix.size());
+  if (ret == 0) {
+    ret = update(md, buf, buflen);
+  }
+  if (ret != 0) {
+    SPAKE2_MBED_ERR(ret);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Fixed-capacity buffer of length-prefixed protocol transcript fields.
+ *
+ * It retains only the fields known when the exchange starts, i.e. the identities. They are hashed
+ * once into the running transcript hash, but the confirmation MACs are keyed by values derived
+ * from that hash, so they must be fed the same bytes again afterwards.
+ */
+template<size_t Capacity>
+class Transcript
+{
+public:
+  /**
+   * @brief Append a field, prefixed by its length as 64-bit little endian integer.
+   * @return whether success; false if capacity would be exceeded.
+   */
+  bool append(const uint8_t* buf, size_t buflen) noexcept
+  {
+    if (buflen > Capacity - sizeof(uint64_t) || m_size + sizeof(uint64_t) + buflen > Capacity) {
+      return false;
+    }
+    writeTranscriptLength(&m_buf[m_size], buflen);
+    m_size += sizeof(uint64_t);
+    std::copy_n(buf, buflen, &m_buf[m_size]);
+    m_size += buflen;
+    return true;
+  }
+
+  const uint8_t* data() const noexcept
+  {
+    return m_buf.data();
+  }
+
+  size_t size() const noexcept
+  {
+    return m_size;
+  }
+
+private:
+  std::array<uint8_t, Capacity> m_buf;
+  size_t m_size = 0;
+};
+
+class ContextBase
+{
+protected:
+  // Protocol state machine: each party goes through each of these states in order
+  enum class State
+  {
+    Initial,
+    Precomputed,
+    ComputingPublicShare,
+    SendingPublicShare,
+    AwaitingPublicShare,
+    ComputingSharedKey,
+    SendingConfirmation,
+    AwaitingConfirmation,
+    Done,
+  };
+
+  State m_state = State::Initial;
+  bool m_bound = false; // whether identities and AAD are set, see Context::bind()
+};
+
+/** @brief Fixed bases of SPAKE2. */
+enum Base
+{
+  BaseG,
+  BaseM,
+  BaseN,
+  NBases,
+};
+
+/**
+ * @brief Build-time generated comb tables of the fixed bases of a group.
+ *
+ * The primary template has no tables. A specialization provides @c get(base) that returns
+ * @c Size points in the layout of mbedtls ecp_precompute_comb(), see mk/spake2-tables.py.
+ */
+template<typename Group>
+struct CombTables
+{
+  enum
+  {
+    Size = 0,
+  };
+
+  static const mbedtls_ecp_point* get(int)
+  {
+    return nullptr;
+  }
+};
+
+/**
+ * @brief Process-wide EC group state shared by all Context instances of the same Group.
+ *
+ * mbedtls keeps the comb table of a group's generator inside the group structure.
+ * This cache holds one copy of the curve per fixed base (G, M, N), where the generator of
+ * each copy is replaced by that base, so that every fixed-base multiplication finds its
+ * precomputed table. All tables are built in the constructor; afterwards the groups are only
+ * read, and they may be shared among threads.
+ */
+template<typename Group>
+class GroupCache
+{
+public:
+  static GroupCache& get() noexcept
+  {
+    static GroupCache instance;
+    return instance;
+  }
+
+  /** @brief Return the group with the standard generator G. */
+  mbedtls_ecp_group* group() noexcept
+  {
+    return m_groups[BaseG];
+  }
+
+  /**
+   * @brief Compute R = m * base, using the precomputed table of the fixed base.
+   * @param rsCtx restart context, or nullptr to complete the multiplication in one call.
+   * @return mbedtls error code; MBEDTLS_ERR_ECP_BAD_INPUT_DATA if the cache failed to initialize.
+   */
+  int mul(Base base, mbedtls_ecp_point* R, const mbedtls_mpi* m,
+          int (*f_rng)(void*, unsigned char*, size_t), void* p_rng,
+          mbedtls_ecp_restart_ctx* rsCtx = nullptr) noexcept
+  {
+    if (!m_ok) {
+      return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+    mbedtls_ecp_group* grp = m_groups[base];
+    return mbedtls_ecp_mul_restartable(grp, R, m, &grp->G, f_rng, p_rng, rsCtx);
+  }
+
+private:
+  GroupCache() noexcept
+  {
+    const uint8_t* bases[NBases] = { nullptr, Group::M, Group::N };
+    for (int i = 0; i < NBases; ++i) {
+      m_ok = m_ok && load(m_groups[i], bases[i], CombTables<Group>::get(i));
+    }
+  }
+
+  ~GroupCache() noexcept
+  {
+    for (int i = 0; i < NBases; ++i) {
+      mbedtls_ecp_group* grp = m_groups[i];
+      if (grp->MBEDTLS_PRIVATE(T_size) == 0) {
+        // static table must not be freed
+        grp->MBEDTLS_PRIVATE(T) = nullptr;
+      }
+    }
+  }
+
+  /**
+   * @brief Load the curve with its generator replaced by @p base , and prepare its comb table.
+   * @param base fixed base in uncompressed format, or nullptr to keep the standard generator.
+   * @param table static comb table, or nullptr to build one on the heap.
+   */
+  static bool load(mbedtls_ecp_group* grp, const uint8_t* base,
+                   const mbedtls_ecp_point* table) noexcept
+  {
+    int ret = mbedtls_ecp_group_load(grp, Group::Id);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+
+    if (base != nullptr) {
+      // Forget the table of the standard generator, if mbedtls provides a static one
+      grp->MBEDTLS_PRIVATE(T) = nullptr;
+      grp->MBEDTLS_PRIVATE(T_size) = 0;
+      ret = mbedtls_ecp_point_read_binary(grp, &grp->G, base, Group::UncompressedPointSize);
+      if (ret != 0) {
+        SPAKE2_MBED_ERR(ret);
+        return false;
+      }
+    }
+
+    if (useStaticTable(grp, table)) {
+      return true;
+    }
+
+    // Build and cache the comb table now, so that later multiplications only read the group.
+    // mbedtls 3.x requires an RNG for coordinate randomization.
+    ndnph::mbedtls::Mpi one(1);
+    ndnph::mbedtls::EcPoint R;
+    ret = mbedtls_ecp_mul(grp, R, one, &grp->G, mbedtls_hmac_drbg_random, Drbg::forThread());
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Install a static comb table into the group.
+   * @return whether the table passed sanity checks and has been installed.
+   *
+   * mbedtls recognizes a table with T_size=0 as static and never writes or frees it.
+   */
+  static bool useStaticTable(mbedtls_ecp_group* grp, const mbedtls_ecp_point* table) noexcept
+  {
+    if (table == nullptr || mbedtls_ecp_point_cmp(&table[0], &grp->G) != 0) {
+      return false;
+    }
+    for (int j = 0; j < CombTables<Group>::Size; ++j) {
+      if (mbedtls_ecp_check_pubkey(grp, &table[j]) != 0) {
+        return false;
+      }
+    }
+
+    grp->MBEDTLS_PRIVATE(T) = const_cast<mbedtls_ecp_point*>(table);
+    grp->MBEDTLS_PRIVATE(T_size) = 0;
+    return true;
+  }
+
+private:
+  mbed::Object<mbedtls_ecp_group, mbedtls_ecp_group_init, mbedtls_ecp_group_free> m_groups[NBases];
+  bool m_ok = true;
+};
+
+} // namespace detail
+
+struct P256
+{
+  static constexpr mbedtls_ecp_group_id Id = MBEDTLS_ECP_DP_SECP256R1;
+  enum
+  {
+    ScalarSize = 32,
+    UncompressedPointSize = 65,
+    CompressedPointSize = 33,
+  };
+
+  static const uint8_t M[UncompressedPointSize];
+  static const uint8_t N[UncompressedPointSize];
+};
+
+struct P384
+{
+  static constexpr mbedtls_ecp_group_id Id = MBEDTLS_ECP_DP_SECP384R1;
+  enum
+  {
+    ScalarSize = 48,
+    UncompressedPointSize = 97,
+    CompressedPointSize = 49,
+  };
+
+  static const uint8_t M[UncompressedPointSize];
+  static const uint8_t N[UncompressedPointSize];
+};
+
+struct P521
+{
+  static constexpr mbedtls_ecp_group_id Id = MBEDTLS_ECP_DP_SECP521R1;
+  enum
+  {
+    ScalarSize = 66,
+    UncompressedPointSize = 133,
+    CompressedPointSize = 67,
+  };
+
+  static const uint8_t M[UncompressedPointSize];
+  static const uint8_t N[UncompressedPointSize];
+};
+
+/**
+ * @brief edwards25519 group, see ed25519.hpp.
+ *
+ * Points have a single 32-octet encoding, which takes the place of both the uncompressed and
+ * the compressed formats of the NIST groups. The cofactor is 8.
+ */
+struct Edwards25519
+{
+  enum
+  {
+    ScalarSize = 32,
+    UncompressedPointSize = 32,
+    CompressedPointSize = 32,
+  };
+
+  static const uint8_t M[UncompressedPointSize];
+  static const uint8_t N[UncompressedPointSize];
+};
+
+#if PION_SPAKE2_ROM_TABLES
+namespace detail {
+
+template<>
+struct CombTables<P256>
+{
+  enum
+  {
+    Size = 16,
+  };
+
+  static const mbedtls_ecp_point* get(int base);
+};
+
+} // namespace detail
+#endif // PION_SPAKE2_ROM_TABLES
+
+namespace detail {
+
+using Rng = int (*)(void*, unsigned char*, size_t);
+
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+#if defined(ARDUINO)
+// Arduino builds run every SPAKE2 context from a single task, so that no lock is needed.
+struct EcpMaxOpsMutex
+{};
+
+struct EcpMaxOpsLock
+{
+  explicit EcpMaxOpsLock(EcpMaxOpsMutex&) {}
+};
+#else
+using EcpMaxOpsMutex = std::mutex;
+using EcpMaxOpsLock = std::lock_guard<std::mutex>;
+#endif
+
+/**
+ * @brief Return the lock that serializes restartable mbedtls multiplications.
+ *
+ * mbedtls_ecp_set_max_ops() sets a process-wide limit, which applies to every multiplication that
+ * is given a restart context. Each restartable call holds this lock while the limit is set, so
+ * that contexts on different threads cannot change the limit of each other. Multiplications
+ * without a restart context ignore the limit, and do not take the lock.
+ */
+inline EcpMaxOpsMutex&
+ecpMaxOpsMutex()
+{
+  static EcpMaxOpsMutex mutex;
+  return mutex;
+}
+#endif // MBEDTLS_ECP_RESTARTABLE
+
+class MbedBackendBase
+{
+protected:
+  static const ndnph::mbedtls::Mpi s_one;
+  static const ndnph::mbedtls::Mpi s_minusOne;
+};
+
+/**
+ * @brief Group arithmetic backend based on mbedtls.
+ *
+ * This is the reference backend, which supports every group. A backend provides @c Scalar,
+ * @c Point, and @c Restart types that need no further initialization, and the operations below.
+ * Each operation returns false on error. Each restartable operation performs a part of the
+ * multiplication within a budget of approximately that many field multiplications, and must be
+ * repeated with the same arguments while it returns Progress::Pending. Context selects the
+ * backend of its Group through BackendOf.
+ */
+template<typename Group>
+class MbedBackend : MbedBackendBase
+{
+public:
+  using Scalar = ndnph::mbedtls::Mpi;
+  using Point = ndnph::mbedtls::EcPoint;
+
+  /** @brief Set k = input mod n, where input is a big endian integer. */
+  bool reduceScalar(Scalar& k, const uint8_t* input, size_t len) noexcept
+  {
+    ndnph::mbedtls::Mpi v;
+    int ret = mbedtls_mpi_read_binary(v, input, len);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    ret = mbedtls_mpi_mod_mpi(k, v, &m_cache.group()->N);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    return true;
+  }
+
+  /** @brief Write k as Group::ScalarSize octets big endian. */
+  bool writeScalar(uint8_t* output, const Scalar& k) noexcept
+  {
+    int ret = mbedtls_mpi_write_binary(k, output, Group::ScalarSize);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    return true;
+  }
+
+  bool isZero(const Scalar& k) noexcept
+  {
+    return mbedtls_mpi_cmp_int(k, 0) == 0;
+  }
+
+  /** @brief Erase a secret scalar; mbedtls_mpi_free() zeroizes the limbs. */
+  void clearScalar(Scalar& k) noexcept
+  {
+    mbedtls_mpi_free(k);
+    mbedtls_mpi_init(k);
+  }
+
+  /**
+   * @brief Decode a point in uncompressed or compressed format, and verify that it is a valid
+   *        public key.
+   */
+  bool readPoint(Point& P, const uint8_t* input, size_t len) noexcept
+  {
+    int ret = len == Group::CompressedPointSize
+                ? readCompressed(P, input)
+                : mbedtls_ecp_point_read_binary(m_cache.group(), P, input, len);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    ret = mbedtls_ecp_check_pubkey(m_cache.group(), P);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    return true;
+  }
+
+  /** @brief Encode a point in uncompressed format into Group::UncompressedPointSize octets. */
+  bool writePoint(uint8_t* output, size_t* len, const Point& P) noexcept
+  {
+    int ret = mbedtls_ecp_point_write_binary(m_cache.group(), P, MBEDTLS_ECP_PF_UNCOMPRESSED, len,
+                                             output, Group::UncompressedPointSize);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Encode @p n points, as writePoint() does.
+   *
+   * mbedtls returns the result of each multiplication in affine coordinates, so that there is
+   * no field inversion to share among the points.
+   */
+  bool writePoints(uint8_t* const output[], size_t len[], const Point P[], size_t n) noexcept
+  {
+    for (size_t i = 0; i < n; ++i) {
+      if (!writePoint(output[i], &len[i], P[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool isZero(const Point& P) noexcept
+  {
+    const mbedtls_ecp_point* pt = P;
+    return mbedtls_mpi_cmp_int(&pt->Z, 0) == 0;
+  }
+
+  /** @brief R = k * base. */
+  bool mulBase(Point& R, Base base, const Scalar& k, Rng f_rng, void* p_rng) noexcept
+  {
+    int ret = m_cache.mul(base, R, k, f_rng, p_rng);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief R = k1 * base1 + k2 * base2.
+   *
+   * The two multiplications are not combined into an mbedtls_ecp_muladd() because the latter is
+   * _not_ constant time while the former are.
+   */
+  bool mulBase2(Point& R, Base base1, const Scalar& k1, Base base2, const Scalar& k2, Rng f_rng,
+                void* p_rng) noexcept
+  {
+    Point P;
+    return mulBase(P, base1, k1, f_rng, p_rng) && mulBase(R, base2, k2, f_rng, p_rng) &&
+           add(R, R, P);
+  }
+
+  /** @brief R = h * k * P, where h is the cofactor of the group. */
+  bool mul(Point& R, const Scalar& k, const Point& P, Rng f_rng, void* p_rng) noexcept
+  {
+    // the cofactor is 1 for the groups supported by mbedtls
+    int ret = mbedtls_ecp_mul(m_cache.group(), R, k, P, f_rng, p_rng);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief R = P + Q.
+   *
+   * mbedtls has no public point addition. mbedtls_ecp_muladd() recognizes the scalars 1 and -1
+   * and skips the multiplications, so this costs a single point addition.
+   */
+  bool add(Point& R, const Point& P, const Point& Q) noexcept
+  {
+    int ret = mbedtls_ecp_muladd(m_cache.group(), R, s_one, P, s_one, Q);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    return true;
+  }
+
+  /** @brief R = P - Q. */
+  bool sub(Point& R, const Point& P, const Point& Q) noexcept
+  {
+    int ret = mbedtls_ecp_muladd(m_cache.group(), R, s_one, P, s_minusOne, Q);
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Progress of a restartable multiplication.
+   *
+   * If mbedtls is built with MBEDTLS_ECP_RESTARTABLE, a multiplication stops when the budget is
+   * exhausted and resumes in the next call. Otherwise, each multiplication completes in one call.
+   */
+  struct Restart
+  {
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+    mbed::Object<mbedtls_ecp_restart_ctx, mbedtls_ecp_restart_init, mbedtls_ecp_restart_free> ctx;
+#endif
+    Point P; // first product of mulBase2Restartable()
+    bool hasP = false;
+  };
+
+  /**
+   * @brief Restartable mulBase().
+   * @param[inout] budget remaining budget, in field multiplications; it is reduced by the
+   *                      operations that mbedtls counted, or by an estimate of a whole
+   *                      multiplication without MBEDTLS_ECP_RESTARTABLE.
+   * @return Progress::Pending if the same call must be repeated to continue the multiplication.
+   */
+  Progress mulBaseRestartable(Restart& rs, int& budget, Point& R, Base base, const Scalar& k,
+                              Rng f_rng, void* p_rng) noexcept
+  {
+    return restartable(rs, budget, [&](mbedtls_ecp_restart_ctx* rsCtx) {
+      return m_cache.mul(base, R, k, f_rng, p_rng, rsCtx);
+    });
+  }
+
+  /** @brief Restartable mulBase2(). */
+  Progress mulBase2Restartable(Restart& rs, int& budget, Point& R, Base base1, const Scalar& k1,
+                               Base base2, const Scalar& k2, Rng f_rng, void* p_rng) noexcept
+  {
+    if (!rs.hasP) {
+      Progress result = mulBaseRestartable(rs, budget, rs.P, base1, k1, f_rng, p_rng);
+      if (result != Progress::Done) {
+        return result;
+      }
+      rs.hasP = true;
+      return Progress::Pending;
+    }
+
+    Progress result = mulBaseRestartable(rs, budget, R, base2, k2, f_rng, p_rng);
+    if (result == Progress::Pending) {
+      return result;
+    }
+    rs.hasP = false;
+    if (result == Progress::Done && !add(R, R, rs.P)) {
+      return Progress::Failure;
+    }
+    return result;
+  }
+
+  /** @brief Restartable mul(). */
+  Progress mulRestartable(Restart& rs, int& budget, Point& R, const Scalar& k, const Point& P,
+                          Rng f_rng, void* p_rng) noexcept
+  {
+    return restartable(rs, budget, [&](mbedtls_ecp_restart_ctx* rsCtx) {
+      return mbedtls_ecp_mul_restartable(m_cache.group(), R, k, P, f_rng, p_rng, rsCtx);
+    });
+  }
+
+private:
+  /**
+   * @brief Decode a compressed point, without validating it.
+   *
+   * Not every mbedtls version can read compressed points. Every NIST group has a = -3 and
+   * p = 3 mod 4, so y is a square root of x^3 - 3x + b, computed as (x^3 - 3x + b)^((p+1)/4).
+   * If no square root exists, the result is not on the curve, and is rejected by readPoint().
+   */
+  int readCompressed(Point& P, const uint8_t* input) noexcept
+  {
+    if (input[0] != 0x02 && input[0] != 0x03) {
+      return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+    const mbedtls_ecp_group* grp = m_cache.group();
+    mbedtls_ecp_point* pt = P;
+
+    int ret = mbedtls_mpi_read_binary(&pt->X, &input[1], Group::CompressedPointSize - 1);
+    if (ret != 0) {
+      return ret;
+    }
+    if (mbedtls_mpi_cmp_mpi(&pt->X, &grp->P) >= 0) {
+      return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    // rhs = x^3 - 3x + b mod p
+    ndnph::mbedtls::Mpi rhs, t;
+    ret = mbedtls_mpi_mul_mpi(t, &pt->X, &pt->X);
+    if (ret != 0) {
+      return ret;
+    }
+    ret = mbedtls_mpi_mul_mpi(rhs, t, &pt->X);
+    if (ret != 0) {
+      return ret;
+    }
+    ret = mbedtls_mpi_add_mpi(t, &pt->X, &pt->X);
+    if (ret != 0) {
+      return ret;
+    }
+    ret = mbedtls_mpi_add_mpi(t, t, &pt->X);
+    if (ret != 0) {
+      return ret;
+    }
+    ret = mbedtls_mpi_sub_mpi(rhs, rhs, t);
+    if (ret != 0) {
+      return ret;
+    }
+    ret = mbedtls_mpi_add_mpi(rhs, rhs, &grp->B);
+    if (ret != 0) {
+      return ret;
+    }
+    ret = mbedtls_mpi_mod_mpi(rhs, rhs, &grp->P);
+    if (ret != 0) {
+      return ret;
+    }
+
+    // y = rhs^((p+1)/4) mod p, negated if its parity differs from the prefix
+    ret = mbedtls_mpi_add_int(t, &grp->P, 1);
+    if (ret != 0) {
+      return ret;
+    }
+    ret = mbedtls_mpi_shift_r(t, 2);
+    if (ret != 0) {
+      return ret;
+    }
+    ret = mbedtls_mpi_exp_mod(&pt->Y, rhs, t, &grp->P, nullptr);
+    if (ret != 0) {
+      return ret;
+    }
+    if (mbedtls_mpi_get_bit(&pt->Y, 0) != (input[0] & 0x01)) {
+      ret = mbedtls_mpi_sub_mpi(&pt->Y, &grp->P, &pt->Y);
+      if (ret != 0) {
+        return ret;
+      }
+    }
+    return mbedtls_mpi_lset(&pt->Z, 1);
+  }
+
+  template<typename Fn>
+  static Progress restartable(Restart& rs, int& budget, const Fn& mul) noexcept
+  {
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+    int ret = 0;
+    {
+      // the limit is a process-wide setting, so that it is held under a lock and restored to
+      // unlimited (0) afterwards; see ecpMaxOpsMutex() about threads
+      EcpMaxOpsLock lock(ecpMaxOpsMutex());
+      mbedtls_ecp_set_max_ops(static_cast<unsigned>(std::max(1, budget)));
+      ret = mul(rs.ctx);
+      mbedtls_ecp_set_max_ops(0);
+    }
+    // ops_done counts the operations of the last top-level call, and is reset by the next one
+    int used = static_cast<int>(rs.ctx->MBEDTLS_PRIVATE(ops_done));
+#else
+    (void)rs;
+    int ret = mul(nullptr);
+    int used = Group::ScalarSize * 8 * (AddCost + DblCost);
+#endif
+    budget = std::max(0, budget - used);
+    if (ret == MBEDTLS_ERR_ECP_IN_PROGRESS) {
+      return Progress::Pending;
+    }
+
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+    // prepare the context for the next multiplication
+    mbedtls_ecp_restart_free(rs.ctx);
+    mbedtls_ecp_restart_init(rs.ctx);
+#endif
+    if (ret != 0) {
+      SPAKE2_MBED_ERR(ret);
+      return Progress::Failure;
+    }
+    return Progress::Done;
+  }
+
+private:
+#if !defined(MBEDTLS_ECP_RESTARTABLE)
+  // approximate costs of point operations in field multiplications, the unit of the budget
+  enum
+  {
+    AddCost = 14,
+    DblCost = 11,
+  };
+#endif
+
+  GroupCache<Group>& m_cache = GroupCache<Group>::get();
+};
+
+/**
+ * @brief Progress of a restartable scalar multiplication in a native backend.
+ * @tparam Iterations number of loop iterations in a multiplication.
+ *
+ * The native backends split a multiplication at loop iteration boundaries, and this object
+ * carries the accumulator between calls.
+ */
+template<typename Point, int Iterations>
+class NativeRestart
+{
+public:
+  /**
+   * @brief Perform loop iterations within a budget.
+   * @param[inout] budget remaining budget; at least one iteration is performed regardless.
+   * @param iterationCost cost of one iteration.
+   * @param callCost fixed cost of each call.
+   * @param[out] R result, assigned when the last iteration has been performed.
+   * @param run function (acc, begin, end) that performs iterations [begin, end) into acc.
+   */
+  template<typename Fn>
+  Progress step(int& budget, int iterationCost, int callCost, Point& R, const Fn& run) noexcept
+  {
+    int n = std::max(1, std::min((budget - callCost) / iterationCost, Iterations - m_pos));
+    run(m_acc, m_pos, m_pos + n);
+    budget = std::max(0, budget - callCost - n * iterationCost);
+    m_pos += n;
+    if (m_pos < Iterations) {
+      return Progress::Pending;
+    }
+
+    R = m_acc;
+    m_pos = 0;
+    return Progress::Done;
+  }
+
+private:
+  Point m_acc;
+  int m_pos = 0;
+};
+
+#if PION_SPAKE2_P256_NATIVE
+/**
+ * @brief Group arithmetic backend for P256 with fixed-size limbs, see p256-native.hpp.
+ *
+ * All storage is on the stack or inside the Context, and scalar multiplications run in
+ * constant time. The random number generator is not needed for blinding.
+ */
+class P256NativeBackend
+{
+public:
+  using Scalar = p256_native::Scalar;
+  using Point = p256_native::Point;
+  using Restart = NativeRestart<Point, p256_native::MulIterations>;
+
+  bool reduceScalar(Scalar& k, const uint8_t* input, size_t len) noexcept
+  {
+    p256_native::scalarReduce(k, input, len);
+    return true;
+  }
+
+  bool writeScalar(uint8_t* output, const Scalar& k) noexcept
+  {
+    p256_native::scalarWrite(output, k);
+    return true;
+  }
+
+  bool isZero(const Scalar& k) noexcept
+  {
+    return p256_native::scalarIsZero(k);
+  }
+
+  /** @brief Erase a secret scalar. */
+  void clearScalar(Scalar& k) noexcept
+  {
+    mbedtls_platform_zeroize(&k, sizeof(k));
+  }
+
+  bool readPoint(Point& P, const uint8_t* input, size_t len) noexcept
+  {
+    return p256_native::pointRead(P, input, len);
+  }
+
+  bool writePoint(uint8_t* output, size_t* len, const Point& P) noexcept
+  {
+    p256_native::pointWrite(output, len, P);
+    return true;
+  }
+
+  /** @brief Encode @p n points, sharing field inversions among them. */
+  bool writePoints(uint8_t* const output[], size_t len[], const Point P[], size_t n) noexcept
+  {
+    p256_native::pointWriteBatch(output, len, P, n);
+    return true;
+  }
+
+  bool isZero(const Point& P) noexcept
+  {
+    return p256_native::pointIsZero(P);
+  }
+
+  bool mulBase(Point& R, Base base, const Scalar& k, Rng, void*) noexcept
+  {
+    p256_native::pointMulBase(R, static_cast<p256_native::Base>(base), k);
+    return true;
+  }
+
+  bool mulBase2(Point& R, Base base1, const Scalar& k1, Base base2, const Scalar& k2, Rng,
+                void*) noexcept
+  {
+    p256_native::pointMulBase2(R, static_cast<p256_native::Base>(base1), k1,
+                               static_cast<p256_native::Base>(base2), k2);
+    return true;
+  }
+
+  bool mul(Point& R, const Scalar& k, const Point& P, Rng, void*) noexcept
+  {
+    p256_native::pointMul(R, k, P);
+    return true;
+  }
+
+  bool add(Point& R, const Point& P, const Point& Q) noexcept
+  {
+    p256_native::pointAdd(R, P, Q);
+    return true;
+  }
+
+  bool sub(Point& R, const Point& P, const Point& Q) noexcept
+  {
+    p256_native::pointSub(R, P, Q);
+    return true;
+  }
+
+  Progress mulBaseRestartable(Restart& rs, int& budget, Point& R, Base base, const Scalar& k, Rng,
+                              void*) noexcept
+  {
+    return rs.step(budget, DblCost + AddCost, 0, R, [&](Point& acc, int begin, int end) {
+      p256_native::pointMulBaseRange(acc, static_cast<p256_native::Base>(base), k, begin, end);
+    });
+  }
+
+  Progress mulBase2Restartable(Restart& rs, int& budget, Point& R, Base base1, const Scalar& k1,
+                               Base base2, const Scalar& k2, Rng, void*) noexcept
+  {
+    return rs.step(budget, DblCost + 2 * AddCost, 0, R, [&](Point& acc, int begin, int end) {
+      p256_native::pointMulBase2Range(acc, static_cast<p256_native::Base>(base1), k1,
+                                      static_cast<p256_native::Base>(base2), k2, begin, end);
+    });
+  }
+
+  Progress mulRestartable(Restart& rs, int& budget, Point& R, const Scalar& k, const Point& P, Rng,
+                          void*) noexcept
+  {
+    return rs.step(budget, 4 * DblCost + AddCost, 14 * AddCost, R,
+                   [&](Point& acc, int begin, int end) {
+                     p256_native::pointMulRange(acc, k, P, begin, end);
+                   });
+  }
+
+private:
+  // approximate costs of point operations in field multiplications, the unit of the budget
+  enum
+  {
+    AddCost = 14,
+    DblCost = 11,
+  };
+};
+#endif // PION_SPAKE2_P256_NATIVE
+
+/** @brief Group arithmetic backend for Edwards25519, see ed25519.hpp. */
+class Edwards25519Backend
+{
+public:
+  using Scalar = ed25519::Scalar;
+  using Point = ed25519::Point;
+  using Restart = NativeRestart<Point, ed25519::MulIterations>;
+
+  bool reduceScalar(Scalar& k, const uint8_t* input, size_t len) noexcept
+  {
+    ed25519::scalarReduce(k, input, len);
+    return true;
+  }
+
+  bool writeScalar(uint8_t* output, const Scalar& k) noexcept
+  {
+    ed25519::scalarWrite(output, k);
+    return true;
+  }
+
+  bool isZero(const Scalar& k) noexcept
+  {
+    return ed25519::scalarIsZero(k);
+  }
+
+  /** @brief Erase a secret scalar. */
+  void clearScalar(Scalar& k) noexcept
+  {
+    mbedtls_platform_zeroize(&k, sizeof(k));
+  }
+
+  /** @brief Decode a point, rejecting the identity element. */
+  bool readPoint(Point& P, const uint8_t* input, size_t len) noexcept
+  {
+    return ed25519::pointRead(P, input, len) && !ed25519::pointIsZero(P);
+  }
+
+  bool writePoint(uint8_t* output, size_t* len, const Point& P) noexcept
+  {
+    ed25519::pointWrite(output, len, P);
+    return true;
+  }
+
+  /** @brief Encode @p n points, sharing field inversions among them. */
+  bool writePoints(uint8_t* const output[], size_t len[], const Point P[], size_t n) noexcept
+  {
+    ed25519::pointWriteBatch(output, len, P, n);
+    return true;
+  }
 
-// std::max is not constexpr in C++11
-template<typename T>
-constexpr const T&
-max(const T& a, const T& b)
-{
-  return a < b ? b : a;
-}
+  bool isZero(const Point& P) noexcept
+  {
+    return ed25519::pointIsZero(P);
+  }
 
-void
-appendToTranscript(std::vector<uint8_t>& transcript, const uint8_t* buf, size_t buflen);
+  bool mulBase(Point& R, Base base, const Scalar& k, Rng, void*) noexcept
+  {
+    ed25519::pointMulBase(R, static_cast<ed25519::Base>(base), k);
+    return true;
+  }
 
-class ContextBase
-{
-protected:
-  // Protocol state machine: each party goes through each of these states in order
-  enum class State
+  bool mulBase2(Point& R, Base base1, const Scalar& k1, Base base2, const Scalar& k2, Rng,
+                void*) noexcept
   {
-    Initial,
-    AwaitingPublicShare,
-    SendingConfirmation,
-    AwaitingConfirmation,
-    Done,
-  };
+    ed25519::pointMulBase2(R, static_cast<ed25519::Base>(base1), k1,
+                           static_cast<ed25519::Base>(base2), k2);
+    return true;
+  }
 
-  State m_state = State::Initial;
+  /** @brief R = 8 * k * P, which discards any small order component of P. */
+  bool mul(Point& R, const Scalar& k, const Point& P, Rng, void*) noexcept
+  {
+    ed25519::pointMul(R, k, P);
+    ed25519::pointMulCofactor(R, R);
+    return true;
+  }
 
-  static const ndnph::mbedtls::Mpi s_one;
-  static const ndnph::mbedtls::Mpi s_minusOne;
-};
+  bool add(Point& R, const Point& P, const Point& Q) noexcept
+  {
+    ed25519::pointAdd(R, P, Q);
+    return true;
+  }
 
-} // namespace detail
+  bool sub(Point& R, const Point& P, const Point& Q) noexcept
+  {
+    ed25519::pointSub(R, P, Q);
+    return true;
+  }
 
-struct P256
-{
-  static constexpr mbedtls_ecp_group_id Id = MBEDTLS_ECP_DP_SECP256R1;
-  enum
+  Progress mulBaseRestartable(Restart& rs, int& budget, Point& R, Base base, const Scalar& k, Rng,
+                              void*) noexcept
   {
-    ScalarSize = 32,
-    UncompressedPointSize = 65,
-  };
+    return rs.step(budget, DblCost + AddCost, 0, R, [&](Point& acc, int begin, int end) {
+      ed25519::pointMulBaseRange(acc, static_cast<ed25519::Base>(base), k, begin, end);
+    });
+  }
 
-  static const uint8_t M[UncompressedPointSize];
-  static const uint8_t N[UncompressedPointSize];
-};
+  Progress mulBase2Restartable(Restart& rs, int& budget, Point& R, Base base1, const Scalar& k1,
+                               Base base2, const Scalar& k2, Rng, void*) noexcept
+  {
+    return rs.step(budget, DblCost + 2 * AddCost, 0, R, [&](Point& acc, int begin, int end) {
+      ed25519::pointMulBase2Range(acc, static_cast<ed25519::Base>(base1), k1,
+                                  static_cast<ed25519::Base>(base2), k2, begin, end);
+    });
+  }
 
-struct P384
-{
-  static constexpr mbedtls_ecp_group_id Id = MBEDTLS_ECP_DP_SECP384R1;
+  Progress mulRestartable(Restart& rs, int& budget, Point& R, const Scalar& k, const Point& P, Rng,
+                          void*) noexcept
+  {
+    Progress result = rs.step(budget, 4 * DblCost + AddCost, 14 * AddCost, R,
+                              [&](Point& acc, int begin, int end) {
+                                ed25519::pointMulRange(acc, k, P, begin, end);
+                              });
+    if (result == Progress::Done) {
+      ed25519::pointMulCofactor(R, R);
+    }
+    return result;
+  }
+
+private:
+  // approximate costs of point operations in field multiplications, the unit of the budget
   enum
   {
-    ScalarSize = 48,
-    UncompressedPointSize = 97,
+    AddCost = 9,
+    DblCost = 8,
   };
+};
 
-  static const uint8_t M[UncompressedPointSize];
-  static const uint8_t N[UncompressedPointSize];
+/** @brief Select the group arithmetic backend of a group. */
+template<typename Group>
+struct BackendOf
+{
+  using type = MbedBackend<Group>;
 };
 
-struct P521
+#if PION_SPAKE2_P256_NATIVE
+template<>
+struct BackendOf<P256>
 {
-  static constexpr mbedtls_ecp_group_id Id = MBEDTLS_ECP_DP_SECP521R1;
-  enum
-  {
-    ScalarSize = 66,
-    UncompressedPointSize = 133,
-  };
+  using type = P256NativeBackend;
+};
+#endif // PION_SPAKE2_P256_NATIVE
 
-  static const uint8_t M[UncompressedPointSize];
-  static const uint8_t N[UncompressedPointSize];
+template<>
+struct BackendOf<Edwards25519>
+{
+  using type = Edwards25519Backend;
 };
 
+} // namespace detail
+
 struct SHA256
 {
   static constexpr mbedtls_md_type_t Type = MBEDTLS_MD_SHA256;
@@ -122,15 +1168,37 @@ struct SHA512
   };
 };
 
+/**
+ * @brief Pool of ephemeral SPAKE2 shares, see share-pool.hpp.
+ *
+ * If PION_SPAKE2_SHARE_POOL is disabled, it is declared but not defined, and a Context can only
+ * be constructed without a pool.
+ */
+template<typename Group>
+class SharePool;
+
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+class Batch;
+
 /**
  * @brief This class represents an execution of the SPAKE2 protocol (draft-26).
  *
  * SPAKE2 is a protocol for two parties that share a password to derive a strong shared
  * key with no risk of disclosing the password. The password can be low entropy.
  *
+ * The context does not allocate memory for its own buffers: their sizes are derived from
+ * @p Group, @p Hash, and @p MaxInputLen, which bounds the length of each identity and of the
+ * AAD. Thus, a Context can be constructed in caller-provided storage such as a Region, and it
+ * makes no C++ heap allocation (checked by tests/alloc.cpp).
+ * Group arithmetic is delegated to a backend selected by detail::BackendOf: P256 uses the native
+ * fixed-limb backend unless PION_SPAKE2_P256_NATIVE is 0, Edwards25519 uses its own native
+ * backend, and other groups use mbedtls, which allocates big numbers with its own allocator.
+ * mbedtls also allocates, with mbedtls_calloc(), the state of the transcript digest in the
+ * constructor and the temporary HMAC contexts of HKDF in the key schedule.
+ *
  * @sa https://www.ietf.org/archive/id/draft-irtf-cfrg-spake2-26.html
  */
-template<Role role, typename Group = P256, typename Hash = SHA256>
+template<Role role, typename Group = P256, typename Hash = SHA256, size_t MaxInputLen = 64>
 class Context final : detail::ContextBase
 {
 public:
@@ -139,20 +1207,99 @@ public:
   enum
   {
     FirstMessageSize = Group::UncompressedPointSize,
+    CompressedFirstMessageSize = Group::CompressedPointSize,
     SecondMessageSize = Hash::OutputSize,
     SharedKeySize = Hash::OutputSize / 2,
   };
 
-  explicit Context(mbedtls_entropy_context* entropyCtx) noexcept;
+  /**
+   * @brief Constructor.
+   * @param drbg random number generator; it must outlive this object and must not be used by
+   *             another thread at the same time.
+   * @param pool optional pool of ephemeral shares; it must outlive this object.
+   */
+  explicit Context(Drbg& drbg, SharePool<Group>* pool = nullptr) noexcept;
 
+  /** @brief Destructor, which erases the secret scalars and the shared key. */
+  ~Context() noexcept;
+
+  /** @brief Equivalent to precompute() followed by bind(). */
   bool start(const uint8_t* pw, size_t pwLen, const uint8_t* myId = nullptr, size_t myIdLen = 0,
              const uint8_t* peerId = nullptr, size_t peerIdLen = 0, const uint8_t* aad = nullptr,
              size_t aadLen = 0) noexcept;
 
+  /**
+   * @brief Derive w from the password and draw the random scalar.
+   *
+   * This does not depend on the identities or AAD. It may be followed by
+   * startGenerateFirstMessage() and step() to compute the public share before the peer is known.
+   */
+  bool precompute(const uint8_t* pw, size_t pwLen) noexcept;
+
+  /**
+   * @brief Set w and the random scalar x directly, in place of precompute().
+   * @param w big endian integer, such as the output of a memory-hard function of the password;
+   *          it is reduced modulo the group order.
+   * @param x big endian integer in range [1, order-1].
+   *
+   * This makes the exchange deterministic, which is meant for known-answer tests. x must never
+   * be reused.
+   */
+  bool precomputeScalars(const uint8_t* w, size_t wLen, const uint8_t* x, size_t xLen) noexcept;
+
+  /**
+   * @brief Set the identities and AAD, and start the transcript hash.
+   * @pre precompute() has been called.
+   *
+   * This must be called once, any time before processFirstMessage() or
+   * startProcessFirstMessage().
+   */
+  bool bind(const uint8_t* myId = nullptr, size_t myIdLen = 0, const uint8_t* peerId = nullptr,
+            size_t peerIdLen = 0, const uint8_t* aad = nullptr, size_t aadLen = 0) noexcept;
+
+  /**
+   * @brief Retrieve the public share.
+   * @param outMsgLen either FirstMessageSize for the uncompressed format, or
+   *                  CompressedFirstMessageSize for the compressed format.
+   */
   bool generateFirstMessage(uint8_t* outMsg, size_t outMsgLen) noexcept;
 
+  /**
+   * @brief Process the peer's public share in either format.
+   *
+   * The transcript always contains the uncompressed format, so that both parties derive the
+   * same keys regardless of the format of each message.
+   */
   bool processFirstMessage(const uint8_t* inMsg, size_t inMsgLen) noexcept;
 
+  /**
+   * @brief Begin computing the first message incrementally.
+   *
+   * Call step() until it returns Progress::Done, then retrieve the message with
+   * generateFirstMessage(), which no longer performs any computation.
+   */
+  bool startGenerateFirstMessage() noexcept;
+
+  /**
+   * @brief Begin processing the peer's first message incrementally.
+   *
+   * The message is validated and copied. Call step() until it returns Progress::Done; the context
+   * is then in the same state as after processFirstMessage().
+   */
+  bool startProcessFirstMessage(const uint8_t* inMsg, size_t inMsgLen) noexcept;
+
+  /**
+   * @brief Continue the computation begun by startGenerateFirstMessage() or
+   *        startProcessFirstMessage().
+   * @param budget amount of work allowed in this call, as an approximate number of field
+   *               multiplications. Each call makes some progress even if the budget is smaller.
+   *
+   * With the mbedtls backend and MBEDTLS_ECP_RESTARTABLE, steps of contexts on different threads
+   * are serialized by a process-wide lock. Arduino builds have no such lock, and must call step()
+   * from a single task.
+   */
+  Progress step(int budget) noexcept;
+
   bool generateSecondMessage(uint8_t* outMsg, size_t outMsgLen) noexcept;
 
   bool processSecondMessage(const uint8_t* inMsg, size_t inMsgLen) noexcept;
@@ -168,77 +1315,102 @@ public:
   }
 
 private:
+  template<Role, typename, typename, size_t>
+  friend class Batch;
+
+  using Backend = typename detail::BackendOf<Group>::type;
+
+  /** @brief Call step() until the computation completes. */
+  bool complete() noexcept;
+
+  /** @brief Decode and validate the peer's public share pB, and compute Y = pB - w * (N|M). */
+  bool computeY(const uint8_t* inMsg, size_t inMsgLen, typename Backend::Point& Y) noexcept;
+
+  /** @brief Compute K = x * Y and serialize it. */
+  bool computeK(const typename Backend::Point& Y, uint8_t* binK, size_t* lenK) noexcept;
+
+  /** @brief Finalize the transcript and derive keys and confirmation messages from K. */
+  bool finishFirstMessage(const uint8_t* inMsg, size_t inMsgLen, const uint8_t* binK,
+                          size_t lenK) noexcept;
+
+  /**
+   * @brief Feed the transcript fields that follow the identities: pA, pB, K, w.
+   *
+   * These fields are not retained, but passed again for the transcript hash and for each MAC.
+   */
+  bool updateTranscriptTail(detail::MdUpdate update, const uint8_t* inMsg, size_t inMsgLen,
+                            const uint8_t* binK, size_t lenK, const uint8_t* binW) noexcept;
+
   std::array<uint8_t, detail::max(FirstMessageSize, SecondMessageSize)> m_myMsg{};
   std::array<uint8_t, Hash::OutputSize> m_expectedMac{};
   std::array<uint8_t, SharedKeySize> m_key{};
 
-  mbed::Object<mbedtls_hmac_drbg_context, mbedtls_hmac_drbg_init, mbedtls_hmac_drbg_free> m_drbg;
+  mbedtls_hmac_drbg_context* m_drbg;
+  SharePool<Group>* m_pool;
+  // digest context; it holds the running transcript hash between bind() and
+  // processFirstMessage()
   mbed::Object<mbedtls_md_context_t, mbedtls_md_init, mbedtls_md_free> m_md;
-  mbed::Object<mbedtls_ecp_group, mbedtls_ecp_group_init, mbedtls_ecp_group_free> m_group;
+  Backend m_backend;
 
-  ndnph::mbedtls::Mpi m_w;
-  ndnph::mbedtls::Mpi m_x;
-  ndnph::mbedtls::EcPoint m_pA;
-  ndnph::mbedtls::EcPoint m_M;
-  ndnph::mbedtls::EcPoint m_N;
+  typename Backend::Scalar m_w;
+  typename Backend::Scalar m_x;
 
-  std::vector<uint8_t> m_transcript;
-  std::vector<uint8_t> m_info{
+  // incremental computation
+  typename Backend::Restart m_restart;
+  typename Backend::Point m_point; // pA, or pB followed by Y
+  bool m_hasY = false;
+  bool m_pooled = false; // whether x and x * P (in m_point) were taken from m_pool
+  std::array<uint8_t, FirstMessageSize> m_peerMsg{};
+  size_t m_peerMsgLen = 0;
+
+  detail::Transcript<(sizeof(uint64_t) + MaxInputLen) * 2> m_transcript; // identities
+  std::array<uint8_t, 16 + MaxInputLen> m_info{ {
     'C', 'o', 'n', 'f', 'i', 'r', 'm', 'a', 't', 'i', 'o', 'n', 'K', 'e', 'y', 's',
-  };
+  } };
+  size_t m_infoLen = 16;
 };
 
-template<Role role, typename Group, typename Hash>
-Context<role, Group, Hash>::Context(mbedtls_entropy_context* entropyCtx) noexcept
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+Context<role, Group, Hash, MaxInputLen>::Context(Drbg& drbg, SharePool<Group>* pool) noexcept
+  : m_drbg(drbg)
+  , m_pool(pool)
 {
-  assert(entropyCtx != nullptr);
-
   auto mdInfo = mbedtls_md_info_from_type(Hash::Type);
   assert(mdInfo != nullptr);
 
-  // Initialize HMAC_DRBG context
-  int ret = mbedtls_hmac_drbg_seed(m_drbg, mdInfo, mbedtls_entropy_func, entropyCtx, nullptr, 0);
-  assert(ret == 0);
-
   // Initialize digest context
-  ret = mbedtls_md_setup(m_md, mdInfo, 1);
-  assert(ret == 0);
-
-  // Initialize EC group
-  ret = mbedtls_ecp_group_load(m_group, Group::Id);
+  int ret = mbedtls_md_setup(m_md, mdInfo, 1);
   assert(ret == 0);
+  (void)ret;
+}
 
-  // Load protocol constants M and N
-  ret = mbedtls_ecp_point_read_binary(m_group, m_M, Group::M, sizeof(Group::M));
-  assert(ret == 0);
-  ret = mbedtls_ecp_point_read_binary(m_group, m_N, Group::N, sizeof(Group::N));
-  assert(ret == 0);
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+Context<role, Group, Hash, MaxInputLen>::~Context() noexcept
+{
+  // the native backends keep w and x, including an x taken from a pool, in plain arrays
+  m_backend.clearScalar(m_w);
+  m_backend.clearScalar(m_x);
+  mbedtls_platform_zeroize(m_key.data(), m_key.size());
 }
 
-template<Role role, typename Group, typename Hash>
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
 bool
-Context<role, Group, Hash>::start(const uint8_t* pw, size_t pwLen, const uint8_t* myId,
-                                  size_t myIdLen, const uint8_t* peerId, size_t peerIdLen,
-                                  const uint8_t* aad, size_t aadLen) noexcept
+Context<role, Group, Hash, MaxInputLen>::start(const uint8_t* pw, size_t pwLen,
+                                               const uint8_t* myId, size_t myIdLen,
+                                               const uint8_t* peerId, size_t peerIdLen,
+                                               const uint8_t* aad, size_t aadLen) noexcept
 {
-  // TODO: sanity-check state machine?
+  return precompute(pw, pwLen) && bind(myId, myIdLen, peerId, peerIdLen, aad, aadLen);
+}
 
-  // Allocate memory for the transcript and copy the identities
-  m_transcript.reserve(sizeof(uint64_t) * 6 +             // lengths
-                       myIdLen + peerIdLen +              // identities
-                       Group::UncompressedPointSize * 3 + // pA, pB, K (points)
-                       Group::ScalarSize);                // w (scalar)
-  if (role == Role::Alice) {
-    detail::appendToTranscript(m_transcript, myId, myIdLen);
-    detail::appendToTranscript(m_transcript, peerId, peerIdLen);
-  } else {
-    detail::appendToTranscript(m_transcript, peerId, peerIdLen);
-    detail::appendToTranscript(m_transcript, myId, myIdLen);
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::precompute(const uint8_t* pw, size_t pwLen) noexcept
+{
+  if (m_state != State::Initial) {
+    return false;
   }
 
-  // Append the Additional Authenticated Data (AAD) to the KDF info string
-  m_info.insert(m_info.end(), aad, aad + aadLen);
-
   // Calculate the hash of the user-supplied password pw
   std::array<uint8_t, Hash::OutputSize> pwHash{};
   int ret = mbedtls_md_starts(m_md);
@@ -257,176 +1429,310 @@ Context<role, Group, Hash>::start(const uint8_t* pw, size_t pwLen, const uint8_t
     return false;
   }
 
-  ndnph::mbedtls::Mpi pwHashScalar;
-  ret = mbedtls_mpi_read_binary(pwHashScalar, pwHash.data(), pwHash.size());
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+  if (!m_backend.reduceScalar(m_w, pwHash.data(), pwHash.size())) {
     return false;
   }
-  ret = mbedtls_mpi_mod_mpi(m_w, pwHashScalar, &m_group->N);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
-    return false;
+
+#if PION_SPAKE2_SHARE_POOL
+  // Take random scalar x and x * P from the pool
+  typename SharePool<Group>::Share share;
+  if (m_pool != nullptr && m_pool->take(share)) {
+    m_pooled = m_backend.reduceScalar(m_x, share.x.data(), share.x.size()) &&
+               m_backend.readPoint(m_point, share.xP.data(), share.xP.size());
+    mbedtls_platform_zeroize(&share, sizeof(share));
+    if (!m_pooled) {
+      return false;
+    }
+    m_state = State::Precomputed;
+    return true;
   }
+#endif
 
   // Generate random scalar x
-  ndnph::mbedtls::Mpi random;
   // NOTE: generate 8 extra bytes to avoid bias in modulo operation
-  ret = mbedtls_mpi_fill_random(random, Group::ScalarSize + 8, mbedtls_hmac_drbg_random, m_drbg);
+  std::array<uint8_t, Group::ScalarSize + 8> random{};
+  ret = mbedtls_hmac_drbg_random(m_drbg, random.data(), random.size());
   if (ret != 0) {
     SPAKE2_MBED_ERR(ret);
     return false;
   }
-  ret = mbedtls_mpi_mod_mpi(m_x, random, &m_group->N);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+  if (!m_backend.reduceScalar(m_x, random.data(), random.size())) {
     return false;
   }
 
+  m_state = State::Precomputed;
   return true;
 }
 
-template<Role role, typename Group, typename Hash>
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
 bool
-Context<role, Group, Hash>::generateFirstMessage(uint8_t* outMsg, size_t outMsgLen) noexcept
+Context<role, Group, Hash, MaxInputLen>::precomputeScalars(const uint8_t* w, size_t wLen,
+                                                           const uint8_t* x, size_t xLen) noexcept
 {
-  if (m_state != State::Initial) {
+  if (m_state != State::Initial || !m_backend.reduceScalar(m_w, w, wLen) ||
+      !m_backend.reduceScalar(m_x, x, xLen) || m_backend.isZero(m_x)) {
     return false;
   }
 
-  // NOTE: the two mbedtls_ecp_mul() calls below are not combined into the mbedtls_ecp_muladd()
-  //       that follows because the latter is _not_ constant time while the former is.
+  m_state = State::Precomputed;
+  return true;
+}
 
-  int ret;
-  ndnph::mbedtls::EcPoint X;
-  // X = x * P
-  ret = mbedtls_ecp_mul(m_group, X, m_x, &m_group->G, mbedtls_hmac_drbg_random, m_drbg);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::bind(const uint8_t* myId, size_t myIdLen,
+                                              const uint8_t* peerId, size_t peerIdLen,
+                                              const uint8_t* aad, size_t aadLen) noexcept
+{
+  if (m_bound || m_state == State::Initial || m_state > State::AwaitingPublicShare) {
     return false;
   }
 
-  ndnph::mbedtls::EcPoint wMN;
-  // wMN = w * (M|N)
-  ret = mbedtls_ecp_mul(m_group, wMN, m_w, role == Role::Alice ? m_M : m_N,
-                        mbedtls_hmac_drbg_random, m_drbg);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+  if (myIdLen > MaxInputLen || peerIdLen > MaxInputLen || aadLen > MaxInputLen) {
+    return false;
+  }
+
+  // Append the Additional Authenticated Data (AAD) to the KDF info string
+  std::copy_n(aad, aadLen, &m_info[m_infoLen]);
+  m_infoLen += aadLen;
+
+  // Copy the identities into the transcript
+  bool ok = false;
+  if (role == Role::Alice) {
+    ok = m_transcript.append(myId, myIdLen) && m_transcript.append(peerId, peerIdLen);
+  } else {
+    ok = m_transcript.append(peerId, peerIdLen) && m_transcript.append(myId, myIdLen);
+  }
+  if (!ok) {
     return false;
   }
 
-  // pA = wMN + X
-  ret = mbedtls_ecp_muladd(m_group, m_pA, s_one, wMN, s_one, X);
+  // Start the transcript hash, which is completed when the public shares are known
+  int ret = mbedtls_md_starts(m_md);
   if (ret != 0) {
     SPAKE2_MBED_ERR(ret);
     return false;
   }
-
-  std::array<uint8_t, Group::UncompressedPointSize> pABytes{};
-  size_t pALen = 0;
-  ret = mbedtls_ecp_point_write_binary(m_group, m_pA, MBEDTLS_ECP_PF_UNCOMPRESSED, &pALen,
-                                       pABytes.data(), pABytes.size());
+  ret = mbedtls_md_update(m_md, m_transcript.data(), m_transcript.size());
   if (ret != 0) {
     SPAKE2_MBED_ERR(ret);
     return false;
   }
 
-  std::memcpy(m_myMsg.data(), pABytes.data(), pALen);
-  // TODO: sanity checks
-  std::memcpy(outMsg, m_myMsg.data(), outMsgLen);
+  m_bound = true;
+  return true;
+}
+
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::generateFirstMessage(uint8_t* outMsg,
+                                                              size_t outMsgLen) noexcept
+{
+  if (m_state == State::Precomputed && !(startGenerateFirstMessage() && complete())) {
+    return false;
+  }
+  if (m_state != State::SendingPublicShare) {
+    return false;
+  }
+
+  if (outMsgLen == FirstMessageSize) {
+    std::memcpy(outMsg, m_myMsg.data(), outMsgLen);
+  } else if (outMsgLen == CompressedFirstMessageSize) {
+    // SEC1 compressed format: parity of y, followed by x
+    outMsg[0] = 0x02 | (m_myMsg[FirstMessageSize - 1] & 0x01);
+    std::memcpy(&outMsg[1], &m_myMsg[1], outMsgLen - 1);
+  } else {
+    return false;
+  }
 
   m_state = State::AwaitingPublicShare;
   return true;
 }
 
-template<Role role, typename Group, typename Hash>
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::processFirstMessage(const uint8_t* inMsg,
+                                                             size_t inMsgLen) noexcept
+{
+  return startProcessFirstMessage(inMsg, inMsgLen) && complete();
+}
+
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
 bool
-Context<role, Group, Hash>::processFirstMessage(const uint8_t* inMsg, size_t inMsgLen) noexcept
+Context<role, Group, Hash, MaxInputLen>::startGenerateFirstMessage() noexcept
 {
-  if (m_state != State::AwaitingPublicShare) {
+  if (m_state != State::Precomputed) {
     return false;
   }
 
-  int ret;
-  ndnph::mbedtls::EcPoint pB;
-  ret = mbedtls_ecp_point_read_binary(m_group, pB, inMsg, inMsgLen);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+  m_state = State::ComputingPublicShare;
+  return true;
+}
+
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::startProcessFirstMessage(const uint8_t* inMsg,
+                                                                  size_t inMsgLen) noexcept
+{
+  if (m_state != State::AwaitingPublicShare || !m_bound || inMsgLen > m_peerMsg.size()) {
     return false;
   }
+
   // Verify that the received point is on the curve
-  ret = mbedtls_ecp_check_pubkey(m_group, pB);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+  if (!m_backend.readPoint(m_point, inMsg, inMsgLen)) {
     return false;
   }
-
-  ndnph::mbedtls::EcPoint wNM;
-  // wNM = w * (N|M)
-  ret = mbedtls_ecp_mul(m_group, wNM, m_w, role == Role::Alice ? m_N : m_M,
-                        mbedtls_hmac_drbg_random, m_drbg);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+  if (inMsgLen == FirstMessageSize) {
+    std::copy_n(inMsg, inMsgLen, m_peerMsg.begin());
+    m_peerMsgLen = inMsgLen;
+  } else if (!m_backend.writePoint(m_peerMsg.data(), &m_peerMsgLen, m_point)) {
     return false;
   }
+  m_hasY = false;
 
-  ndnph::mbedtls::EcPoint Y;
-  // Y = pB - wNM
-  ret = mbedtls_ecp_muladd(m_group, Y, s_one, pB, s_minusOne, wNM);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
-    return false;
+  m_state = State::ComputingSharedKey;
+  return true;
+}
+
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+Progress
+Context<role, Group, Hash, MaxInputLen>::step(int budget) noexcept
+{
+  switch (m_state) {
+    case State::ComputingPublicShare: {
+      // pA = x * P + w * (M|N)
+      detail::Base baseMN = role == Role::Alice ? detail::BaseM : detail::BaseN;
+      if (m_pooled) {
+        // x * P is in m_point already
+        typename Backend::Point wMN;
+        Progress result = m_backend.mulBaseRestartable(m_restart, budget, wMN, baseMN, m_w,
+                                                       mbedtls_hmac_drbg_random, m_drbg);
+        if (result != Progress::Done) {
+          return result;
+        }
+        if (!m_backend.add(m_point, m_point, wMN)) {
+          return Progress::Failure;
+        }
+      } else {
+        Progress result =
+          m_backend.mulBase2Restartable(m_restart, budget, m_point, detail::BaseG, m_x, baseMN,
+                                        m_w, mbedtls_hmac_drbg_random, m_drbg);
+        if (result != Progress::Done) {
+          return result;
+        }
+      }
+
+      size_t pALen = 0;
+      if (!m_backend.writePoint(m_myMsg.data(), &pALen, m_point)) {
+        return Progress::Failure;
+      }
+      m_state = State::SendingPublicShare;
+      return Progress::Done;
+    }
+    case State::ComputingSharedKey: {
+      if (!m_hasY) {
+        typename Backend::Point wNM;
+        // wNM = w * (N|M)
+        detail::Base baseNM = role == Role::Alice ? detail::BaseN : detail::BaseM;
+        Progress result = m_backend.mulBaseRestartable(m_restart, budget, wNM, baseNM, m_w,
+                                                       mbedtls_hmac_drbg_random, m_drbg);
+        if (result != Progress::Done) {
+          return result;
+        }
+
+        // Y = pB - wNM
+        if (!m_backend.sub(m_point, m_point, wNM)) {
+          return Progress::Failure;
+        }
+        m_hasY = true;
+        if (budget <= 0) {
+          return Progress::Pending;
+        }
+      }
+
+      typename Backend::Point K;
+      // K = h * x * Y
+      // NOTE: the backend applies the cofactor h
+      Progress result = m_backend.mulRestartable(m_restart, budget, K, m_x, m_point,
+                                                 mbedtls_hmac_drbg_random, m_drbg);
+      if (result != Progress::Done) {
+        return result;
+      }
+
+      std::array<uint8_t, Group::UncompressedPointSize> binK{};
+      size_t lenK = 0;
+      return m_backend.writePoint(binK.data(), &lenK, K) &&
+                 finishFirstMessage(m_peerMsg.data(), m_peerMsgLen, binK.data(), lenK)
+               ? Progress::Done
+               : Progress::Failure;
+    }
+    default:
+      return Progress::Failure;
   }
+}
 
-  ndnph::mbedtls::EcPoint K;
-  // K = h * x * Y
-  // NOTE: the cofactor h is 1 for NIST curves
-  ret = mbedtls_ecp_mul(m_group, K, m_x, Y, mbedtls_hmac_drbg_random, m_drbg);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
-    return false;
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::complete() noexcept
+{
+  Progress result = Progress::Pending;
+  while (result == Progress::Pending) {
+    result = step(std::numeric_limits<int>::max());
   }
+  return result == Progress::Done;
+}
 
-  std::array<uint8_t, Group::UncompressedPointSize> binK{};
-  size_t lenK = 0;
-  ret = mbedtls_ecp_point_write_binary(m_group, K, MBEDTLS_ECP_PF_UNCOMPRESSED, &lenK, binK.data(),
-                                       binK.size());
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::computeY(const uint8_t* inMsg, size_t inMsgLen,
+                                                  typename Backend::Point& Y) noexcept
+{
+  typename Backend::Point pB;
+  // Verify that the received point is on the curve
+  if (!m_backend.readPoint(pB, inMsg, inMsgLen)) {
     return false;
   }
 
-  std::array<uint8_t, Group::ScalarSize> binW{};
-  ret = mbedtls_mpi_write_binary(m_w, binW.data(), binW.size());
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+  typename Backend::Point wNM;
+  // wNM = w * (N|M)
+  if (!m_backend.mulBase(wNM, role == Role::Alice ? detail::BaseN : detail::BaseM, m_w,
+                         mbedtls_hmac_drbg_random, m_drbg)) {
     return false;
   }
 
-  // Finalize protocol transcript
-  if (role == Role::Alice) {
-    detail::appendToTranscript(m_transcript, m_myMsg.data(), FirstMessageSize);
-    detail::appendToTranscript(m_transcript, inMsg, inMsgLen);
-  } else {
-    detail::appendToTranscript(m_transcript, inMsg, inMsgLen);
-    detail::appendToTranscript(m_transcript, m_myMsg.data(), FirstMessageSize);
-  }
-  detail::appendToTranscript(m_transcript, binK.data(), lenK);
-  detail::appendToTranscript(m_transcript, binW.data(), binW.size());
+  // Y = pB - wNM
+  return m_backend.sub(Y, pB, wNM);
+}
 
-  // Calculate the hash of the transcript
-  std::array<uint8_t, Hash::OutputSize> transcriptHash{};
-  ret = mbedtls_md_starts(m_md);
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::computeK(const typename Backend::Point& Y,
+                                                  uint8_t* binK, size_t* lenK) noexcept
+{
+  typename Backend::Point K;
+  // K = h * x * Y
+  // NOTE: the backend applies the cofactor h, which is 1 for NIST curves and 8 for Edwards25519
+  return m_backend.mul(K, m_x, Y, mbedtls_hmac_drbg_random, m_drbg) &&
+         m_backend.writePoint(binK, lenK, K);
+}
+
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::finishFirstMessage(const uint8_t* inMsg,
+                                                            size_t inMsgLen, const uint8_t* binK,
+                                                            size_t lenK) noexcept
+{
+  std::array<uint8_t, Group::ScalarSize> binW{};
+  if (!m_backend.writeScalar(binW.data(), m_w)) {
     return false;
   }
-  ret = mbedtls_md_update(m_md, m_transcript.data(), m_transcript.size());
-  if (ret != 0) {
-    SPAKE2_MBED_ERR(ret);
+
+  // Finalize the transcript hash, whose identities part was hashed in bind()
+  if (!updateTranscriptTail(mbedtls_md_update, inMsg, inMsgLen, binK, lenK, binW.data())) {
     return false;
   }
-  ret = mbedtls_md_finish(m_md, transcriptHash.data());
+  std::array<uint8_t, Hash::OutputSize> transcriptHash{};
+  int ret = mbedtls_md_finish(m_md, transcriptHash.data());
   if (ret != 0) {
     SPAKE2_MBED_ERR(ret);
     return false;
@@ -439,7 +1745,7 @@ Context<role, Group, Hash>::processFirstMessage(const uint8_t* inMsg, size_t inM
   // Derive confirmation keys (HKDF)
   std::array<uint8_t, Hash::OutputSize> Kc{};
   ret = mbedtls_hkdf(mbedtls_md_info_from_type(Hash::Type), nullptr, 0, Ka,
-                     transcriptHash.size() / 2, m_info.data(), m_info.size(), Kc.data(), Kc.size());
+                     transcriptHash.size() / 2, m_info.data(), m_infoLen, Kc.data(), Kc.size());
   if (ret != 0) {
     SPAKE2_MBED_ERR(ret);
     return false;
@@ -460,6 +1766,9 @@ Context<role, Group, Hash>::processFirstMessage(const uint8_t* inMsg, size_t inM
     SPAKE2_MBED_ERR(ret);
     return false;
   }
+  if (!updateTranscriptTail(mbedtls_md_hmac_update, inMsg, inMsgLen, binK, lenK, binW.data())) {
+    return false;
+  }
   ret = mbedtls_md_hmac_finish(m_md, macA.data());
   if (ret != 0) {
     SPAKE2_MBED_ERR(ret);
@@ -476,6 +1785,9 @@ Context<role, Group, Hash>::processFirstMessage(const uint8_t* inMsg, size_t inM
     SPAKE2_MBED_ERR(ret);
     return false;
   }
+  if (!updateTranscriptTail(mbedtls_md_hmac_update, inMsg, inMsgLen, binK, lenK, binW.data())) {
+    return false;
+  }
   ret = mbedtls_md_hmac_finish(m_md, macB.data());
   if (ret != 0) {
     SPAKE2_MBED_ERR(ret);
@@ -494,9 +1806,27 @@ Context<role, Group, Hash>::processFirstMessage(const uint8_t* inMsg, size_t inM
   return true;
 }
 
-template<Role role, typename Group, typename Hash>
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
+bool
+Context<role, Group, Hash, MaxInputLen>::updateTranscriptTail(
+  detail::MdUpdate update, const uint8_t* inMsg, size_t inMsgLen, const uint8_t* binK,
+  size_t lenK, const uint8_t* binW) noexcept
+{
+  size_t myMsgLen = FirstMessageSize;
+  const uint8_t* pA = role == Role::Alice ? m_myMsg.data() : inMsg;
+  size_t pALen = role == Role::Alice ? myMsgLen : inMsgLen;
+  const uint8_t* pB = role == Role::Alice ? inMsg : m_myMsg.data();
+  size_t pBLen = role == Role::Alice ? inMsgLen : myMsgLen;
+  return detail::updateTranscript(m_md, update, pA, pALen) &&
+         detail::updateTranscript(m_md, update, pB, pBLen) &&
+         detail::updateTranscript(m_md, update, binK, lenK) &&
+         detail::updateTranscript(m_md, update, binW, Group::ScalarSize);
+}
+
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
 bool
-Context<role, Group, Hash>::generateSecondMessage(uint8_t* outMsg, size_t outMsgLen) noexcept
+Context<role, Group, Hash, MaxInputLen>::generateSecondMessage(uint8_t* outMsg,
+                                                               size_t outMsgLen) noexcept
 {
   if (m_state != State::SendingConfirmation) {
     return false;
@@ -509,9 +1839,10 @@ Context<role, Group, Hash>::generateSecondMessage(uint8_t* outMsg, size_t outMsg
   return true;
 }
 
-template<Role role, typename Group, typename Hash>
+template<Role role, typename Group, typename Hash, size_t MaxInputLen>
 bool
-Context<role, Group, Hash>::processSecondMessage(const uint8_t* inMsg, size_t inMsgLen) noexcept
+Context<role, Group, Hash, MaxInputLen>::processSecondMessage(const uint8_t* inMsg,
+                                                              size_t inMsgLen) noexcept
 {
   if (m_state != State::AwaitingConfirmation) {
     return false;
@@ -529,4 +1860,9 @@ Context<role, Group, Hash>::processSecondMessage(const uint8_t* inMsg, size_t in
 
 } // namespace spake2
 
+#if PION_SPAKE2_SHARE_POOL
+// Context::precompute() needs the definition of SharePool
+#include "share-pool.hpp"
+#endif
+
 #endif // PION_SPAKE2_SPAKE2_HPP
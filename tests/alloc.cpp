@@ -0,0 +1,160 @@
+#include "test-common.hpp"
+
+#include <cinttypes>
+#include <new>
+
+#ifdef MBEDTLS_PLATFORM_MEMORY
+#include <mbedtls/platform.h>
+#endif
+
+using namespace pion::pake;
+
+namespace {
+
+/** @brief Allocation counters; the test is single-threaded. */
+struct AllocStats
+{
+  uint64_t nNew = 0;
+  uint64_t nCalloc = 0;
+  int64_t nCallocLive = 0;
+};
+
+AllocStats stats;
+
+#ifdef MBEDTLS_PLATFORM_MEMORY
+void*
+countCalloc(size_t n, size_t size)
+{
+  void* ptr = std::calloc(n, size);
+  if (ptr != nullptr) {
+    ++stats.nCalloc;
+    ++stats.nCallocLive;
+  }
+  return ptr;
+}
+
+void
+countFree(void* ptr)
+{
+  if (ptr != nullptr) {
+    --stats.nCallocLive;
+  }
+  std::free(ptr);
+}
+#endif
+
+/**
+ * @brief Run the PAKE stage: one SPAKE2 handshake, then one encrypted message each way.
+ * @return whether success.
+ */
+bool
+runPake(spake2::Drbg& drbg)
+{
+  Spake2Authenticator a(drbg);
+  Spake2Device b(drbg);
+  if (!pion_test::startAndHandshake(a, b)) {
+    return false;
+  }
+
+  static const uint8_t ssValue[] = { 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7 };
+  ndnph::StaticRegion<1024> region;
+  EncryptSession sender;
+  EncryptSession receiver;
+  sender.ss = receiver.ss = ndnph::Component(region, sizeof(ssValue), ssValue);
+  if (!sender.importKey(a.getSharedKey()) || !receiver.importKey(b.getSharedKey())) {
+    return false;
+  }
+
+  auto nc = ndnph::tlv::Value::fromString("ssid=pion-home psk=0123456789abcdef");
+  ndnph::tlv::Value encrypted =
+    sender.encrypt(region, [&](ndnph::Encoder& encoder) { encoder.prependTlv(TT::Nc, nc); });
+  Encrypted message;
+  return !!encrypted &&
+         ndnph::EvDecoder::decodeValue(encrypted.makeDecoder(),
+                                       ndnph::EvDecoder::def<TT::InitializationVector>(&message),
+                                       ndnph::EvDecoder::def<TT::AuthenticationTag>(&message),
+                                       ndnph::EvDecoder::def<TT::EncryptedPayload>(&message)) &&
+         !!receiver.decrypt(region, message);
+}
+
+} // namespace
+
+void*
+operator new(size_t size)
+{
+  ++stats.nNew;
+  void* ptr = std::malloc(size);
+  if (ptr == nullptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+void*
+operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void*
+operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  ++stats.nNew;
+  return std::malloc(size);
+}
+
+void*
+operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+  return operator new(size, std::nothrow);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete[](void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+int
+main()
+{
+#ifdef MBEDTLS_PLATFORM_MEMORY
+  mbedtls_platform_set_calloc_free(countCalloc, countFree);
+#endif
+
+  uint64_t entropyState = 1;
+  spake2::Drbg drbg(pion_test::deterministicEntropy, &entropyState);
+
+  // the first run builds process-wide tables, which are not part of a handshake
+  PION_TEST_CHECK(runPake(drbg));
+
+  stats = AllocStats();
+  PION_TEST_CHECK(runPake(drbg));
+
+  // SPAKE2 contexts and EncryptSession keep all state in their own storage
+  PION_TEST_CHECK(stats.nNew == 0);
+
+  // mbedtls allocates digest, HKDF, and cipher contexts, and must release all of them
+  PION_TEST_CHECK(stats.nCallocLive == 0);
+  std::printf("operator new: %" PRIu64 ", mbedtls_calloc: %" PRIu64 "\n", stats.nNew,
+              stats.nCalloc);
+  return pion_test::exitCode();
+}
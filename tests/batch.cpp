@@ -0,0 +1,113 @@
+#include "test-common.hpp"
+
+#include "pion/spake2/batch.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Check that Batch produces the same results as processing each item on its own.
+ *
+ * Two sets of Bob contexts are seeded with identical DRBGs, so that they hold the same secrets.
+ * The first set goes through Batch, the second set through Context::processFirstMessage. Their
+ * confirmation messages must be bit-identical, and must complete the handshakes with Alice.
+ */
+template<typename Group>
+void
+checkBatch(const char* suite)
+{
+  using ContextA = spake2::Context<spake2::Role::Alice, Group>;
+  using ContextB = spake2::Context<spake2::Role::Bob, Group>;
+  using BatchB = spake2::Batch<spake2::Role::Bob, Group>;
+  constexpr size_t n = 6;
+  constexpr size_t compressedItem = 2;
+  constexpr size_t tamperedItem = 4;
+
+  uint64_t entropyA = 11;
+  uint64_t entropyB1 = 22;
+  uint64_t entropyB2 = 22;
+  spake2::Drbg drbgA(pion_test::deterministicEntropy, &entropyA);
+  spake2::Drbg drbgB1(pion_test::deterministicEntropy, &entropyB1);
+  spake2::Drbg drbgB2(pion_test::deterministicEntropy, &entropyB2);
+
+  pion_test::Identities id;
+  std::vector<std::unique_ptr<ContextA>> a;
+  std::vector<std::unique_ptr<ContextB>> b1;
+  std::vector<std::unique_ptr<ContextB>> b2;
+  std::vector<ContextB*> batch;
+  for (size_t i = 0; i < n; ++i) {
+    a.emplace_back(new ContextA(drbgA));
+    b1.emplace_back(new ContextB(drbgB1));
+    b2.emplace_back(new ContextB(drbgB2));
+    batch.push_back(b1[i].get());
+    PION_TEST_CHECK(a[i]->start(id.pw, id.pwLen, id.idA, id.idALen, id.idB, id.idBLen));
+    PION_TEST_CHECK(b1[i]->start(id.pw, id.pwLen, id.idB, id.idBLen, id.idA, id.idALen));
+    PION_TEST_CHECK(b2[i]->start(id.pw, id.pwLen, id.idB, id.idBLen, id.idA, id.idALen));
+  }
+
+  std::vector<std::array<uint8_t, ContextA::FirstMessageSize>> pA(n);
+  std::vector<std::array<uint8_t, ContextB::FirstMessageSize>> pB1(n);
+  std::vector<std::array<uint8_t, ContextB::FirstMessageSize>> pB2(n);
+  std::vector<const uint8_t*> inMsg(n);
+  std::vector<size_t> inMsgLen(n);
+  for (size_t i = 0; i < n; ++i) {
+    inMsgLen[i] = i == compressedItem ? size_t(ContextA::CompressedFirstMessageSize)
+                                      : size_t(ContextA::FirstMessageSize);
+    PION_TEST_CHECK(a[i]->generateFirstMessage(pA[i].data(), inMsgLen[i]));
+    PION_TEST_CHECK(b1[i]->generateFirstMessage(pB1[i].data(), pB1[i].size()));
+    PION_TEST_CHECK(b2[i]->generateFirstMessage(pB2[i].data(), pB2[i].size()));
+    PION_TEST_CHECK(pB1[i] == pB2[i]);
+    inMsg[i] = pA[i].data();
+  }
+  // a tampered share must get the same result in both paths without affecting other items
+  pA[tamperedItem][inMsgLen[tamperedItem] - 1] ^= 0x01;
+
+  bool ok1[n];
+  BatchB::processFirstMessage(batch.data(), inMsg.data(), inMsgLen.data(), ok1, n);
+  for (size_t i = 0; i < n; ++i) {
+    bool ok2 = b2[i]->processFirstMessage(inMsg[i], inMsgLen[i]);
+    if (ok1[i] != ok2) {
+      std::fprintf(stderr, "%s item %zu: batch %d, single %d\n", suite, i, ok1[i], ok2);
+    }
+    PION_TEST_CHECK(ok1[i] == ok2);
+    if (!ok2 || i == tamperedItem) {
+      continue;
+    }
+
+    std::array<uint8_t, ContextB::SecondMessageSize> cB1{};
+    std::array<uint8_t, ContextB::SecondMessageSize> cB2{};
+    std::array<uint8_t, ContextA::SecondMessageSize> cA{};
+    PION_TEST_CHECK(b1[i]->generateSecondMessage(cB1.data(), cB1.size()));
+    PION_TEST_CHECK(b2[i]->generateSecondMessage(cB2.data(), cB2.size()));
+    PION_TEST_CHECK(cB1 == cB2);
+
+    PION_TEST_CHECK(a[i]->processFirstMessage(pB1[i].data(), pB1[i].size()));
+    PION_TEST_CHECK(a[i]->generateSecondMessage(cA.data(), cA.size()));
+    PION_TEST_CHECK(a[i]->processSecondMessage(cB1.data(), cB1.size()));
+    PION_TEST_CHECK(b1[i]->processSecondMessage(cA.data(), cA.size()));
+    PION_TEST_CHECK(a[i]->getSharedKey() == b1[i]->getSharedKey());
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    if (i != tamperedItem) {
+      PION_TEST_CHECK(ok1[i]);
+    }
+  }
+}
+
+} // namespace
+
+int
+main()
+{
+  checkBatch<spake2::P256>("P256");
+  // P256 takes the multi-buffer path on CPUs with AVX2; check the fallback path on any CPU
+  spake2::p256_multi::setEnabled(false);
+  checkBatch<spake2::P256>("P256 fallback");
+  spake2::p256_multi::setEnabled(true);
+  checkBatch<spake2::P384>("P384");
+  checkBatch<spake2::Edwards25519>("Edwards25519");
+  return pion_test::exitCode();
+}
@@ -0,0 +1,247 @@
+#include "test-common.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace pion::pake;
+
+namespace {
+
+/** @brief A sender and a receiver session that share a key and a session identifier. */
+struct Sessions
+{
+  explicit Sessions(ndnph::Region& region)
+  {
+    static const uint8_t ssValue[] = { 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7 };
+    static const uint8_t keyValue[] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                        0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F };
+    Aead::Key key;
+    std::copy(keyValue, keyValue + sizeof(keyValue), key.begin());
+    sender.ss = receiver.ss = ndnph::Component(region, sizeof(ssValue), ssValue);
+    ok = sender.importKey(key) && receiver.importKey(key);
+  }
+
+  /** @brief Encrypt a message and decode its fields into @p message . */
+  bool encrypt(ndnph::Region& region, Encrypted& message)
+  {
+    auto nc = ndnph::tlv::Value::fromString("ssid=pion-home psk=0123456789abcdef");
+    ndnph::tlv::Value encrypted =
+      sender.encrypt(region, [&](ndnph::Encoder& encoder) { encoder.prependTlv(TT::Nc, nc); });
+    return !!encrypted &&
+           ndnph::EvDecoder::decodeValue(encrypted.makeDecoder(),
+                                         ndnph::EvDecoder::def<TT::InitializationVector>(&message),
+                                         ndnph::EvDecoder::def<TT::AuthenticationTag>(&message),
+                                         ndnph::EvDecoder::def<TT::EncryptedPayload>(&message));
+  }
+
+  EncryptSession sender;
+  EncryptSession receiver;
+  bool ok = false;
+};
+
+/**
+ * @brief Check that a message with a tampered tag or ciphertext is rejected, and that the
+ *        received packet buffer is left intact, so that the original message still decrypts.
+ */
+void
+checkTamper(bool tamperTag)
+{
+  ndnph::StaticRegion<1024> region;
+  Sessions sessions(region);
+  PION_TEST_CHECK(sessions.ok);
+  Encrypted message;
+  PION_TEST_CHECK(sessions.encrypt(region, message));
+
+  std::vector<uint8_t> ciphertext(message.ciphertext.begin(), message.ciphertext.end());
+  Encrypted tampered = message;
+  std::vector<uint8_t> tamperedCiphertext = ciphertext;
+  if (tamperTag) {
+    tampered.tag[0] ^= 0x01;
+  } else {
+    tamperedCiphertext[0] ^= 0x01;
+    tampered.ciphertext = ndnph::tlv::Value(tamperedCiphertext.data(), tamperedCiphertext.size());
+  }
+
+  PION_TEST_CHECK(!sessions.receiver.decrypt(region, tampered));
+  PION_TEST_CHECK(std::equal(ciphertext.begin(), ciphertext.end(), message.ciphertext.begin()));
+  if (!tamperTag) {
+    // the tampered copy is the input buffer here, which must be intact as well
+    tamperedCiphertext[0] ^= 0x01;
+    PION_TEST_CHECK(tamperedCiphertext == ciphertext);
+  }
+
+  ndnph::tlv::Value plaintext = sessions.receiver.decrypt(region, message);
+  PION_TEST_CHECK(!!plaintext);
+  PION_TEST_CHECK(std::equal(ciphertext.begin(), ciphertext.end(), message.ciphertext.begin()));
+  PION_TEST_CHECK(plaintext.begin() != message.ciphertext.begin());
+}
+
+/**
+ * @brief Encrypt the network credential into parameters laid out by a schema::Writer, as
+ *        Authenticator does for Message 3.
+ * @param fail whether the plaintext writer reports failure after writing the credential.
+ * @return parameters, or an empty value if encryption fails.
+ */
+ndnph::tlv::Value
+encryptParameters(ndnph::Region& region, EncryptSession& session, bool fail)
+{
+  auto nc = ndnph::tlv::Value::fromString("ssid=pion-home psk=0123456789abcdef");
+  size_t plaintextLen = schema::tlvSize(TT::Nc, nc.size());
+  schema::Writer writer(region, packet_schema::EncryptedMessage::size(plaintextLen));
+  bool encrypted = session.encrypt(writer, plaintextLen, [&](schema::Writer& inner) {
+    return inner.write(TT::Nc, nc.begin(), nc.size()) && !fail;
+  });
+  if (!encrypted) {
+    // the writer is filled exactly even so; its content must not be sent
+    PION_TEST_CHECK(!!writer.finish());
+    ndnph::tlv::Value buffer = writer.finish();
+    PION_TEST_CHECK(std::search(buffer.begin(), buffer.end(), nc.begin(), nc.end()) ==
+                    buffer.end());
+    return ndnph::tlv::Value();
+  }
+  return writer.finish();
+}
+
+/** @brief Check that encryption into a schema::Writer reports failure and leaves no plaintext. */
+void
+checkWriterFailure()
+{
+  ndnph::StaticRegion<1024> region;
+  Sessions sessions(region);
+  PION_TEST_CHECK(sessions.ok);
+
+  // a session without key cannot encrypt
+  EncryptSession unkeyed;
+  unkeyed.ss = sessions.sender.ss;
+  PION_TEST_CHECK(!encryptParameters(region, unkeyed, false));
+
+  // a plaintext writer failure is an encryption failure, and erases the partial plaintext
+  PION_TEST_CHECK(!encryptParameters(region, sessions.sender, true));
+
+  ndnph::tlv::Value parameters = encryptParameters(region, sessions.sender, false);
+  PION_TEST_CHECK(!!parameters);
+  Encrypted message;
+  PION_TEST_CHECK(
+    ndnph::EvDecoder::decodeValue(parameters.makeDecoder(),
+                                  ndnph::EvDecoder::def<TT::InitializationVector>(&message),
+                                  ndnph::EvDecoder::def<TT::AuthenticationTag>(&message),
+                                  ndnph::EvDecoder::def<TT::EncryptedPayload>(&message)));
+  PION_TEST_CHECK(!!sessions.receiver.decrypt(region, message));
+}
+
+/**
+ * @brief Check that encryption into an ndnph::Encoder, as Device does for Message 4, reports
+ *        failure and leaves no plaintext in the region.
+ */
+void
+checkEncoderFailure()
+{
+  ndnph::StaticRegion<1024> sessionRegion;
+  Sessions sessions(sessionRegion);
+  PION_TEST_CHECK(sessions.ok);
+  auto nc = ndnph::tlv::Value::fromString("ssid=pion-home psk=0123456789abcdef");
+  auto prependNc = [&](ndnph::Encoder& encoder) { encoder.prependTlv(TT::Nc, nc); };
+  auto hasPlaintext = [&](const ndnph::StaticRegion<1024>& region) {
+    auto bytes = reinterpret_cast<const uint8_t*>(&region);
+    auto end = bytes + sizeof(region);
+    return std::search(bytes, end, nc.begin(), nc.end()) != end;
+  };
+
+  // a session without key cannot encrypt, and does not encode the plaintext
+  EncryptSession unkeyed;
+  unkeyed.ss = sessions.sender.ss;
+  ndnph::StaticRegion<1024> region;
+  {
+    ndnph::Encoder encoder(region);
+    PION_TEST_CHECK(!unkeyed.encrypt(encoder, prependNc));
+    PION_TEST_CHECK(!encoder);
+    encoder.discard();
+  }
+  PION_TEST_CHECK(!hasPlaintext(region));
+
+  // a successful encryption leaves only ciphertext
+  {
+    ndnph::Encoder encoder(region);
+    PION_TEST_CHECK(sessions.sender.encrypt(encoder, prependNc));
+    PION_TEST_CHECK(!!encoder);
+    encoder.trim();
+  }
+  PION_TEST_CHECK(!hasPlaintext(region));
+}
+
+/**
+ * @brief Check that Message 5 with an embedded issued certificate just within MaxEmbedLimit is
+ *        decoded in an EmbedRegion, as Device does.
+ */
+void
+checkEmbeddedNearLimit()
+{
+  using Schema = packet_schema::CredentialRequest;
+  ndnph::DynamicRegion region(8192);
+  Sessions sessions(region);
+  PION_TEST_CHECK(sessions.ok);
+  auto name = ndnph::Name::parse(region, "/example/pion/home/living-room/thermostat/temporary/KEY/"
+                                         "0123456789abcdef/authenticator/1700000000000");
+
+  // grow the certificate content until the parameters just fit within MaxEmbedLimit
+  ndnph::DynamicRegion certRegion(4096);
+  std::vector<uint8_t> content(packet_schema::MaxEmbedLimit, 0xC0);
+  EncodedData tempCert;
+  size_t plaintextLen = 0;
+  size_t paramsLen = packet_schema::MaxEmbedLimit + 1;
+  while (paramsLen > packet_schema::MaxEmbedLimit) {
+    content.resize(content.size() - (paramsLen - packet_schema::MaxEmbedLimit));
+    certRegion.reset();
+    ndnph::Data data = certRegion.create<ndnph::Data>();
+    PION_TEST_CHECK(!!data);
+    data.setName(name);
+    data.setContent(ndnph::tlv::Value(content.data(), content.size()));
+    PION_TEST_CHECK(tempCert.build(certRegion, data.sign(ndnph::NullKey::get())));
+    plaintextLen = Schema::plaintextSize(tempCert.fullName.length()) +
+                   Schema::EmbeddedIssuedCert::size(tempCert.wire.size());
+    paramsLen = Schema::size(plaintextLen);
+  }
+  PION_TEST_CHECK(paramsLen + 8 > packet_schema::MaxEmbedLimit);
+
+  // encrypt as Authenticator does
+  schema::Writer writer(region, paramsLen);
+  PION_TEST_CHECK(sessions.sender.encrypt(writer, plaintextLen, [&](schema::Writer& inner) {
+    return inner.write(TT::IssuedCertName, tempCert.fullName) &&
+           inner.write(TT::EmbeddedIssuedCert, tempCert.wire.begin(), tempCert.wire.size());
+  }));
+  ndnph::tlv::Value parameters = writer.finish();
+  PION_TEST_CHECK(!!parameters);
+
+  // decrypt and decode as Device does
+  std::unique_ptr<EmbedRegion> embedRegion(new EmbedRegion);
+  Encrypted message;
+  PION_TEST_CHECK(
+    ndnph::EvDecoder::decodeValue(parameters.makeDecoder(),
+                                  ndnph::EvDecoder::def<TT::InitializationVector>(&message),
+                                  ndnph::EvDecoder::def<TT::AuthenticationTag>(&message),
+                                  ndnph::EvDecoder::def<TT::EncryptedPayload>(&message)));
+  ndnph::tlv::Value plaintext = sessions.receiver.decrypt(*embedRegion, message);
+  PION_TEST_CHECK(!!plaintext);
+  ndnph::Name tempCertName;
+  ndnph::tlv::Value embedded;
+  PION_TEST_CHECK(ndnph::EvDecoder::decodeValue(
+    plaintext.makeDecoder(),
+    ndnph::EvDecoder::def<TT::IssuedCertName>(
+      [&](const ndnph::Decoder::Tlv& d) { return d.vd().decode(tempCertName); }),
+    ndnph::EvDecoder::def<TT::EmbeddedIssuedCert>(&embedded)));
+  PION_TEST_CHECK(!!decodeEmbedded(*embedRegion, embedded, tempCertName));
+}
+
+} // namespace
+
+int
+main()
+{
+  checkTamper(true);
+  checkTamper(false);
+  checkWriterFailure();
+  checkEncoderFailure();
+  checkEmbeddedNearLimit();
+  return pion_test::exitCode();
+}
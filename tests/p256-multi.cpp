@@ -0,0 +1,174 @@
+#include "test-common.hpp"
+
+#include "pion/spake2/p256-multi.hpp"
+#include "pion/spake2/p256-native.hpp"
+
+#include <array>
+#include <vector>
+
+using namespace spake2;
+
+namespace {
+
+using Bytes32 = std::array<uint8_t, 32>;
+using Bytes65 = std::array<uint8_t, 65>;
+
+// n-1, where n is the order of the P-256 group
+const Bytes32 kOrderMinus1 = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x50,
+};
+
+/** @brief Inputs and results of a multiplication batch. */
+struct Items
+{
+  explicit Items(size_t n)
+    : k(n)
+    , P(n)
+    , R(n)
+    , kPtr(n)
+    , PPtr(n)
+    , RPtr(n)
+  {
+    for (size_t i = 0; i < n; ++i) {
+      kPtr[i] = k[i].data();
+      PPtr[i] = P[i].data();
+      RPtr[i] = R[i].data();
+    }
+  }
+
+  bool mul()
+  {
+    return p256_multi::mul(k.size(), kPtr.data(), PPtr.data(), RPtr.data());
+  }
+
+  std::vector<Bytes32> k;
+  std::vector<Bytes65> P;
+  std::vector<Bytes65> R;
+  std::vector<const uint8_t*> kPtr;
+  std::vector<const uint8_t*> PPtr;
+  std::vector<uint8_t*> RPtr;
+};
+
+/** @brief Generate a random scalar in range [1, n-1]. */
+void
+randomScalar(Bytes32& k, uint64_t& entropy)
+{
+  p256_native::Scalar s;
+  do {
+    Bytes32 input{};
+    pion_test::deterministicEntropy(&entropy, input.data(), input.size());
+    p256_native::scalarReduce(s, input.data(), input.size());
+  } while (p256_native::scalarIsZero(s));
+  p256_native::scalarWrite(k.data(), s);
+}
+
+/** @brief Generate a random point as a multiple of the generator. */
+void
+randomPoint(Bytes65& P, uint64_t& entropy)
+{
+  Bytes32 k{};
+  randomScalar(k, entropy);
+  p256_native::Scalar s;
+  p256_native::scalarReduce(s, k.data(), k.size());
+  p256_native::Point Q;
+  p256_native::pointMulBase(Q, p256_native::BaseG, s);
+  size_t len = 0;
+  p256_native::pointWrite(P.data(), &len, Q);
+}
+
+/** @brief Compute k * P with the scalar native backend. */
+Bytes65
+referenceMul(const Bytes32& k, const Bytes65& P, size_t* len)
+{
+  p256_native::Scalar s;
+  p256_native::scalarReduce(s, k.data(), k.size());
+  p256_native::Point Q, R;
+  Bytes65 output{};
+  if (!p256_native::pointRead(Q, P.data(), P.size())) {
+    *len = 0;
+    return output;
+  }
+  p256_native::pointMul(R, s, Q);
+  p256_native::pointWrite(output.data(), len, R);
+  return output;
+}
+
+/** @brief Check random items against the scalar backend; n covers partial groups and chunks. */
+void
+checkRandom(size_t n, uint64_t& entropy)
+{
+  Items items(n);
+  for (size_t i = 0; i < n; ++i) {
+    randomScalar(items.k[i], entropy);
+    randomPoint(items.P[i], entropy);
+  }
+  PION_TEST_CHECK(items.mul());
+  for (size_t i = 0; i < n; ++i) {
+    size_t len = 0;
+    Bytes65 expected = referenceMul(items.k[i], items.P[i], &len);
+    PION_TEST_CHECK(len == expected.size());
+    if (items.R[i] != expected) {
+      std::fprintf(stderr, "n=%zu item %zu differs from the scalar backend\n", n, i);
+      ++pion_test::nFailures();
+    }
+  }
+}
+
+/** @brief Check scalars 1 and n-1, and that a result at infinity fails the batch. */
+void
+checkEdgeCases(uint64_t& entropy)
+{
+  Items items(3);
+  for (auto& P : items.P) {
+    randomPoint(P, entropy);
+  }
+  items.k[0] = Bytes32{};
+  items.k[0][31] = 1;
+  items.k[1] = kOrderMinus1;
+  randomScalar(items.k[2], entropy);
+  PION_TEST_CHECK(items.mul());
+
+  // 1 * P = P
+  PION_TEST_CHECK(items.R[0] == items.P[0]);
+  // (n-1) * P = -P, which has the same x and y' = p - y
+  size_t len = 0;
+  PION_TEST_CHECK(items.R[1] == referenceMul(items.k[1], items.P[1], &len));
+  PION_TEST_CHECK(std::equal(&items.R[1][1], &items.R[1][33], &items.P[1][1]));
+  PION_TEST_CHECK(!std::equal(&items.R[1][33], &items.R[1][65], &items.P[1][33]));
+
+  // 0 * P is the point at infinity, which has no uncompressed encoding
+  items.k[2] = Bytes32{};
+  PION_TEST_CHECK(!items.mul());
+  referenceMul(items.k[2], items.P[2], &len);
+  PION_TEST_CHECK(len == 1);
+}
+
+} // namespace
+
+int
+main()
+{
+  // the fallback switch must make the backend unavailable regardless of the CPU
+  p256_multi::setEnabled(false);
+  PION_TEST_CHECK(!p256_multi::isAvailable());
+  p256_multi::setEnabled(true);
+
+#if PION_SPAKE2_P256_MULTI
+  bool hasAvx2 = __builtin_cpu_supports("avx2");
+#else
+  bool hasAvx2 = false;
+#endif
+  PION_TEST_CHECK(p256_multi::isAvailable() == hasAvx2);
+  if (!hasAvx2) {
+    std::printf("multi-buffer backend unavailable, skipping differential tests\n");
+    return pion_test::nFailures() > 0 ? pion_test::exitCode() : 77;
+  }
+
+  uint64_t entropy = 5;
+  for (size_t n : { 1, 4, 7, 33, 70 }) {
+    checkRandom(n, entropy);
+  }
+  checkEdgeCases(entropy);
+  return pion_test::exitCode();
+}
@@ -0,0 +1,142 @@
+#include "test-common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief Known-answer test vector, with octet strings in hexadecimal. */
+struct Vector
+{
+  const char* idA;
+  const char* idB;
+  const char* w;
+  const char* x;
+  const char* y;
+  const char* pA;
+  const char* pB;
+  const char* Ke;
+  const char* confA;
+  const char* confB;
+};
+
+// RFC 9382 appendix B, first vector: SPAKE2(A='server', B='client')
+const Vector p256Vector = {
+  "server",
+  "client",
+  "2ee57912099d31560b3a44b1184b9b4866e904c49d12ac5042c97dca461b1a5f",
+  "43dd0fd7215bdcb482879fca3220c6a968e66d70b1356cac18bb26c84a78d729",
+  "dcb60106f276b02606d8ef0a328c02e4b629f84f89786af5befb0bc75b6e66be",
+  "04a56fa807caaa53a4d28dbb9853b9815c61a411118a6fe516a8798434751470f9"
+  "010153ac33d0d5f2047ffdb1a3e42c9b4e6be662766e1eeb4116988ede5f912c",
+  "0406557e482bd03097ad0cbaa5df82115460d951e3451962f1eaf4367a420676d0"
+  "9857ccbc522686c83d1852abfa8ed6e4a1155cf8f1543ceca528afb591a1e0b7",
+  "0e0672dc86f8e45565d338b0540abe69",
+  "58ad4aa88e0b60d5061eb6b5dd93e80d9c4f00d127c65b3b35b1b5281fee38f0",
+  "d3e2e547f1ae04f2dbdbf0fc4b79f8ecff2dff314b5d32fe9fcef2fb26dc459b",
+};
+
+// RFC 9382 has no edwards25519 vectors. This vector is computed by an independent Python
+// implementation of the same construction: w, x, y are reduced modulo l, points use the encoding
+// of RFC 8032, K includes the cofactor 8, and w enters the transcript as 32 octets big endian.
+const Vector ed25519Vector = {
+  "server",
+  "client",
+  "43ee76363547a40f2e7d3c7b4cc2093d1ceaf5afd47d4a464f46361236485f87",
+  "151b58754a0ea88a5f7b0d56936dd63a2110095693299db4329eb3088759d86a",
+  "7931ad07a8838021b028cab2f9639e4a634f4aa6a4de117294c7ba9de5f2e699",
+  "7b19d58c8b231431844c57824a39a6b274e2f32a071e31078c2eab986aeb0d65",
+  "0a95df7b27dcef699a7f2b5cf5b02102a5f9eb8cee7aff9367e068da04c57669",
+  "8c1f5a1c01d61bc09d5c4e843fd17e27",
+  "a5c545972f038cbc01b3b1e13a9533bf7f50bc906088b5e82485a543fd6a5b81",
+  "f30650633cd7901357d807faa97bc813a0994c95a0a8bcf2cf037080e6feb460",
+};
+
+std::vector<uint8_t>
+fromHex(const char* hex)
+{
+  std::vector<uint8_t> v;
+  for (size_t i = 0; hex[i] != '\0' && hex[i + 1] != '\0'; i += 2) {
+    v.push_back(static_cast<uint8_t>(std::stoi(std::string(hex + i, 2), nullptr, 16)));
+  }
+  return v;
+}
+
+template<typename Array>
+bool
+equals(const Array& actual, const char* expected)
+{
+  std::vector<uint8_t> v = fromHex(expected);
+  return v.size() == actual.size() && std::equal(v.begin(), v.end(), actual.begin());
+}
+
+/** @brief Run the exchange of a test vector and compare every message and the shared key. */
+template<typename Group>
+void
+checkVector(const Vector& tv, const char* suite)
+{
+  using ContextA = spake2::Context<spake2::Role::Alice, Group>;
+  using ContextB = spake2::Context<spake2::Role::Bob, Group>;
+
+  int failuresBefore = pion_test::nFailures();
+  // the scalars come from the vector; the DRBG only randomizes mbedtls computations
+  uint64_t entropyState = 1;
+  spake2::Drbg drbg(pion_test::deterministicEntropy, &entropyState);
+  ContextA a(drbg);
+  ContextB b(drbg);
+
+  auto w = fromHex(tv.w);
+  auto x = fromHex(tv.x);
+  auto y = fromHex(tv.y);
+  auto idA = reinterpret_cast<const uint8_t*>(tv.idA);
+  auto idB = reinterpret_cast<const uint8_t*>(tv.idB);
+  size_t idALen = std::strlen(tv.idA);
+  size_t idBLen = std::strlen(tv.idB);
+  PION_TEST_CHECK(a.precomputeScalars(w.data(), w.size(), x.data(), x.size()));
+  PION_TEST_CHECK(b.precomputeScalars(w.data(), w.size(), y.data(), y.size()));
+  PION_TEST_CHECK(a.bind(idA, idALen, idB, idBLen));
+  PION_TEST_CHECK(b.bind(idB, idBLen, idA, idALen));
+
+  std::array<uint8_t, ContextA::FirstMessageSize> pA{};
+  std::array<uint8_t, ContextB::FirstMessageSize> pB{};
+  PION_TEST_CHECK(a.generateFirstMessage(pA.data(), pA.size()));
+  PION_TEST_CHECK(b.generateFirstMessage(pB.data(), pB.size()));
+  PION_TEST_CHECK(equals(pA, tv.pA));
+  PION_TEST_CHECK(equals(pB, tv.pB));
+
+  std::array<uint8_t, ContextA::SecondMessageSize> confA{};
+  std::array<uint8_t, ContextB::SecondMessageSize> confB{};
+  PION_TEST_CHECK(a.processFirstMessage(pB.data(), pB.size()));
+  PION_TEST_CHECK(b.processFirstMessage(pA.data(), pA.size()));
+  PION_TEST_CHECK(a.generateSecondMessage(confA.data(), confA.size()));
+  PION_TEST_CHECK(b.generateSecondMessage(confB.data(), confB.size()));
+  PION_TEST_CHECK(equals(confA, tv.confA));
+  PION_TEST_CHECK(equals(confB, tv.confB));
+
+  bool doneA = a.processSecondMessage(confB.data(), confB.size());
+  bool doneB = b.processSecondMessage(confA.data(), confA.size());
+  PION_TEST_CHECK(doneA);
+  PION_TEST_CHECK(doneB);
+  // the shared key is only available after a successful confirmation
+  if (doneA && doneB) {
+    PION_TEST_CHECK(equals(a.getSharedKey(), tv.Ke));
+    PION_TEST_CHECK(equals(b.getSharedKey(), tv.Ke));
+  }
+
+  if (pion_test::nFailures() > failuresBefore) {
+    std::fprintf(stderr, "%s vector failed\n", suite);
+  }
+}
+
+} // namespace
+
+int
+main()
+{
+  checkVector<spake2::P256>(p256Vector, "P256");
+  checkVector<spake2::Edwards25519>(ed25519Vector, "Edwards25519");
+  return pion_test::exitCode();
+}
@@ -0,0 +1,102 @@
+#ifndef PION_TESTS_TEST_COMMON_HPP
+#define PION_TESTS_TEST_COMMON_HPP
+
+#include "pion.h"
+
+#include <cstdio>
+
+namespace pion_test {
+
+/** @brief Number of failed checks in this test program. */
+inline int&
+nFailures()
+{
+  static int n = 0;
+  return n;
+}
+
+/** @brief Return the exit code of the test program. */
+inline int
+exitCode()
+{
+  if (nFailures() > 0) {
+    std::fprintf(stderr, "%d check(s) failed\n", nFailures());
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Deterministic entropy function: SplitMix64 stream starting from the seed.
+ * @param ctx pointer to uint64_t state.
+ */
+inline int
+deterministicEntropy(void* ctx, unsigned char* output, size_t len)
+{
+  uint64_t& state = *static_cast<uint64_t*>(ctx);
+  uint64_t z = 0;
+  for (size_t i = 0; i < len; ++i) {
+    if (i % 8 == 0) {
+      state += 0x9E3779B97F4A7C15;
+      z = state;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+      z ^= z >> 31;
+    }
+    output[i] = static_cast<uint8_t>(z >> (8 * (i % 8)));
+  }
+  return 0;
+}
+
+/** @brief Password and identities of test handshakes. */
+struct Identities
+{
+  const uint8_t* pw = reinterpret_cast<const uint8_t*>("password");
+  size_t pwLen = 8;
+  const uint8_t* idA = reinterpret_cast<const uint8_t*>("authenticator");
+  size_t idALen = 13;
+  const uint8_t* idB = reinterpret_cast<const uint8_t*>("device");
+  size_t idBLen = 6;
+};
+
+/**
+ * @brief Run a complete SPAKE2 exchange between two started contexts.
+ * @return whether both parties succeed and agree on the shared key.
+ */
+template<typename ContextA, typename ContextB>
+bool
+handshake(ContextA& a, ContextB& b)
+{
+  uint8_t pA[ContextA::FirstMessageSize];
+  uint8_t pB[ContextB::FirstMessageSize];
+  uint8_t cA[ContextA::SecondMessageSize];
+  uint8_t cB[ContextB::SecondMessageSize];
+  return a.generateFirstMessage(pA, sizeof(pA)) && b.generateFirstMessage(pB, sizeof(pB)) &&
+         a.processFirstMessage(pB, sizeof(pB)) && b.processFirstMessage(pA, sizeof(pA)) &&
+         a.generateSecondMessage(cA, sizeof(cA)) && b.generateSecondMessage(cB, sizeof(cB)) &&
+         a.processSecondMessage(cB, sizeof(cB)) && b.processSecondMessage(cA, sizeof(cA)) &&
+         a.getSharedKey() == b.getSharedKey();
+}
+
+/** @brief Start two contexts with Identities and run handshake(). */
+template<typename ContextA, typename ContextB>
+bool
+startAndHandshake(ContextA& a, ContextB& b)
+{
+  Identities id;
+  return a.start(id.pw, id.pwLen, id.idA, id.idALen, id.idB, id.idBLen) &&
+         b.start(id.pw, id.pwLen, id.idB, id.idBLen, id.idA, id.idALen) && handshake(a, b);
+}
+
+} // namespace pion_test
+
+/** @brief Check a condition; if it does not hold, print its location and count a failure. */
+#define PION_TEST_CHECK(cond)                                                                      \
+  do {                                                                                             \
+    if (!(cond)) {                                                                                 \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);               \
+      ++pion_test::nFailures();                                                                    \
+    }                                                                                              \
+  } while (false)
+
+#endif // PION_TESTS_TEST_COMMON_HPP